@@ -0,0 +1,36 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_NETWORKTHREADPLACEMENTPOLICY_H_
+#define API_NETWORKTHREADPLACEMENTPOLICY_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+namespace webrtc {
+
+// Decides which of the network threads of a PeerConnectionFactory a new
+// PeerConnection runs on. All transports, ports and sockets of the
+// PeerConnection live on that thread for its whole lifetime.
+class NetworkThreadPlacementPolicy {
+ public:
+  virtual ~NetworkThreadPlacementPolicy() {}
+
+  // Called on the signaling thread. |peer_connections_per_thread| holds the
+  // number of live PeerConnections on each network thread. Returns the index
+  // of the thread to use; out of range values are clamped.
+  virtual size_t SelectNetworkThread(
+      const std::vector<size_t>& peer_connections_per_thread) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_NETWORKTHREADPLACEMENTPOLICY_H_
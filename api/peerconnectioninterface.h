@@ -82,6 +82,7 @@
 #include "api/fec_controller.h"
 #include "api/jsep.h"
 #include "api/mediastreaminterface.h"
+#include "api/networkthreadplacementpolicy.h"
 #include "api/rtcerror.h"
 #include "api/rtceventlogoutput.h"
 #include "api/rtpreceiverinterface.h"
@@ -1233,6 +1234,14 @@ struct PeerConnectionFactoryDependencies final {
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory;
   std::unique_ptr<FecControllerFactoryInterface> fec_controller_factory;
   std::unique_ptr<NetworkControllerFactoryInterface> network_controller_factory;
+  // Number of network threads. The first one is |network_thread|, or one
+  // created by the factory if not set; the factory creates the others.
+  // PeerConnections are spread across them by |network_thread_placement|,
+  // which defaults to picking the thread with the fewest PeerConnections.
+  // PeerConnections created with their own port allocator or certificate
+  // generator always run on |network_thread|.
+  size_t network_thread_count = 1;
+  std::unique_ptr<NetworkThreadPlacementPolicy> network_thread_placement;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
@@ -70,6 +70,17 @@ class RTCStatsReport : public rtc::RefCountInterface {
   // Takes ownership of all the stats in |victim|, leaving it empty.
   void TakeMembersFrom(rtc::scoped_refptr<RTCStatsReport> victim);
 
+  // Creates a report, with the timestamp of this one, of the stats that are
+  // new or have changed since |previous|. The ids of the stats in |previous|
+  // that are no longer present are appended to |removed_ids|. Stats are
+  // compared with |RTCStats::operator==|, so objects that differ only in
+  // timestamp are left out. This compares every stats object and copies the
+  // changed ones, on top of producing both reports in full; it makes the
+  // result smaller, not the poll cheaper.
+  rtc::scoped_refptr<RTCStatsReport> DeltaSince(
+      const RTCStatsReport& previous,
+      std::vector<std::string>* removed_ids) const;
+
   // Stats iterators. Stats are ordered lexicographically on |RTCStats::id|.
   ConstIterator begin() const;
   ConstIterator end() const;
@@ -0,0 +1,148 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_STATS_RTCSTATSREPORTBINARY_H_
+#define API_STATS_RTCSTATSREPORTBINARY_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "api/array_view.h"
+#include "api/stats/rtcstatsreport.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// A compact binary encoding of a sequence of |RTCStatsReport|s, for exporting
+// stats from many sessions where |RTCStatsReport::ToJson| costs too much.
+//
+// Integers are LEB128 varints, zigzag encoded if signed, and doubles are their
+// 8 bytes in little endian order. Stats ids, stats types and member names are
+// interned: the first occurrence of a string in a stream is written out and
+// later ones only refer to it by index. This carries over from one report to
+// the next, so a stream of reports of the same session mostly consists of
+// member values. Undefined members are left out. To bound the memory of the
+// writer and the reader, the writer starts over with an empty string table,
+// announced by a clear record, once the strings it has interned exceed a size
+// limit.
+//
+//   stream  = version (report | clear)*
+//   report  = varint(#stats + 1) zigzag(timestamp_us) stats*
+//   clear   = varint(0)
+//   stats   = string(id) string(type) zigzag(timestamp_us - report timestamp)
+//             varint(#defined members) member*
+//   member  = string(name) byte(RTCStatsMemberInterface::Type) value
+//   string  = varint(0) varint(length) bytes  -- new string, next index
+//           | varint(index + 1)               -- earlier string
+//
+// Sequences are a varint element count followed by the elements. String
+// values are not interned.
+
+// Encodes reports and hands the encoding to an |Output| in chunks of a fixed
+// size, without building the whole encoding in memory.
+class RTCStatsReportWriter {
+ public:
+  class Output {
+   public:
+    virtual ~Output() {}
+    virtual void Write(rtc::ArrayView<const uint8_t> data) = 0;
+  };
+
+  // |output| must outlive the writer.
+  explicit RTCStatsReportWriter(Output* output);
+  // The string table is cleared before a report once the interned strings add
+  // up to more than |max_string_table_size| bytes.
+  RTCStatsReportWriter(Output* output, size_t max_string_table_size);
+  // Flushes.
+  ~RTCStatsReportWriter();
+
+  void WriteReport(const RTCStatsReport& report);
+  // Passes whatever is buffered to the output. Done automatically whenever
+  // the buffer is full.
+  void Flush();
+
+  // The total size of the encoding so far, flushed or not.
+  size_t bytes_written() const { return bytes_flushed_ + buffer_size_; }
+
+ private:
+  void ClearStringTable();
+  void WriteStats(const RTCStats& stats, int64_t report_timestamp_us);
+  void WriteMember(const RTCStatsMemberInterface& member);
+  // Stats types and member names are static strings, so they are interned by
+  // address. The same text at two addresses is written out twice, which costs
+  // a few bytes but is decoded correctly.
+  void WriteStaticString(const char* str);
+  void WriteIdString(const std::string& str);
+  void WriteNewString(const char* data, size_t size);
+  void WriteString(const char* data, size_t size);
+  void WriteVarint(uint64_t value);
+  void WriteSignedVarint(int64_t value);
+  void WriteDouble(double value);
+  void WriteBytes(const uint8_t* data, size_t size);
+  void WriteByte(uint8_t value);
+
+  static const size_t kBufferSize = 4096;
+
+  Output* const output_;
+  const size_t max_string_table_size_;
+  uint8_t buffer_[kBufferSize];
+  size_t buffer_size_ = 0;
+  size_t bytes_flushed_ = 0;
+  uint64_t num_strings_ = 0;
+  size_t string_table_size_ = 0;
+  std::unordered_map<const char*, uint64_t> static_string_indices_;
+  std::unordered_map<std::string, uint64_t> id_string_indices_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RTCStatsReportWriter);
+};
+
+// Decodes the reports of a stream written by |RTCStatsReportWriter|, in
+// order. The stats objects are not of their original classes, but have the
+// same id, type, timestamp and defined members, so that the decoded report has
+// the same |RTCStatsReport::ToJson| as the original.
+class RTCStatsReportReader {
+ public:
+  // |stream| must outlive the reader.
+  explicit RTCStatsReportReader(rtc::ArrayView<const uint8_t> stream);
+  ~RTCStatsReportReader();
+
+  // Returns null at the end of the stream, or if it is malformed.
+  rtc::scoped_refptr<RTCStatsReport> ReadReport();
+
+  bool at_end() const { return position_ == stream_.size(); }
+
+ private:
+  std::unique_ptr<RTCStats> ReadStats(int64_t report_timestamp_us);
+  std::unique_ptr<RTCStatsMemberInterface> ReadMember();
+  bool ReadString(const std::string** str);
+  bool ReadStringValue(std::string* str);
+  bool ReadVarint(uint64_t* value);
+  bool ReadSignedVarint(int64_t* value);
+  bool ReadDouble(double* value);
+  bool ReadByte(uint8_t* value);
+  bool ReadSequenceSize(size_t* size);
+
+  const rtc::ArrayView<const uint8_t> stream_;
+  size_t position_ = 0;
+  bool version_read_ = false;
+  // Owned jointly with the decoded stats objects, whose types and member
+  // names point into it. A deque never moves its elements when growing. A
+  // clear record replaces it with a new one.
+  std::shared_ptr<std::deque<std::string>> strings_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RTCStatsReportReader);
+};
+
+}  // namespace webrtc
+
+#endif  // API_STATS_RTCSTATSREPORTBINARY_H_
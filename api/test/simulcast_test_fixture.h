@@ -33,6 +33,8 @@ class SimulcastTestFixture {
   virtual void TestSpatioTemporalLayers333PatternEncoder() = 0;
   virtual void TestSpatioTemporalLayers321PatternEncoder() = 0;
   virtual void TestStrideEncodeDecode() = 0;
+  // Reports the mean time to encode a frame in all streams.
+  virtual void TestEncodeTime() = 0;
 };
 
 }  // namespace test
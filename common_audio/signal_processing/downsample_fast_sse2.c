@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <emmintrin.h>
+#include <stddef.h>
+
+// Filters with more coefficients than this are run by the C version.
+#define MAX_COEFFICIENT_CHUNKS 4
+
+// SSE2 version of WebRtcSpl_DownsampleFast() for x86 platforms. Four output
+// samples are computed at a time, each as a dot product between the reversed
+// coefficients and the input. The sums wrap around in the same way as the
+// 32-bit accumulation of the C version, so the outputs are bit-exact.
+int WebRtcSpl_DownsampleFastSSE2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  __m128i reversed_coefficients[MAX_COEFFICIENT_CHUNKS];
+  int16_t padded_coefficients[MAX_COEFFICIENT_CHUNKS * 8] = {0};
+  const size_t num_chunks = (coefficients_length + 7) >> 3;
+  const size_t padded_length = num_chunks << 3;
+  size_t i = 0;
+  size_t j = 0;
+  size_t k = 0;
+  int32_t out_s32 = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+
+  if (num_chunks > MAX_COEFFICIENT_CHUNKS) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  // Output i is the dot product of the reversed coefficients and
+  // data_in[i - coefficients_length + 1 ... i]. The coefficients are padded
+  // with zeros to a whole number of vectors.
+  for (j = 0; j < coefficients_length; j++) {
+    padded_coefficients[j] = coefficients[coefficients_length - 1 - j];
+  }
+  for (k = 0; k < num_chunks; k++) {
+    reversed_coefficients[k] =
+        _mm_loadu_si128((const __m128i*)&padded_coefficients[8 * k]);
+  }
+
+  // The padding makes the vector loads read up to
+  // |padded_length| - |coefficients_length| samples past data_in[i], so the
+  // last outputs may have to be computed by the scalar loop below.
+  for (i = delay; i + 3 * factor < endpos &&
+                  i + 3 * factor + padded_length <
+                      data_in_length + coefficients_length;
+       i += 4 * factor) {
+    __m128i sums[4];
+    __m128i out;
+    size_t n = 0;
+
+    for (n = 0; n < 4; n++) {
+      const int16_t* in =
+          &data_in[(ptrdiff_t)(i + n * factor) -
+                   (ptrdiff_t)coefficients_length + 1];
+      __m128i sum = _mm_setzero_si128();
+      for (k = 0; k < num_chunks; k++) {
+        sum = _mm_add_epi32(
+            sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&in[8 * k]),
+                                reversed_coefficients[k]));
+      }
+      sums[n] = sum;
+    }
+
+    // Add up the four lanes of each sum, giving one output per lane.
+    sums[0] = _mm_add_epi32(_mm_unpacklo_epi32(sums[0], sums[1]),
+                            _mm_unpackhi_epi32(sums[0], sums[1]));
+    sums[2] = _mm_add_epi32(_mm_unpacklo_epi32(sums[2], sums[3]),
+                            _mm_unpackhi_epi32(sums[2], sums[3]));
+    out = _mm_add_epi32(_mm_unpacklo_epi64(sums[0], sums[2]),
+                        _mm_unpackhi_epi64(sums[0], sums[2]));
+
+    // Round, shift to Q0, saturate and store the outputs.
+    out = _mm_srai_epi32(_mm_add_epi32(out, _mm_set1_epi32(2048)), 12);
+    _mm_storel_epi64((__m128i*)data_out, _mm_packs_epi32(out, out));
+    data_out += 4;
+  }
+
+  for (; i < endpos; i += factor) {
+    out_s32 = 2048;  // Round value, 0.5 in Q12.
+
+    for (j = 0; j < coefficients_length; j++) {
+      out_s32 += coefficients[j] * data_in[(ptrdiff_t) i - (ptrdiff_t) j];
+    }
+
+    out_s32 >>= 12;  // Q0.
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32);
+  }
+
+  return 0;
+}
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "rtc_base/checks.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum absolute value of word16 vector. SSE2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int absolute = 0, maximum = 0;
+  const __m128i zero = _mm_setzero_si128();
+  __m128i max_v = zero;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)&vector[i]);
+    // The saturating negation turns -32768 into 32767, which is also what the
+    // C version returns for it.
+    max_v = _mm_max_epi16(max_v, _mm_max_epi16(v, _mm_subs_epi16(zero, v)));
+  }
+
+  max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 8));
+  max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 4));
+  max_v = _mm_max_epi16(max_v, _mm_srli_si128(max_v, 2));
+  maximum = _mm_extract_epi16(max_v, 0);
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
@@ -12,6 +12,8 @@
 #include <sstream>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -476,10 +478,10 @@ TEST_F(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
+  if (WebRtcSpl_CrossCorrelation == WebRtcSpl_CrossCorrelationNeon) {
     expected = kExpectedNeon;
   }
 #endif
@@ -606,3 +608,151 @@ TEST_F(SplTest, Resample48WithSaturationTest) {
     EXPECT_EQ(kRefValue16kHz2, out_vector_w16[i]);
   }
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+// Fills |vector| with random samples, and full scale samples at the start so
+// that the products that overflow in pairs are covered.
+void FillRandom(webrtc::Random* random, int16_t* vector, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    vector[i] = random->Rand<int16_t>();
+  }
+  vector[0] = vector[1] = WEBRTC_SPL_WORD16_MIN;
+  vector[2] = WEBRTC_SPL_WORD16_MAX;
+}
+
+}  // namespace
+
+TEST_F(SplTest, CrossCorrelationSse2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  const size_t kSeqDimension = 61;
+  const size_t kCrossCorrelationDimension = 20;
+  webrtc::Random random(42U);
+  int16_t seq1[kSeqDimension];
+  int16_t seq2[kSeqDimension + kCrossCorrelationDimension];
+  FillRandom(&random, seq1, kSeqDimension);
+  FillRandom(&random, seq2, kSeqDimension + kCrossCorrelationDimension);
+
+  for (int shift = 0; shift < 8; ++shift) {
+    for (int step : {1, -1}) {
+      const int16_t* start =
+          step > 0 ? seq2 : &seq2[kCrossCorrelationDimension - 1];
+      int32_t expected[kCrossCorrelationDimension];
+      int32_t actual[kCrossCorrelationDimension];
+      WebRtcSpl_CrossCorrelationC(expected, seq1, start, kSeqDimension,
+                                  kCrossCorrelationDimension, shift, step);
+      WebRtcSpl_CrossCorrelationSSE2(actual, seq1, start, kSeqDimension,
+                                     kCrossCorrelationDimension, shift, step);
+      for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+      }
+    }
+  }
+}
+
+TEST_F(SplTest, DownsampleFastSse2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  // The filter state is read from the samples before |data_in|.
+  const size_t kHistory = 40;
+  const size_t kDataLength = 240;
+  const size_t kMaxCoefficients = 40;
+  webrtc::Random random(42U);
+  int16_t buffer[kHistory + kDataLength];
+  int16_t coefficients[kMaxCoefficients];
+  FillRandom(&random, buffer, kHistory + kDataLength);
+  FillRandom(&random, coefficients, kMaxCoefficients);
+  const int16_t* data_in = &buffer[kHistory];
+
+  for (size_t length = 1; length <= kMaxCoefficients; ++length) {
+    for (int factor : {1, 2, 3, 4, 12}) {
+      for (size_t delay : {0, 1, 5}) {
+        // Use all of the input, so that the last outputs cannot be computed
+        // with the padded vector loads.
+        const size_t out_length = (kDataLength - delay - 1) / factor + 1;
+        int16_t expected[kDataLength];
+        int16_t actual[kDataLength];
+        ASSERT_EQ(0, WebRtcSpl_DownsampleFastC(data_in, kDataLength, expected,
+                                               out_length, coefficients,
+                                               length, factor, delay));
+        ASSERT_EQ(0, WebRtcSpl_DownsampleFastSSE2(data_in, kDataLength, actual,
+                                                  out_length, coefficients,
+                                                  length, factor, delay));
+        for (size_t i = 0; i < out_length; ++i) {
+          EXPECT_EQ(expected[i], actual[i]);
+        }
+      }
+    }
+  }
+
+  // Too short input.
+  int16_t out[2];
+  EXPECT_EQ(-1, WebRtcSpl_DownsampleFastSSE2(data_in, 2, out, 2, coefficients,
+                                             4, 2, 1));
+}
+
+TEST_F(SplTest, MaxAbsValueW16Sse2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  const size_t kVectorSize = 37;
+  webrtc::Random random(42U);
+  int16_t vector[kVectorSize];
+  for (size_t i = 0; i < kVectorSize; ++i) {
+    vector[i] = random.Rand(-1000, 1000);
+  }
+  for (size_t length = 1; length <= kVectorSize; ++length) {
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(vector, length),
+              WebRtcSpl_MaxAbsValueW16SSE2(vector, length));
+  }
+
+  // abs(-32768) is returned as 32767, both in the vector loop and in the
+  // scalar one.
+  vector[3] = WEBRTC_SPL_WORD16_MIN;
+  vector[kVectorSize - 1] = WEBRTC_SPL_WORD16_MIN;
+  EXPECT_EQ(WEBRTC_SPL_WORD16_MAX,
+            WebRtcSpl_MaxAbsValueW16SSE2(vector, kVectorSize));
+  EXPECT_EQ(WEBRTC_SPL_WORD16_MAX,
+            WebRtcSpl_MaxAbsValueW16SSE2(&vector[kVectorSize - 1], 1));
+}
+
+TEST_F(SplTest, ScaleAndAddVectorsWithRoundSse2IsBitExact) {
+  if (WebRtc_GetCPUInfo(kSSE2) == 0) {
+    return;
+  }
+  const size_t kVectorSize = 77;
+  webrtc::Random random(42U);
+  int16_t vector1[kVectorSize];
+  int16_t vector2[kVectorSize];
+  FillRandom(&random, vector1, kVectorSize);
+  FillRandom(&random, vector2, kVectorSize);
+
+  // Scales in Q14, like the cross-fades in NetEq, and extreme scales that
+  // make the results wrap around when they are cast to 16 bits.
+  const int16_t kScales[][2] = {{16384, 0}, {8192, 8192}, {-16384, 16384},
+                                {WEBRTC_SPL_WORD16_MIN, WEBRTC_SPL_WORD16_MIN},
+                                {WEBRTC_SPL_WORD16_MAX, 3}};
+  for (const auto& scales : kScales) {
+    for (int shift = 0; shift <= 16; ++shift) {
+      int16_t expected[kVectorSize];
+      int16_t actual[kVectorSize];
+      ASSERT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundC(
+                       vector1, scales[0], vector2, scales[1], shift,
+                       expected, kVectorSize));
+      ASSERT_EQ(0, WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(
+                       vector1, scales[0], vector2, scales[1], shift, actual,
+                       kVectorSize));
+      for (size_t i = 0; i < kVectorSize; ++i) {
+        EXPECT_EQ(expected[i], actual[i]);
+      }
+    }
+  }
+
+  EXPECT_EQ(-1, WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2(
+                    vector1, 1, vector2, 1, -1, vector1, kVectorSize));
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers, currently for ARM, MIPS and x86 platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -60,6 +60,18 @@ static void InitPointersToNeon(void) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Replace the C versions that have SSE2 versions. The SSE2 versions are
+ * bit-exact with the C versions. */
+static void InitPointersToSSE2(void) {
+  WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16SSE2;
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationSSE2;
+  WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastSSE2;
+  WebRtcSpl_ScaleAndAddVectorsWithRound =
+      WebRtcSpl_ScaleAndAddVectorsWithRoundSSE2;
+}
+#endif
+
 #if defined(MIPS32_LE)
 /* Initialize function pointers to the MIPS version. */
 static void InitPointersToMIPS(void) {
@@ -89,6 +101,11 @@ static void InitFunctionPointers(void) {
   InitPointersToMIPS();
 #else
   InitPointersToC();
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    InitPointersToSSE2();
+  }
+#endif
 #endif  /* WEBRTC_HAS_NEON */
 }
 
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMinBufferSize = 4096;
+constexpr size_t kDefaultMaxFreeBytes = 32 * 1024 * 1024;
+
+size_t SizeClass(size_t min_size) {
+  size_t size = kMinBufferSize;
+  while (size < min_size)
+    size *= 2;
+  return size;
+}
+
+}  // namespace
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxFreeBytes) {}
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_free_bytes)
+    : max_free_bytes_(max_free_bytes) {}
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBufferPool::Buffer>
+EncodedImageBufferPool::CreateBuffer(size_t min_size) {
+  const size_t size = SizeClass(min_size);
+  rtc::CritScope lock(&crit_);
+  // Look for a free buffer of the right size class, and drop the free buffers
+  // that exceed |max_free_bytes_|. A buffer is free if only the pool holds a
+  // reference to it. Since the pool never hands out a free buffer without
+  // holding |crit_|, a buffer can't go from free to used during the loop.
+  rtc::scoped_refptr<Buffer> buffer;
+  size_t free_bytes = 0;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    if (!(*it)->HasOneRef()) {
+      ++it;
+    } else if (!buffer && (*it)->size() == size) {
+      buffer = *it;
+      ++it;
+    } else if (free_bytes + (*it)->size() > max_free_bytes_) {
+      it = buffers_.erase(it);
+    } else {
+      free_bytes += (*it)->size();
+      ++it;
+    }
+  }
+  if (buffer)
+    return buffer;
+
+  buffer = new Buffer(size);
+  buffers_.push_back(buffer);
+  ++num_allocated_buffers_;
+  return buffer;
+}
+
+size_t EncodedImageBufferPool::num_allocated_buffers() const {
+  rtc::CritScope lock(&crit_);
+  return num_allocated_buffers_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, SimpleBufferReuse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer =
+      pool.CreateBuffer(10000);
+  EXPECT_GE(buffer->size(), 10000u);
+  const uint8_t* data = buffer->data();
+  // Release buffer so that it is returned to the pool.
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(10000);
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_EQ(1u, pool.num_allocated_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, ReusesBufferOfSameSizeClass) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer =
+      pool.CreateBuffer(9000);
+  const uint8_t* data = buffer->data();
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(12000);
+  EXPECT_EQ(data, buffer->data());
+  EXPECT_GE(buffer->size(), 12000u);
+  EXPECT_EQ(1u, pool.num_allocated_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, FailToReuseBufferInUse) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer1 =
+      pool.CreateBuffer(10000);
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer2 =
+      pool.CreateBuffer(10000);
+  EXPECT_NE(buffer1->data(), buffer2->data());
+  EXPECT_EQ(2u, pool.num_allocated_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, FailToReuseBufferOfOtherSizeClass) {
+  EncodedImageBufferPool pool;
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer =
+      pool.CreateBuffer(10000);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(100000);
+  EXPECT_GE(buffer->size(), 100000u);
+  EXPECT_EQ(2u, pool.num_allocated_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, NoAllocationsInSteadyState) {
+  EncodedImageBufferPool pool;
+  // Three simulcast streams that are reinitialized at alternating
+  // resolutions.
+  const size_t kSizes[] = {640 * 480 * 3 / 2, 320 * 240 * 3 / 2,
+                           160 * 120 * 3 / 2};
+  for (int i = 0; i < 10; ++i) {
+    rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffers[3];
+    for (size_t j = 0; j < 3; ++j) {
+      buffers[j] = pool.CreateBuffer(kSizes[(i + j) % 3]);
+    }
+  }
+  EXPECT_EQ(3u, pool.num_allocated_buffers());
+}
+
+TEST(TestEncodedImageBufferPool, DropsFreeBuffersAboveLimit) {
+  EncodedImageBufferPool pool(16384);
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> large =
+      pool.CreateBuffer(32768);
+  large = nullptr;
+  // The free buffer is larger than the limit, so it is dropped rather than
+  // kept for later.
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> small =
+      pool.CreateBuffer(1000);
+  small = nullptr;
+  large = pool.CreateBuffer(32768);
+  EXPECT_EQ(3u, pool.num_allocated_buffers());
+}
+
+}  // namespace webrtc
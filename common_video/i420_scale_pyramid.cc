@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/i420_scale_pyramid.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+I420ScalePyramid::I420ScalePyramid() = default;
+I420ScalePyramid::~I420ScalePyramid() = default;
+
+rtc::scoped_refptr<I420BufferInterface> I420ScalePyramid::Scale(
+    const rtc::scoped_refptr<I420BufferInterface>& source,
+    int width,
+    int height) {
+  RTC_DCHECK(source);
+  if (source->width() == width && source->height() == height)
+    return source;
+
+  if (source != source_)
+    SetSource(source);
+
+  rtc::scoped_refptr<I420BufferInterface> src = source;
+  for (const auto& level : levels_) {
+    if (level->width() == width && level->height() == height)
+      return level;
+    if (level->width() >= width && level->height() >= height &&
+        level->width() < src->width()) {
+      src = level;
+    }
+  }
+
+  rtc::scoped_refptr<I420Buffer> dst =
+      pools_[std::make_pair(width, height)].CreateBuffer(width, height);
+  libyuv::I420Scale(src->DataY(), src->StrideY(), src->DataU(), src->StrideU(),
+                    src->DataV(), src->StrideV(), src->width(), src->height(),
+                    dst->MutableDataY(), dst->StrideY(), dst->MutableDataU(),
+                    dst->StrideU(), dst->MutableDataV(), dst->StrideV(), width,
+                    height, libyuv::kFilterBilinear);
+  ++num_scaled_buffers_;
+  levels_.push_back(dst);
+  return dst;
+}
+
+void I420ScalePyramid::SetSource(
+    const rtc::scoped_refptr<I420BufferInterface>& source) {
+  for (auto it = pools_.begin(); it != pools_.end();) {
+    const bool used = std::any_of(
+        levels_.begin(), levels_.end(),
+        [it](const rtc::scoped_refptr<I420BufferInterface>& level) {
+          return level->width() == it->first.first &&
+                 level->height() == it->first.second;
+        });
+    if (used)
+      ++it;
+    else
+      it = pools_.erase(it);
+  }
+  levels_.clear();
+  source_ = source;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <set>
+
+#include "api/video/i420_buffer.h"
+#include "common_video/include/i420_scale_pyramid.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<I420Buffer> CreateSource(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  I420Buffer::SetBlack(buffer);
+  return buffer;
+}
+
+}  // namespace
+
+TEST(TestI420ScalePyramid, ReturnsSourceAtSourceResolution) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateSource(640, 360);
+  EXPECT_EQ(source, pyramid.Scale(source, 640, 360));
+  EXPECT_EQ(0u, pyramid.num_scaled_buffers());
+}
+
+TEST(TestI420ScalePyramid, ScalesToRequestedResolution) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420BufferInterface> scaled =
+      pyramid.Scale(CreateSource(640, 360), 320, 180);
+  EXPECT_EQ(320, scaled->width());
+  EXPECT_EQ(180, scaled->height());
+  EXPECT_EQ(1u, pyramid.num_scaled_buffers());
+}
+
+TEST(TestI420ScalePyramid, ReusesScaledBufferOfSameSource) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420BufferInterface> source = CreateSource(640, 360);
+  rtc::scoped_refptr<I420BufferInterface> scaled =
+      pyramid.Scale(source, 320, 180);
+  EXPECT_EQ(scaled, pyramid.Scale(source, 320, 180));
+  EXPECT_EQ(1u, pyramid.num_scaled_buffers());
+}
+
+TEST(TestI420ScalePyramid, ScalesAgainForNewSource) {
+  I420ScalePyramid pyramid;
+  pyramid.Scale(CreateSource(640, 360), 320, 180);
+  pyramid.Scale(CreateSource(640, 360), 320, 180);
+  EXPECT_EQ(2u, pyramid.num_scaled_buffers());
+}
+
+TEST(TestI420ScalePyramid, RecyclesBuffersAcrossFrames) {
+  I420ScalePyramid pyramid;
+  std::set<const uint8_t*> buffers;
+  for (int i = 0; i < 20; ++i)
+    buffers.insert(pyramid.Scale(CreateSource(640, 360), 320, 180)->DataY());
+  // Only the scaled buffer of the current source is still in use when the
+  // next frame arrives, the others are recycled.
+  EXPECT_LE(buffers.size(), 2u);
+}
+
+TEST(TestI420ScalePyramid, KeepsOnlyLevelsOfCurrentSource) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420BufferInterface> first = CreateSource(640, 360);
+  rtc::scoped_refptr<I420BufferInterface> second = CreateSource(640, 360);
+  pyramid.Scale(first, 320, 180);
+  pyramid.Scale(second, 320, 180);
+  pyramid.Scale(first, 320, 180);
+  EXPECT_EQ(3u, pyramid.num_scaled_buffers());
+}
+
+TEST(TestI420ScalePyramid, ReusesBufferOfPreviousSource) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420BufferInterface> scaled =
+      pyramid.Scale(CreateSource(640, 360), 320, 180);
+  const uint8_t* data = scaled->DataY();
+  scaled = nullptr;
+  // The pyramid releases the level of the previous source before scaling the
+  // next one, so the pooled buffer is reused.
+  EXPECT_EQ(data, pyramid.Scale(CreateSource(640, 360), 320, 180)->DataY());
+}
+
+TEST(TestI420ScalePyramid, ScalesFromSmallestLargerLevel) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = CreateSource(640, 360);
+  memset(source->MutableDataY(), 255, source->StrideY() * 360);
+  rtc::scoped_refptr<I420BufferInterface> half =
+      pyramid.Scale(source, 320, 180);
+  // Clear the half resolution level, so that the quarter resolution is black
+  // if it is scaled from it, and white if it is scaled from the source.
+  rtc::scoped_refptr<I420Buffer> writable_half(
+      static_cast<I420Buffer*>(half.get()));
+  memset(writable_half->MutableDataY(), 0, writable_half->StrideY() * 180);
+  rtc::scoped_refptr<I420BufferInterface> quarter =
+      pyramid.Scale(source, 160, 90);
+  EXPECT_EQ(0, quarter->DataY()[0]);
+  EXPECT_EQ(2u, pyramid.num_scaled_buffers());
+}
+
+// Measures the time spent per frame scaling a 1280x720 frame to the two lower
+// resolutions of a three stream simulcast, either each from the full
+// resolution frame or through the pyramid.
+TEST(I420ScalePyramidPerformance, ScaleSimulcastStreams) {
+  constexpr int kNumFrames = 300;
+  // Alternate between sources, so that every frame is scaled.
+  constexpr size_t kNumSources = 2;
+  rtc::scoped_refptr<I420Buffer> sources[kNumSources];
+  for (auto& source : sources)
+    source = CreateSource(1280, 720);
+
+  // A pyramid per stream scales every stream from the source.
+  I420ScalePyramid half_pyramid;
+  I420ScalePyramid quarter_pyramid;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumFrames; ++i) {
+    const rtc::scoped_refptr<I420Buffer>& source = sources[i % kNumSources];
+    half_pyramid.Scale(source, 640, 360);
+    quarter_pyramid.Scale(source, 320, 180);
+  }
+  test::PrintResult("i420_scale_time", "", "from_source",
+                    static_cast<double>(rtc::TimeMicros() - start_us) /
+                        kNumFrames,
+                    "us", false);
+
+  I420ScalePyramid pyramid;
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumFrames; ++i) {
+    const rtc::scoped_refptr<I420Buffer>& source = sources[i % kNumSources];
+    pyramid.Scale(source, 640, 360);
+    pyramid.Scale(source, 320, 180);
+  }
+  test::PrintResult("i420_scale_time", "", "pyramid",
+                    static_cast<double>(rtc::TimeMicros() - start_us) /
+                        kNumFrames,
+                    "us", false);
+  EXPECT_EQ(2u * kNumFrames, pyramid.num_scaled_buffers());
+}
+
+}  // namespace webrtc
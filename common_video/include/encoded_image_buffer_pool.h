@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <list>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcountedobject.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Pool of buffers for the bitstream of encoded images, so that encoders don't
+// have to allocate a new buffer every time they are initialized or produce a
+// frame that is larger than their current buffer. Buffer sizes are rounded up
+// to a power of two, so that a buffer can be reused by any request in the same
+// size class. When the last reference to a buffer outside the pool is
+// released, the buffer is returned to the pool. Unlike I420BufferPool, the
+// pool is thread safe.
+class EncodedImageBufferPool {
+ public:
+  // Explicitly use a RefCountedObject to get access to HasOneRef, needed by
+  // the pool to check exclusive access.
+  using Buffer = rtc::RefCountedObject<rtc::Buffer>;
+
+  EncodedImageBufferPool();
+  // At most |max_free_bytes| of buffers that are not in use are kept.
+  explicit EncodedImageBufferPool(size_t max_free_bytes);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer with a size of at least |min_size| bytes. The contents of
+  // a recycled buffer are not cleared.
+  rtc::scoped_refptr<Buffer> CreateBuffer(size_t min_size);
+
+  // Number of buffers that have been allocated by the pool, including those
+  // that have since been released.
+  size_t num_allocated_buffers() const;
+
+ private:
+  const size_t max_free_bytes_;
+  rtc::CriticalSection crit_;
+  std::list<rtc::scoped_refptr<Buffer>> buffers_ RTC_GUARDED_BY(crit_);
+  size_t num_allocated_buffers_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
+#define COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
+
+#include <stddef.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/i420_buffer_pool.h"
+#include "rtc_base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// Scales frames to the resolutions of simulcast streams. The scaled versions
+// of the current source buffer are kept, and every new resolution is scaled
+// from the smallest kept version that is at least as large, rather than from
+// the source. Requesting the resolutions from largest to smallest thus builds
+// a pyramid where each level is scaled from the one above it. A new source
+// buffer drops the levels of the previous one.
+//
+// Scaled buffers are taken from one I420BufferPool per resolution. A new
+// source buffer also drops the pools of the resolutions that were not asked
+// for with the previous one, e.g. after the streams have been reconfigured.
+// The pyramid holds a reference to the current source buffer, which is needed
+// to tell a new frame from a recycled buffer at the same address.
+//
+// The class is not thread-safe; each encoder owns its pyramid and calls it on
+// its encoding thread.
+class I420ScalePyramid {
+ public:
+  I420ScalePyramid();
+  ~I420ScalePyramid();
+
+  // Returns |source| scaled to |width|x|height|, or |source| itself if it
+  // already has that resolution. The returned buffer must not be modified.
+  rtc::scoped_refptr<I420BufferInterface> Scale(
+      const rtc::scoped_refptr<I420BufferInterface>& source,
+      int width,
+      int height);
+
+  // Number of times a buffer has been scaled, i.e. the number of calls to
+  // Scale() that were not served by an already scaled version.
+  size_t num_scaled_buffers() const { return num_scaled_buffers_; }
+
+ private:
+  void SetSource(const rtc::scoped_refptr<I420BufferInterface>& source);
+
+  rtc::scoped_refptr<I420BufferInterface> source_;
+  // Scaled versions of |source_|, in the order they were scaled.
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> levels_;
+  std::map<std::pair<int, int>, I420BufferPool> pools_;
+  size_t num_scaled_buffers_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
@@ -72,12 +72,12 @@ template <class Base> class RtpHelper : public Base {
       return false;
     }
     rtc::CopyOnWriteBuffer packet(reinterpret_cast<const uint8_t*>(data), len,
-                                  kMaxRtpPacketLen);
+                                  len + kMaxSrtpTrailerLen);
     return Base::SendPacket(&packet, options);
   }
   bool SendRtcp(const void* data, size_t len) {
     rtc::CopyOnWriteBuffer packet(reinterpret_cast<const uint8_t*>(data), len,
-                                  kMaxRtpPacketLen);
+                                  len + kMaxSrtpTrailerLen);
     return Base::SendRtcp(&packet, rtc::PacketOptions());
   }
 
@@ -22,6 +22,10 @@ namespace cricket {
 const size_t kMinRtpPacketLen = 12;
 const size_t kMaxRtpPacketLen = 2048;
 const size_t kMinRtcpPacketLen = 4;
+// Bytes SRTP may append to a packet: a 16 byte AES-GCM tag, plus the 4 byte
+// SRTCP index for RTCP. Packets headed for SrtpTransport should have this much
+// spare capacity so they can be protected in place.
+const size_t kMaxSrtpTrailerLen = 20;
 
 struct RtpHeader {
   int payload_type;
@@ -12,16 +12,16 @@
 
 #include <algorithm>
 
-
-#include "api/video/i420_buffer.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "media/engine/scopedvideoencoder.h"
 #include "modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "modules/video_coding/codecs/vp8/simulcast_rate_allocator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/ptr_util.h"
 #include "system_wrappers/include/clock.h"
-#include "third_party/libyuv/include/libyuv/scale.h"
+#include "system_wrappers/include/field_trial.h"
 
 namespace {
 
@@ -30,6 +30,9 @@ const unsigned int kDefaultMaxQp = 56;
 // Max qp for lowest spatial resolution when doing simulcast.
 const unsigned int kLowestResMaxQp = 45;
 
+const char kParallelEncodingFieldTrial[] =
+    "WebRTC-SimulcastEncoderAdapter-ParallelEncoding";
+
 uint32_t SumStreamMaxBitrate(int streams, const webrtc::VideoCodec& codec) {
   uint32_t bitrate_sum = 0;
   for (int i = 0; i < streams; ++i) {
@@ -114,7 +117,10 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory,
       factory_(factory),
       video_format_(format),
       encoded_complete_callback_(nullptr),
-      implementation_name_("SimulcastEncoderAdapter") {
+      implementation_name_("SimulcastEncoderAdapter"),
+      parallel_encoding_(
+          webrtc::field_trial::IsEnabled(kParallelEncodingFieldTrial)),
+      encoding_in_parallel_(0) {
   RTC_DCHECK(factory_);
 
   // The adapter is typically created on the worker thread, but operated on
@@ -246,7 +252,9 @@ int SimulcastEncoderAdapter::InitEncode(const VideoCodec* inst,
 
   if (doing_simulcast) {
     implementation_name_ =
-        "SimulcastEncoderAdapter (" + implementation_name + ")";
+        std::string(parallel_encoding_ ? "SimulcastEncoderAdapter, parallel ("
+                                       : "SimulcastEncoderAdapter (") +
+        implementation_name + ")";
   } else {
     implementation_name_ = implementation_name;
   }
@@ -291,69 +299,136 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  std::vector<std::pair<size_t, FrameType>> streams;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream) {
       continue;
     }
 
-    std::vector<FrameType> stream_frame_types;
     if (send_key_frame) {
-      stream_frame_types.push_back(kVideoFrameKey);
+      streams.emplace_back(stream_idx, kVideoFrameKey);
       streaminfos_[stream_idx].key_frame_request = false;
     } else {
-      stream_frame_types.push_back(kVideoFrameDelta);
+      streams.emplace_back(stream_idx, kVideoFrameDelta);
     }
+  }
 
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->type() ==
-            VideoFrameBuffer::Type::kNative) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          input_image.video_frame_buffer()->ToI420();
-      libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
-                        src_buffer->DataU(), src_buffer->StrideU(),
-                        src_buffer->DataV(), src_buffer->StrideV(), src_width,
-                        src_height, dst_buffer->MutableDataY(),
-                        dst_buffer->StrideY(), dst_buffer->MutableDataU(),
-                        dst_buffer->StrideU(), dst_buffer->MutableDataV(),
-                        dst_buffer->StrideV(), dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
-                     input_image.render_time_ms(), webrtc::kVideoRotation_0),
-          codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+  // Scale the input to the resolutions of the streams before encoding any of
+  // them, from the highest stream down, so that every stream is scaled from
+  // the next higher one rather than from the input.
+  std::vector<VideoFrame> stream_images;
+  stream_images.reserve(streams.size());
+  for (auto it = streams.rbegin(); it != streams.rend(); ++it) {
+    stream_images.push_back(ScaleToStream(it->first, input_image));
+  }
+  std::reverse(stream_images.begin(), stream_images.end());
+
+  if (parallel_encoding_ && streams.size() > 1) {
+    return EncodeStreamsInParallel(streams, stream_images,
+                                   codec_specific_info);
+  }
+  for (size_t i = 0; i < streams.size(); ++i) {
+    int ret = EncodeStream(streams[i].first, stream_images[i],
+                           codec_specific_info, streams[i].second);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+VideoFrame SimulcastEncoderAdapter::ScaleToStream(
+    size_t stream_idx,
+    const VideoFrame& input_image) {
+  int dst_width = streaminfos_[stream_idx].width;
+  int dst_height = streaminfos_[stream_idx].height;
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, pass the image on
+  // directly. Otherwise, we'll scale it to match what the encoder expects
+  // (below).
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if ((dst_width == input_image.width() &&
+       dst_height == input_image.height()) ||
+      input_image.video_frame_buffer()->type() ==
+          VideoFrameBuffer::Type::kNative) {
+    return input_image;
+  }
+
+  return VideoFrame(
+      scale_pyramid_.Scale(input_image.video_frame_buffer()->ToI420(),
+                           dst_width, dst_height),
+      input_image.timestamp(), input_image.render_time_ms(),
+      webrtc::kVideoRotation_0);
+}
+
+int SimulcastEncoderAdapter::EncodeStream(
+    size_t stream_idx,
+    const VideoFrame& stream_image,
+    const CodecSpecificInfo* codec_specific_info,
+    FrameType frame_type) {
+  std::vector<FrameType> stream_frame_types(1, frame_type);
+  return streaminfos_[stream_idx].encoder->Encode(
+      stream_image, codec_specific_info, &stream_frame_types);
+}
+
+int SimulcastEncoderAdapter::EncodeStreamsInParallel(
+    const std::vector<std::pair<size_t, FrameType>>& streams,
+    const std::vector<VideoFrame>& stream_images,
+    const CodecSpecificInfo* codec_specific_info) {
+  const size_t num_offloaded_streams = streams.size() - 1;
+  while (encode_queues_.size() < num_offloaded_streams) {
+    encode_queues_.push_back(
+        rtc::MakeUnique<rtc::TaskQueue>("SimulcastEncodeQueue"));
+  }
+
+  rtc::AtomicOps::ReleaseStore(&encoding_in_parallel_, 1);
+  std::vector<int> results(streams.size(), WEBRTC_VIDEO_CODEC_OK);
+  volatile int num_pending = static_cast<int>(num_offloaded_streams);
+  rtc::Event done(false, false);
+  for (size_t i = 0; i < num_offloaded_streams; ++i) {
+    encode_queues_[i]->PostTask([this, &streams, &stream_images,
+                                 codec_specific_info, &results, &num_pending,
+                                 &done, i] {
+      results[i] = EncodeStream(streams[i].first, stream_images[i],
+                                codec_specific_info, streams[i].second);
+      if (rtc::AtomicOps::Decrement(&num_pending) == 0)
+        done.Set();
+    });
+  }
+  // The highest stream takes the longest to encode, so it is encoded on this
+  // thread rather than waiting idle.
+  results.back() =
+      EncodeStream(streams.back().first, stream_images.back(),
+                   codec_specific_info, streams.back().second);
+  done.Wait(rtc::Event::kForever);
+  rtc::AtomicOps::ReleaseStore(&encoding_in_parallel_, 0);
+
+  for (const auto& stream : streams) {
+    std::vector<BufferedEncodedImage>& buffered_images =
+        streaminfos_[stream.first].buffered_images;
+    for (const BufferedEncodedImage& image : buffered_images) {
+      DeliverEncodedImage(stream.first, image.encoded_image,
+                          &image.codec_specific_info,
+                          image.fragmentation.get());
+    }
+    buffered_images.clear();
+  }
+
+  for (int result : results) {
+    if (result != WEBRTC_VIDEO_CODEC_OK) {
+      return result;
+    }
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&encoder_queue_);
@@ -434,6 +509,28 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
     const EncodedImage& encodedImage,
     const CodecSpecificInfo* codecSpecificInfo,
     const RTPFragmentationHeader* fragmentation) {
+  if (rtc::AtomicOps::AcquireLoad(&encoding_in_parallel_) == 1) {
+    // Called on the thread encoding |stream_idx|. The image is delivered by
+    // EncodeStreamsInParallel(), before the encoder overwrites its buffer.
+    BufferedEncodedImage image;
+    image.encoded_image = encodedImage;
+    image.codec_specific_info = *codecSpecificInfo;
+    if (fragmentation) {
+      image.fragmentation.reset(new RTPFragmentationHeader());
+      image.fragmentation->CopyFrom(*fragmentation);
+    }
+    streaminfos_[stream_idx].buffered_images.push_back(std::move(image));
+    return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
+  }
+  return DeliverEncodedImage(stream_idx, encodedImage, codecSpecificInfo,
+                             fragmentation);
+}
+
+EncodedImageCallback::Result SimulcastEncoderAdapter::DeliverEncodedImage(
+    size_t stream_idx,
+    const EncodedImage& encodedImage,
+    const CodecSpecificInfo* codecSpecificInfo,
+    const RTPFragmentationHeader* fragmentation) {
   CodecSpecificInfo stream_codec_specific = *codecSpecificInfo;
   stream_codec_specific.codec_name = implementation_name_.c_str();
   CodecSpecificInfoVP8* vp8Info = &(stream_codec_specific.codecSpecific.VP8);
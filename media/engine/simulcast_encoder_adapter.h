@@ -18,10 +18,12 @@
 #include <utility>
 #include <vector>
 
+#include "common_video/include/i420_scale_pyramid.h"
 #include "media/engine/webrtcvideoencoderfactory.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "rtc_base/atomicops.h"
 #include "rtc_base/sequenced_task_checker.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -32,6 +34,11 @@ class VideoEncoderFactory;
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+// When the "WebRTC-SimulcastEncoderAdapter-ParallelEncoding" field trial is
+// enabled, the streams of a frame are encoded in parallel, and the encoded
+// images are delivered in stream order once all streams are encoded. This
+// requires that the encoders deliver their images from within Encode(), and
+// that an encoded image stays valid until the encoder is used again.
 class SimulcastEncoderAdapter : public VP8Encoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory,
@@ -66,6 +73,14 @@ class SimulcastEncoderAdapter : public VP8Encoder {
   const char* ImplementationName() const override;
 
  private:
+  // An encoded image that is held back until all streams of the frame are
+  // encoded.
+  struct BufferedEncodedImage {
+    EncodedImage encoded_image;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
   struct StreamInfo {
     StreamInfo(std::unique_ptr<VideoEncoder> encoder,
                std::unique_ptr<EncodedImageCallback> callback,
@@ -84,6 +99,9 @@ class SimulcastEncoderAdapter : public VP8Encoder {
     uint16_t height;
     bool key_frame_request;
     bool send_stream;
+    // Images encoded while encoding in parallel, in the order they were
+    // produced.
+    std::vector<BufferedEncodedImage> buffered_images;
   };
 
   // Populate the codec settings for each simulcast stream.
@@ -97,6 +115,30 @@ class SimulcastEncoderAdapter : public VP8Encoder {
 
   void DestroyStoredEncoders();
 
+  // Returns |input_image| scaled to the resolution of the stream, if needed.
+  VideoFrame ScaleToStream(size_t stream_idx, const VideoFrame& input_image);
+
+  // Encodes |stream_image|, which has the resolution of the stream, with the
+  // encoder of the stream.
+  int EncodeStream(size_t stream_idx,
+                   const VideoFrame& stream_image,
+                   const CodecSpecificInfo* codec_specific_info,
+                   FrameType frame_type);
+
+  // Encodes |stream_images| with the encoders of |streams|: the highest stream
+  // on the calling thread, and the others on |encode_queues_|. Returns after
+  // the encoded images of all streams have been delivered.
+  int EncodeStreamsInParallel(
+      const std::vector<std::pair<size_t, FrameType>>& streams,
+      const std::vector<VideoFrame>& stream_images,
+      const CodecSpecificInfo* codec_specific_info);
+
+  EncodedImageCallback::Result DeliverEncodedImage(
+      size_t stream_idx,
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo* codec_specific_info,
+      const RTPFragmentationHeader* fragmentation);
+
   volatile int inited_;  // Accessed atomically.
   VideoEncoderFactory* const factory_;
   const SdpVideoFormat video_format_;
@@ -111,6 +153,17 @@ class SimulcastEncoderAdapter : public VP8Encoder {
   // Store encoders in between calls to Release and InitEncode, so they don't
   // have to be recreated. Remaining encoders are destroyed by the destructor.
   std::stack<std::unique_ptr<VideoEncoder>> stored_encoders_;
+
+  // Scales the input for the lower streams, each from the next higher one.
+  I420ScalePyramid scale_pyramid_;
+
+  const bool parallel_encoding_;
+  // Worker queues for parallel encoding. They are created on first use and
+  // kept across reinitializations.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> encode_queues_;
+  // Set while the streams are being encoded in parallel, so that the encoded
+  // images are buffered rather than delivered.
+  volatile int encoding_in_parallel_;  // Accessed atomically.
 };
 
 }  // namespace webrtc
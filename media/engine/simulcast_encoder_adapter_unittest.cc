@@ -22,6 +22,7 @@
 #include "modules/video_coding/codecs/vp8/simulcast_test_fixture_impl.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/ptr_util.h"
+#include "test/field_trial.h"
 #include "test/function_video_decoder_factory.h"
 #include "test/function_video_encoder_factory.h"
 #include "test/gmock.h"
@@ -142,6 +143,48 @@ TEST(SimulcastEncoderAdapterSimulcastTest,
   fixture->TestSpatioTemporalLayers321PatternEncoder();
 }
 
+TEST(SimulcastEncoderAdapterSimulcastTest, TestEncodeTime) {
+  InternalEncoderFactory internal_encoder_factory;
+  auto fixture = CreateSpecificSimulcastTestFixture(&internal_encoder_factory);
+  fixture->TestEncodeTime();
+}
+
+// Runs the fixture with the streams encoded in parallel.
+class SimulcastEncoderAdapterParallelSimulcastTest : public ::testing::Test {
+ protected:
+  SimulcastEncoderAdapterParallelSimulcastTest()
+      : override_field_trials_(
+            "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/"),
+        fixture_(
+            CreateSpecificSimulcastTestFixture(&internal_encoder_factory_)) {}
+
+  ScopedFieldTrials override_field_trials_;
+  InternalEncoderFactory internal_encoder_factory_;
+  std::unique_ptr<SimulcastTestFixture> fixture_;
+};
+
+TEST_F(SimulcastEncoderAdapterParallelSimulcastTest,
+       TestKeyFrameRequestsOnAllStreams) {
+  fixture_->TestKeyFrameRequestsOnAllStreams();
+}
+
+TEST_F(SimulcastEncoderAdapterParallelSimulcastTest, TestDisablingStreams) {
+  fixture_->TestDisablingStreams();
+}
+
+TEST_F(SimulcastEncoderAdapterParallelSimulcastTest, TestStrideEncodeDecode) {
+  fixture_->TestStrideEncodeDecode();
+}
+
+TEST_F(SimulcastEncoderAdapterParallelSimulcastTest,
+       TestSpatioTemporalLayers333PatternEncoder) {
+  fixture_->TestSpatioTemporalLayers333PatternEncoder();
+}
+
+TEST_F(SimulcastEncoderAdapterParallelSimulcastTest, TestEncodeTime) {
+  fixture_->TestEncodeTime();
+}
+
 class MockVideoEncoder;
 
 class MockVideoEncoderFactory : public VideoEncoderFactory {
@@ -198,14 +198,14 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
     rtc::PacketOptions rtc_options;
     rtc_options.packet_id = options.packet_id;
     return VoiceMediaChannel::SendPacket(&packet, rtc_options);
   }
 
   bool SendRtcp(const uint8_t* data, size_t len) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
     rtc::PacketOptions rtc_options;
     return VoiceMediaChannel::SendRtcp(&packet, rtc_options);
   }
@@ -8,13 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// of packet slots that are allocated once. The ring is kept sorted at all times
+// so that the next packet to decode is at the beginning of the ring.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
-#include <algorithm>  // find_if()
+#include <algorithm>
+#include <utility>
 
 #include "api/audio_codecs/audio_decoder.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
@@ -24,21 +25,6 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when |packet| goes before |new_packet|.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {
-  }
-  bool operator()(const Packet& packet) {
-    return (new_packet_ >= packet);
-  }
-
- private:
-  const Packet& new_packet_;
-};
-
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
 bool EqualSampleRates(uint8_t pt1,
@@ -62,7 +48,13 @@ void LogPacketDiscarded(int codec_level, StatisticsCalculator* stats) {
 
 PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer)
-    : max_number_of_packets_(max_number_of_packets), tick_timer_(tick_timer) {}
+    : max_number_of_packets_(max_number_of_packets),
+      // A full buffer is flushed before a packet is inserted, so there is
+      // always room for at least one packet.
+      slots_(std::max<size_t>(max_number_of_packets, 1)),
+      first_(0),
+      size_(0),
+      tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
 PacketBuffer::~PacketBuffer() {
@@ -71,11 +63,15 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  for (size_t i = 0; i < size_; ++i) {
+    PacketAt(i) = Packet();
+  }
+  first_ = 0;
+  size_ = 0;
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
@@ -91,37 +87,47 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full. Flush it.
     Flush();
     RTC_LOG(LS_WARNING) << "Packet buffer flushed";
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(),
-      NewTimestampIsLarger(packet));
-
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // Find the position in the buffer where the new packet should be inserted,
+  // which is after all packets that it is not smaller than. The buffer is
+  // searched from the back, since the most likely case is that the new packet
+  // should be at the end of the buffer, and reordered packets are usually
+  // only a few positions late.
+  size_t position = size_;
+  while (position > 0 && !(packet >= PacketAt(position - 1))) {
+    --position;
+  }
+
+  // The new packet is to be inserted after |position| - 1. If it has the same
+  // timestamp as that packet, which has a higher priority, do not insert the
+  // new packet.
+  if (position > 0 && packet.timestamp == PacketAt(position - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
+  // The new packet is to be inserted before |position|. If it has the same
+  // timestamp as that packet, which has a lower priority, replace it with the
+  // new packet.
+  if (position < size_ && packet.timestamp == PacketAt(position).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
-    it = buffer_.erase(it);
+    PacketAt(position) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+
+  // Make room by moving the packets after |position| one slot towards the
+  // back. Nothing is moved when the packet arrives in order.
+  for (size_t i = size_; i > position; --i) {
+    PacketAt(i) = std::move(PacketAt(i - 1));
+  }
+  PacketAt(position) = std::move(packet);
+  ++size_;
 
   return return_val;
 }
@@ -179,7 +185,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = PacketAt(0).timestamp;
   return kOK;
 }
 
@@ -191,11 +197,11 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = PacketAt(i);
+    if (packet.timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = packet.timestamp;
       return kOK;
     }
   }
@@ -203,7 +209,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &PacketAt(0);
 }
 
 rtc::Optional<Packet> PacketBuffer::GetNextPacket() {
@@ -212,10 +218,11 @@ rtc::Optional<Packet> PacketBuffer::GetNextPacket() {
     return rtc::nullopt;
   }
 
-  rtc::Optional<Packet> packet(std::move(buffer_.front()));
+  rtc::Optional<Packet> packet(std::move(PacketAt(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  first_ = (first_ + 1) % slots_.size();
+  --size_;
 
   return packet;
 }
@@ -225,24 +232,44 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  Packet& packet = PacketAt(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  packet = Packet();
+  first_ = (first_ + 1) % slots_.size();
+  --size_;
   return kOK;
 }
 
+template <typename Predicate>
+void PacketBuffer::DiscardPacketsIf(Predicate discard,
+                                    StatisticsCalculator* stats) {
+  size_t num_kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    Packet& packet = PacketAt(i);
+    if (discard(packet)) {
+      LogPacketDiscarded(packet.priority.codec_level, stats);
+      packet = Packet();
+    } else {
+      if (num_kept != i) {
+        PacketAt(num_kept) = std::move(packet);
+      }
+      ++num_kept;
+    }
+  }
+  size_ = num_kept;
+}
+
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
-    if (timestamp_limit == p.timestamp ||
-        !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  DiscardPacketsIf(
+      [timestamp_limit, horizon_samples](const Packet& p) {
+        return timestamp_limit != p.timestamp &&
+               IsObsoleteTimestamp(p.timestamp, timestamp_limit,
+                                   horizon_samples);
+      },
+      stats);
 }
 
 void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
@@ -252,23 +279,20 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
-    if (p.payload_type != payload_type) {
-      return false;
-    }
-    LogPacketDiscarded(p.priority.codec_level, stats);
-    return true;
-  });
+  DiscardPacketsIf(
+      [payload_type](const Packet& p) { return p.payload_type == payload_type; },
+      stats);
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = PacketAt(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -288,7 +312,8 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = PacketAt(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -298,7 +323,7 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
 }
 
 void PacketBuffer::BufferStat(int* num_packets, int* max_num_packets) const {
-  *num_packets = static_cast<int>(buffer_.size());
+  *num_packets = static_cast<int>(size_);
   *max_num_packets = static_cast<int>(max_number_of_packets_);
 }
 
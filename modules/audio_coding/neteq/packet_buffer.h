@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "api/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -37,7 +39,8 @@ class PacketBuffer {
   };
 
   // Constructor creates a buffer which can hold a maximum of
-  // |max_number_of_packets| packets.
+  // |max_number_of_packets| packets. The slots for all of them are allocated
+  // up front.
   PacketBuffer(size_t max_number_of_packets, const TickTimer* tick_timer);
 
   // Deletes all packets in the buffer before destroying the buffer.
@@ -143,8 +146,26 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the packet at position |index| in timestamp order, counted from
+  // the next packet to decode.
+  Packet& PacketAt(size_t index) {
+    return slots_[(first_ + index) % slots_.size()];
+  }
+  const Packet& PacketAt(size_t index) const {
+    return slots_[(first_ + index) % slots_.size()];
+  }
+
+  // Removes the packets for which |discard| returns true, keeping the order of
+  // the remaining ones, and logs them as discarded.
+  template <typename Predicate>
+  void DiscardPacketsIf(Predicate discard, StatisticsCalculator* stats);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // Ring of packet slots, sorted by timestamp starting at |first_|. Packets
+  // arriving in order are appended without moving any other packet.
+  std::vector<Packet> slots_;
+  size_t first_;
+  size_t size_;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
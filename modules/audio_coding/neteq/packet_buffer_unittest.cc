@@ -434,6 +434,49 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Keeps a few packets in a small buffer while many packets pass through it,
+// with every third packet arriving late, so that the packets wrap around the
+// end of the buffer's storage both in order and reordered.
+TEST(PacketBuffer, ReorderingWhileWrappingAround) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(5, &tick_timer);  // 5 packets.
+  const uint32_t start_ts = 0xFFFFFF00;  // Also wrap the timestamps around.
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(0xFFF0, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+
+  uint32_t expected_ts = start_ts;
+  rtc::Optional<Packet> late_packet;
+  for (int i = 0; i < 100; ++i) {
+    Packet packet = gen.NextPacket(payload_len);
+    if (i % 3 == 0) {
+      late_packet = std::move(packet);
+      continue;
+    }
+    EXPECT_EQ(PacketBuffer::kOK,
+              buffer.InsertPacket(std::move(packet), &mock_stats));
+    if (late_packet) {
+      EXPECT_EQ(PacketBuffer::kOK,
+                buffer.InsertPacket(std::move(*late_packet), &mock_stats));
+      late_packet = rtc::nullopt;
+    }
+    while (buffer.NumPacketsInBuffer() > 3) {
+      const rtc::Optional<Packet> next = buffer.GetNextPacket();
+      ASSERT_TRUE(next);
+      EXPECT_EQ(expected_ts, next->timestamp);
+      expected_ts += ts_increment;
+    }
+  }
+  while (rtc::Optional<Packet> next = buffer.GetNextPacket()) {
+    EXPECT_EQ(expected_ts, next->timestamp);
+    expected_ts += ts_increment;
+  }
+  if (late_packet) {
+    EXPECT_EQ(expected_ts, late_packet->timestamp);
+  }
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -48,3 +48,38 @@ TEST(NetEqPerformanceTest, RunClean) {
   webrtc::test::PrintResult(
       "neteq_performance", "", "0_pl_0_drift", runtime, "ms", true);
 }
+
+// Measures the cost of the DSP operations that dominate NetEq's CPU usage
+// under bursty packet loss.
+TEST(NetEqPerformanceTest, Operations) {
+  const int kNumCalls = 10000;
+  const int kQuickNumCalls = 100;
+  const auto costs = webrtc::test::NetEqPerformanceTest::RunOperations(
+      webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumCalls
+                                                             : kNumCalls);
+  ASSERT_TRUE(costs);
+  webrtc::test::PrintResult("neteq_operation_time", "", "expand",
+                            costs->expand_us, "us", false);
+  webrtc::test::PrintResult("neteq_operation_time", "", "merge",
+                            costs->merge_us, "us", false);
+  webrtc::test::PrintResult("neteq_operation_time", "", "accelerate",
+                            costs->accelerate_us, "us", false);
+}
+
+// Measures the time spent in the packet buffer per packet, with packets
+// arriving in order and with some of them reordered.
+TEST(NetEqPerformanceTest, PacketBuffer) {
+  const int kNumPackets = 1000000;
+  const int kQuickNumPackets = 10000;
+  const int num_packets =
+      webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest") ? kQuickNumPackets
+                                                             : kNumPackets;
+  webrtc::test::PrintResult(
+      "neteq_packet_buffer_time", "", "in_order",
+      webrtc::test::NetEqPerformanceTest::RunPacketBuffer(num_packets, false),
+      "ns", false);
+  webrtc::test::PrintResult(
+      "neteq_packet_buffer_time", "", "reordered",
+      webrtc::test::NetEqPerformanceTest::RunPacketBuffer(num_packets, true),
+      "ns", false);
+}
@@ -23,6 +23,8 @@ DEFINE_int(lossrate, 10,
            "Packet lossrate; drop every N packets.");
 DEFINE_float(drift, 0.1f,
              "Clockdrift factor.");
+DEFINE_int(operation_calls, 1000,
+           "Number of calls to time for each DSP operation; 0 to skip.");
 DEFINE_bool(help, false, "Print this message.");
 
 int main(int argc, char* argv[]) {
@@ -32,7 +34,9 @@ int main(int argc, char* argv[]) {
       "  --runtime_ms=N         runtime in ms; default is 10000 ms\n"
       "  --lossrate=N           drop every N packets; default is 10\n"
       "  --drift=F              clockdrift factor between 0.0 and 1.0; "
-      "default is 0.1\n";
+      "default is 0.1\n"
+      "  --operation_calls=N    calls to time for each of Expand, Merge and\n"
+      "                         Accelerate; default is 1000\n";
   webrtc::test::SetExecutablePath(argv[0]);
   if (rtc::FlagList::SetFlagsFromCommandLine(&argc, argv, true) ||
       FLAG_help || argc != 1) {
@@ -46,6 +50,7 @@ int main(int argc, char* argv[]) {
   RTC_CHECK_GT(FLAG_runtime_ms, 0);
   RTC_CHECK_GE(FLAG_lossrate, 0);
   RTC_CHECK(FLAG_drift >= 0.0 && FLAG_drift < 1.0);
+  RTC_CHECK_GE(FLAG_operation_calls, 0);
 
   int64_t result =
       webrtc::test::NetEqPerformanceTest::Run(FLAG_runtime_ms, FLAG_lossrate,
@@ -57,5 +62,19 @@ int main(int argc, char* argv[]) {
 
   std::cout << "Simulation done" << std::endl;
   std::cout << "Runtime = " << result << " ms" << std::endl;
+
+  if (FLAG_operation_calls > 0) {
+    const auto costs = webrtc::test::NetEqPerformanceTest::RunOperations(
+        FLAG_operation_calls);
+    if (!costs) {
+      std::cout << "There was an error" << std::endl;
+      return -1;
+    }
+    std::cout << "Expand = " << costs->expand_us << " us per call"
+              << std::endl;
+    std::cout << "Merge = " << costs->merge_us << " us per call" << std::endl;
+    std::cout << "Accelerate = " << costs->accelerate_us << " us per call"
+              << std::endl;
+  }
   return 0;
 }
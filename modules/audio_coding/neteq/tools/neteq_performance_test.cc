@@ -10,14 +10,28 @@
 
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "api/audio/audio_frame.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "common_types.h"  // NOLINT(build/include)
 #include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "modules/audio_coding/neteq/accelerate.h"
+#include "modules/audio_coding/neteq/background_noise.h"
+#include "modules/audio_coding/neteq/expand.h"
 #include "modules/audio_coding/neteq/include/neteq.h"
+#include "modules/audio_coding/neteq/merge.h"
+#include "modules/audio_coding/neteq/packet_buffer.h"
+#include "modules/audio_coding/neteq/random_vector.h"
+#include "modules/audio_coding/neteq/statistics_calculator.h"
+#include "modules/audio_coding/neteq/sync_buffer.h"
+#include "modules/audio_coding/neteq/tick_timer.h"
 #include "modules/audio_coding/neteq/tools/audio_loop.h"
 #include "modules/audio_coding/neteq/tools/rtp_generator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/testsupport/fileutils.h"
 #include "typedefs.h"  // NOLINT(build/include)
@@ -128,5 +142,119 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
   return end_time_ms - start_time_ms;
 }
 
+rtc::Optional<NetEqPerformanceTest::OperationCosts>
+NetEqPerformanceTest::RunOperations(int num_calls) {
+  const std::string kInputFileName =
+      webrtc::test::ResourcePath("audio_coding/testfile32kHz", "pcm");
+  const int kSampRateHz = 32000;
+  const size_t kNumChannels = 1;
+  const size_t kBlockSizeSamples = 30 * kSampRateHz / 1000;  // 30 ms.
+  // This is the same size that is given to the SyncBuffer object in NetEq.
+  const size_t kSyncBufferSizeSamples = 720 * kSampRateHz / 1000;
+
+  AudioLoop audio_loop;
+  if (!audio_loop.Init(kInputFileName, kSampRateHz * 10, kBlockSizeSamples))
+    return rtc::nullopt;
+
+  WebRtcSpl_Init();
+  BackgroundNoise background_noise(kNumChannels);
+  SyncBuffer sync_buffer(kNumChannels, kSyncBufferSizeSamples);
+  RandomVector random_vector;
+  StatisticsCalculator statistics;
+  Expand expand(&background_noise, &sync_buffer, &random_vector, &statistics,
+                kSampRateHz, kNumChannels);
+  Merge merge(kSampRateHz, kNumChannels, &expand, &sync_buffer);
+  Accelerate accelerate(kSampRateHz, kNumChannels, background_noise);
+
+  // Pushes the next block of the input file into the sync buffer.
+  auto push_next_block = [&]() {
+    AudioMultiVector block(kNumChannels);
+    block.PushBackInterleaved(audio_loop.GetNextBlock().data(),
+                              kBlockSizeSamples);
+    sync_buffer.PushBack(block);
+  };
+  for (size_t i = 0; i < kSyncBufferSizeSamples / kBlockSizeSamples; ++i) {
+    push_next_block();
+  }
+
+  std::vector<int16_t> decoded(kBlockSizeSamples);
+  int64_t expand_us = 0;
+  int64_t merge_us = 0;
+  int64_t accelerate_us = 0;
+  for (int i = 0; i < num_calls; ++i) {
+    // Everything in the sync buffer has been played out when the loss starts.
+    push_next_block();
+    sync_buffer.set_next_index(sync_buffer.Size());
+
+    // The first expansion after a loss, which analyzes the signal.
+    AudioMultiVector expanded(kNumChannels);
+    expand.Reset();
+    int64_t start_us = rtc::TimeMicros();
+    if (expand.Process(&expanded) != 0)
+      return rtc::nullopt;
+    expand_us += rtc::TimeMicros() - start_us;
+    sync_buffer.PushBack(expanded);
+
+    // The next packet arrives and is merged with the expansion.
+    auto block = audio_loop.GetNextBlock();
+    std::copy(block.begin(), block.end(), decoded.begin());
+    AudioMultiVector merged(kNumChannels);
+    start_us = rtc::TimeMicros();
+    merge.Process(decoded.data(), decoded.size(), &merged);
+    merge_us += rtc::TimeMicros() - start_us;
+
+    AudioMultiVector accelerated(kNumChannels);
+    size_t length_change_samples;
+    start_us = rtc::TimeMicros();
+    if (accelerate.Process(decoded.data(), decoded.size(), false,
+                           &accelerated,
+                           &length_change_samples) == TimeStretch::kError)
+      return rtc::nullopt;
+    accelerate_us += rtc::TimeMicros() - start_us;
+  }
+
+  OperationCosts costs;
+  costs.expand_us = static_cast<double>(expand_us) / num_calls;
+  costs.merge_us = static_cast<double>(merge_us) / num_calls;
+  costs.accelerate_us = static_cast<double>(accelerate_us) / num_calls;
+  return costs;
+}
+
+double NetEqPerformanceTest::RunPacketBuffer(int num_packets, bool reorder) {
+  const size_t kPacketSizeSamples = 20 * 48000 / 1000;  // 20 ms at 48 kHz.
+  const size_t kPayloadSizeBytes = 160;
+  const size_t kMaxPacketsInBuffer = 50;
+  const size_t kJitterBufferPackets = 5;
+
+  // The packets are created up front, so that only the buffer is timed.
+  std::vector<Packet> packets(num_packets);
+  for (int i = 0; i < num_packets; ++i) {
+    packets[i].sequence_number = static_cast<uint16_t>(i);
+    packets[i].timestamp = static_cast<uint32_t>(i * kPacketSizeSamples);
+    packets[i].payload_type = 0;
+    packets[i].payload.SetSize(kPayloadSizeBytes);
+  }
+  if (reorder) {
+    for (int i = 0; i + 1 < num_packets; i += 5) {
+      std::swap(packets[i], packets[i + 1]);
+    }
+  }
+
+  TickTimer tick_timer;
+  StatisticsCalculator stats;
+  PacketBuffer packet_buffer(kMaxPacketsInBuffer, &tick_timer);
+  const int64_t start_ns = rtc::TimeNanos();
+  for (Packet& packet : packets) {
+    packet_buffer.InsertPacket(std::move(packet), &stats);
+    if (packet_buffer.NumPacketsInBuffer() > kJitterBufferPackets) {
+      packet_buffer.GetNextPacket();
+    }
+  }
+  while (packet_buffer.GetNextPacket()) {
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  return static_cast<double>(elapsed_ns) / num_packets;
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_PERFORMANCE_TEST_H_
 #define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_PERFORMANCE_TEST_H_
 
+#include "api/optional.h"
 #include "typedefs.h"  // NOLINT(build/include)
 
 namespace webrtc {
@@ -24,6 +25,25 @@ class NetEqPerformanceTest {
   //   |drift_factor|: clock drift in [0, 1].
   // Returns the runtime in ms.
   static int64_t Run(int runtime_ms, int lossrate, double drift_factor);
+
+  // Average time in microseconds spent in one call to each of the DSP
+  // operations that NetEq runs on packet loss and clock drift.
+  struct OperationCosts {
+    double expand_us = 0.0;
+    double merge_us = 0.0;
+    double accelerate_us = 0.0;
+  };
+
+  // Runs the first expansion after a loss, the merge that follows it and an
+  // accelerate operation |num_calls| times each, on 30 ms blocks of 32 kHz
+  // speech. Returns the cost of each operation, or nothing on error.
+  static rtc::Optional<OperationCosts> RunOperations(int num_calls);
+
+  // Inserts |num_packets| 20 ms packets into a PacketBuffer and extracts them
+  // again, keeping a few packets in the buffer like a jitter buffer would. If
+  // |reorder| is true, every fifth packet arrives after the one following it.
+  // Returns the average time in nanoseconds spent on one packet.
+  static double RunPacketBuffer(int num_packets, bool reorder);
 };
 
 }  // namespace test
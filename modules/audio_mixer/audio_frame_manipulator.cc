@@ -9,7 +9,12 @@
  */
 
 #include "modules/audio_mixer/audio_frame_manipulator.h"
+
+#include <array>
+
+#include "api/array_view.h"
 #include "audio/utility/audio_frame_operations.h"
+#include "modules/audio_mixer/mixing_kernels.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -19,14 +24,11 @@ uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame) {
     return 0;
   }
 
-  uint32_t energy = 0;
-  const int16_t* frame_data = audio_frame.data();
-  for (size_t position = 0; position < audio_frame.samples_per_channel_;
-       position++) {
-    // TODO(aleloi): This can overflow. Convert to floats.
-    energy += frame_data[position] * frame_data[position];
-  }
-  return energy;
+  // TODO(aleloi): This can overflow. Convert to floats.
+  return SumOfSquaresS16(DetectMixingOptimization(),
+                         rtc::ArrayView<const int16_t>(
+                             audio_frame.data(),
+                             audio_frame.samples_per_channel_));
 }
 
 void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
@@ -39,17 +41,25 @@ void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
 
   size_t samples = audio_frame->samples_per_channel_;
   RTC_DCHECK_LT(0, samples);
+  const size_t num_channels = audio_frame->num_channels_;
+  RTC_DCHECK_LE(samples * num_channels, AudioFrame::kMaxDataSizeSamples);
   float increment = (target_gain - start_gain) / samples;
   float gain = start_gain;
-  int16_t* frame_data = audio_frame->mutable_data();
+  // The gains are accumulated sample by sample so that they are exactly the
+  // same as when applied one sample at a time.
+  std::array<float, AudioFrame::kMaxDataSizeSamples> gains;
   for (size_t i = 0; i < samples; ++i) {
     // If the audio is interleaved of several channels, we want to
     // apply the same gain change to the ith sample of every channel.
-    for (size_t ch = 0; ch < audio_frame->num_channels_; ++ch) {
-      frame_data[audio_frame->num_channels_ * i + ch] *= gain;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      gains[num_channels * i + ch] = gain;
     }
     gain += increment;
   }
+  ApplyGainsS16(DetectMixingOptimization(),
+                rtc::ArrayView<const float>(&gains[0], samples * num_channels),
+                rtc::ArrayView<int16_t>(audio_frame->mutable_data(),
+                                        samples * num_channels));
 }
 
 void RemixFrame(size_t target_number_of_channels, AudioFrame* frame) {
@@ -150,6 +150,42 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   return;
 }
 
+void AudioMixerImpl::MixMinus(size_t number_of_channels,
+                              AudioFrame* audio_frame_for_mixing,
+                              std::vector<MixMinusFrame>* mix_minus_frames) {
+  RTC_DCHECK(number_of_channels == 1 || number_of_channels == 2);
+  RTC_DCHECK(mix_minus_frames);
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+
+  CalculateOutputFrequency();
+
+  rtc::CritScope lock(&crit_);
+  const size_t number_of_streams = audio_source_list_.size();
+  const AudioFrameList mix_list = GetAudioFromSources();
+  UpdateMixMinusIndices();
+
+  std::vector<size_t> mix_minus_indices;
+  std::vector<AudioFrame*> output_frames;
+  mix_minus_frames->clear();
+  for (AudioFrame* frame : mix_list) {
+    const auto iter = std::find_if(
+        audio_source_list_.begin(), audio_source_list_.end(),
+        [frame](const std::unique_ptr<SourceStatus>& p) {
+          return &p->audio_frame == frame;
+        });
+    RTC_DCHECK(iter != audio_source_list_.end());
+    const size_t index = *(*iter)->mix_minus_index;
+    mix_minus_indices.push_back(index);
+    output_frames.push_back(&mix_minus_frames_[index]);
+    mix_minus_frames->push_back({(*iter)->audio_source, output_frames.back()});
+  }
+
+  frame_combiner_.CombineMixMinus(mix_list, mix_minus_indices,
+                                  number_of_channels, OutputFrequency(),
+                                  number_of_streams, audio_frame_for_mixing,
+                                  output_frames);
+}
+
 void AudioMixerImpl::CalculateOutputFrequency() {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   rtc::CritScope lock(&crit_);
@@ -238,6 +274,28 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   return result;
 }
 
+void AudioMixerImpl::UpdateMixMinusIndices() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  std::array<bool, kMaximumAmountOfMixedAudioSources> in_use{};
+  for (auto& source_and_status : audio_source_list_) {
+    if (!source_and_status->is_mixed) {
+      source_and_status->mix_minus_index = rtc::nullopt;
+    } else if (source_and_status->mix_minus_index) {
+      in_use[*source_and_status->mix_minus_index] = true;
+    }
+  }
+  for (auto& source_and_status : audio_source_list_) {
+    if (!source_and_status->is_mixed || source_and_status->mix_minus_index) {
+      continue;
+    }
+    const auto free_index = std::find(in_use.begin(), in_use.end(), false);
+    RTC_DCHECK(free_index != in_use.end());
+    *free_index = true;
+    source_and_status->mix_minus_index =
+        static_cast<size_t>(std::distance(in_use.begin(), free_index));
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
@@ -11,10 +11,12 @@
 #ifndef MODULES_AUDIO_MIXER_AUDIO_MIXER_IMPL_H_
 #define MODULES_AUDIO_MIXER_AUDIO_MIXER_IMPL_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 
 #include "api/audio/audio_mixer.h"
+#include "api/optional.h"
 #include "modules/audio_mixer/frame_combiner.h"
 #include "modules/audio_mixer/output_rate_calculator.h"
 #include "modules/audio_processing/include/audio_processing.h"
@@ -35,11 +37,20 @@ class AudioMixerImpl : public AudioMixer {
     Source* audio_source = nullptr;
     bool is_mixed = false;
     float gain = 0.0f;
+    // While the source is mixed by MixMinus(), selects the limiter and the
+    // frame for the mix of all other sources.
+    rtc::Optional<size_t> mix_minus_index;
 
     // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
     AudioFrame audio_frame;
   };
 
+  struct MixMinusFrame {
+    Source* audio_source;
+    // The mix of all mixed sources except |audio_source|.
+    const AudioFrame* audio_frame;
+  };
+
   using SourceStatusList = std::vector<std::unique_ptr<SourceStatus>>;
 
   // AudioProcessing only accepts 10 ms frames.
@@ -64,6 +75,18 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(crit_);
 
+  // Mixing for conferences, where every participant is also a source of the
+  // mixer and should not hear itself. Pulls audio from every source once,
+  // like Mix(), and writes the mix to |audio_frame_for_mixing|. This is what
+  // every participant whose source was not mixed should hear. For each source
+  // that was mixed, adds to |mix_minus_frames| the mix of all the other
+  // sources. Those frames are owned by the mixer and stay valid until the
+  // next call to MixMinus().
+  void MixMinus(size_t number_of_channels,
+                AudioFrame* audio_frame_for_mixing,
+                std::vector<MixMinusFrame>* mix_minus_frames)
+      RTC_LOCKS_EXCLUDED(crit_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
@@ -84,6 +107,10 @@ class AudioMixerImpl : public AudioMixer {
   // kMaximumAmountOfMixedAudioSources audio sources.
   AudioFrameList GetAudioFromSources() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Gives every mixed source a mix-minus index, keeping the index of sources
+  // that were already mixed, and takes it away from the other sources.
+  void UpdateMixMinusIndices() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Add/remove the MixerAudioSource to the specified
   // MixerAudioSource list.
   bool AddAudioSourceToList(Source* audio_source,
@@ -108,6 +135,10 @@ class AudioMixerImpl : public AudioMixer {
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
 
+  // The outputs of MixMinus(), indexed by SourceStatus::mix_minus_index.
+  std::array<AudioFrame, kMaximumAmountOfMixedAudioSources> mix_minus_frames_
+      RTC_GUARDED_BY(race_checker_);
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
 }  // namespace webrtc
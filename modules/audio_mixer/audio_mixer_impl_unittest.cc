@@ -10,6 +10,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -531,4 +532,67 @@ TEST(AudioMixer, AnyRateIsPossibleWithNoLimiter) {
     }
   }
 }
+
+TEST(AudioMixer, MixMinusPullsEachSourceOnceAndLeavesOutOwnAudio) {
+  constexpr int kAudioSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 2;
+  const auto mixer = AudioMixerImpl::Create(
+      std::unique_ptr<OutputRateCalculator>(new DefaultOutputRateCalculator()),
+      false);
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    // Constant frames, with a higher energy for every participant.
+    int16_t* const data = participants[i].fake_frame()->mutable_data();
+    std::fill(data, data + participants[i].fake_frame()->samples_per_channel_,
+              100 * (i + 1));
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(kDefaultSampleRateHz, _))
+        .Times(Exactly(2));
+  }
+
+  // The first round ramps in the mixed sources.
+  std::vector<AudioMixerImpl::MixMinusFrame> mix_minus_frames;
+  mixer->MixMinus(1, &frame_for_mixing, &mix_minus_frames);
+  mixer->MixMinus(1, &frame_for_mixing, &mix_minus_frames);
+
+  // The loudest participants are mixed.
+  const int16_t kFullMix = 300 + 400 + 500;
+  EXPECT_EQ(kFullMix, frame_for_mixing.data()[0]);
+  EXPECT_EQ(kFullMix, frame_for_mixing.data()[kDefaultSampleRateHz / 100 - 1]);
+  ASSERT_EQ(
+      static_cast<size_t>(AudioMixerImpl::kMaximumAmountOfMixedAudioSources),
+      mix_minus_frames.size());
+  for (const auto& mix_minus_frame : mix_minus_frames) {
+    const int i = static_cast<int>(
+        static_cast<MockMixerAudioSource*>(mix_minus_frame.audio_source) -
+        participants);
+    ASSERT_GE(i,
+              kAudioSources - AudioMixerImpl::kMaximumAmountOfMixedAudioSources);
+    ASSERT_LT(i, kAudioSources);
+    SCOPED_TRACE(i);
+    const AudioFrame& frame = *mix_minus_frame.audio_frame;
+    EXPECT_EQ(frame_for_mixing.samples_per_channel_,
+              frame.samples_per_channel_);
+    EXPECT_EQ(kFullMix - 100 * (i + 1), frame.data()[0]);
+    EXPECT_EQ(kFullMix - 100 * (i + 1),
+              frame.data()[frame.samples_per_channel_ - 1]);
+  }
+}
+
+TEST(AudioMixer, MixMinusOfSingleSourceIsSilent) {
+  const auto mixer = AudioMixerImpl::Create();
+  MockMixerAudioSource participant;
+  ResetFrame(participant.fake_frame());
+  participant.fake_frame()->mutable_data()[10] = 1000;
+  EXPECT_TRUE(mixer->AddSource(&participant));
+
+  std::vector<AudioMixerImpl::MixMinusFrame> mix_minus_frames;
+  mixer->MixMinus(1, &frame_for_mixing, &mix_minus_frames);
+
+  ASSERT_EQ(1u, mix_minus_frames.size());
+  EXPECT_EQ(&participant, mix_minus_frames[0].audio_source);
+  EXPECT_TRUE(mix_minus_frames[0].audio_frame->muted());
+}
 }  // namespace webrtc
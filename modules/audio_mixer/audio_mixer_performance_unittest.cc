@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_mixer/mixing_kernels.h"
+#include "modules/audio_mixer/sine_wave_generator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+constexpr int kNumFramesToProcess = 1000;
+
+std::string OptimizationName(MixingOptimization optimization) {
+  switch (optimization) {
+    case MixingOptimization::kSse2:
+      return "sse2";
+    case MixingOptimization::kNeon:
+      return "neon";
+    default:
+      return "c";
+  }
+}
+
+// Returns the optimizations that can be run on the current CPU.
+std::vector<MixingOptimization> AvailableOptimizations() {
+  std::vector<MixingOptimization> optimizations = {MixingOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(MixingOptimization::kSse2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(MixingOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
+// A source that repeats 10 ms of a sine wave, with a different frequency for
+// every source. The frame is generated once, so that the benchmarks measure
+// the mixer rather than the source.
+class SineWaveSource : public AudioMixer::Source {
+ public:
+  SineWaveSource(int ssrc, size_t num_channels) : ssrc_(ssrc) {
+    frame_.UpdateFrame(0, nullptr, kSamplesPerChannel, kSampleRateHz,
+                       AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                       num_channels);
+    SineWaveGenerator(100.f + 10.f * ssrc, 1000).GenerateNextFrame(&frame_);
+  }
+
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
+                                       AudioFrame* audio_frame) override {
+    RTC_DCHECK_EQ(kSampleRateHz, sample_rate_hz);
+    audio_frame->CopyFrom(frame_);
+    return AudioFrameInfo::kNormal;
+  }
+
+  int Ssrc() const override { return ssrc_; }
+  int PreferredSampleRate() const override { return kSampleRateHz; }
+
+ private:
+  const int ssrc_;
+  AudioFrame frame_;
+};
+
+void RunMixerBenchmark(size_t num_sources, size_t num_channels) {
+  rtc::scoped_refptr<AudioMixerImpl> mixer = AudioMixerImpl::Create();
+  std::vector<std::unique_ptr<SineWaveSource>> sources;
+  for (size_t i = 0; i < num_sources; ++i) {
+    sources.emplace_back(new SineWaveSource(static_cast<int>(i), num_channels));
+    mixer->AddSource(sources.back().get());
+  }
+
+  AudioFrame frame;
+  const int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumFramesToProcess; ++i) {
+    mixer->Mix(num_channels, &frame);
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+  for (const auto& source : sources) {
+    mixer->RemoveSource(source.get());
+  }
+  test::PrintResult(
+      "audio_mixer_mix_time",
+      "_" + std::to_string(num_sources) + "_sources_" +
+          std::to_string(num_channels) + "_channels",
+      OptimizationName(DetectMixingOptimization()),
+      static_cast<double>(elapsed_us) / kNumFramesToProcess, "us", false);
+}
+
+// Mixes a conference in which every participant hears everyone but itself,
+// either with MixMinus() on one mixer, or with one mixer per participant that
+// has all other participants as sources.
+void RunConferenceBenchmark(size_t num_participants, bool use_mix_minus) {
+  std::vector<std::unique_ptr<SineWaveSource>> sources;
+  for (size_t i = 0; i < num_participants; ++i) {
+    sources.emplace_back(new SineWaveSource(static_cast<int>(i), 1));
+  }
+  std::vector<rtc::scoped_refptr<AudioMixerImpl>> mixers(
+      use_mix_minus ? 1 : num_participants);
+  for (size_t i = 0; i < mixers.size(); ++i) {
+    mixers[i] = AudioMixerImpl::Create();
+    for (size_t j = 0; j < num_participants; ++j) {
+      if (use_mix_minus || i != j) {
+        mixers[i]->AddSource(sources[j].get());
+      }
+    }
+  }
+
+  // Mixing with a mixer per participant is quadratic in the number of
+  // participants, so fewer frames are timed.
+  const int num_frames =
+      use_mix_minus ? kNumFramesToProcess : kNumFramesToProcess / 100;
+  AudioFrame frame;
+  std::vector<AudioMixerImpl::MixMinusFrame> mix_minus_frames;
+  const int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < num_frames; ++i) {
+    if (use_mix_minus) {
+      mixers[0]->MixMinus(1, &frame, &mix_minus_frames);
+    } else {
+      for (auto& mixer : mixers) {
+        mixer->Mix(1, &frame);
+      }
+    }
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+  for (size_t i = 0; i < mixers.size(); ++i) {
+    for (size_t j = 0; j < num_participants; ++j) {
+      if (use_mix_minus || i != j) {
+        mixers[i]->RemoveSource(sources[j].get());
+      }
+    }
+  }
+  test::PrintResult("audio_mixer_conference_time",
+                    use_mix_minus ? "_mix_minus" : "_mixer_per_participant",
+                    std::to_string(num_participants) + "_participants",
+                    static_cast<double>(elapsed_us) / num_frames, "us", false);
+}
+
+void PrintKernelTime(const std::string& kernel,
+                     const std::string& optimization_name,
+                     int64_t elapsed_us) {
+  test::PrintResult("audio_mixer_kernel_time", kernel, optimization_name,
+                    static_cast<double>(elapsed_us) / kNumFramesToProcess,
+                    "us", false);
+}
+
+}  // namespace
+
+// Measures the time spent per 10 ms frame mixing many sources at 48 kHz. All
+// sources are active, so the mixer picks the loudest ones and ramps the
+// others out.
+TEST(AudioMixerPerformance, MixManySources) {
+  for (size_t num_channels : {1, 2}) {
+    for (size_t num_sources : {3, 10, 100}) {
+      RunMixerBenchmark(num_sources, num_channels);
+    }
+  }
+}
+
+// Measures the time spent per 10 ms frame giving every participant of a
+// conference a mix without its own audio. Using one mixer per participant
+// pulls audio from every source once per participant, so it is only run for
+// the smaller conferences.
+TEST(AudioMixerPerformance, Conference) {
+  for (size_t num_participants : {50, 200, 1000}) {
+    RunConferenceBenchmark(num_participants, true);
+    if (num_participants <= 200) {
+      RunConferenceBenchmark(num_participants, false);
+    }
+  }
+}
+
+// Measures the time spent in the mixing kernels on one 10 ms stereo frame at
+// 48 kHz, for each optimization supported by the CPU.
+TEST(AudioMixerPerformance, MixingKernels) {
+  constexpr size_t kSize = 2 * kSamplesPerChannel;
+  Random random(42U);
+  std::vector<int16_t> x(kSize);
+  for (auto& x_k : x) {
+    x_k = random.Rand<int16_t>();
+  }
+  std::vector<float> y(kSize, 0.f);
+  std::vector<float> gains(kSize, 0.5f);
+  std::vector<int16_t> z(kSize);
+
+  for (MixingOptimization optimization : AvailableOptimizations()) {
+    SCOPED_TRACE(OptimizationName(optimization));
+    const std::string name = OptimizationName(optimization);
+
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFramesToProcess; ++i) {
+      AccumulateS16(optimization, x, y);
+    }
+    PrintKernelTime("_accumulate", name, rtc::TimeMicros() - start_us);
+
+    start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFramesToProcess; ++i) {
+      ConvertFloatS16ToS16(optimization, y, z);
+    }
+    PrintKernelTime("_convert", name, rtc::TimeMicros() - start_us);
+
+    start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFramesToProcess; ++i) {
+      ApplyGainsS16(optimization, gains, z);
+    }
+    PrintKernelTime("_apply_gains", name, rtc::TimeMicros() - start_us);
+
+    uint32_t energy = 0;
+    start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFramesToProcess; ++i) {
+      energy += SumOfSquaresS16(optimization, x);
+    }
+    PrintKernelTime("_energy", name, rtc::TimeMicros() - start_us);
+    // Keeps the energy computation from being optimized away.
+    EXPECT_NE(0u, energy);
+  }
+}
+
+}  // namespace webrtc
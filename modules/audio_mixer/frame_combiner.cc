@@ -19,6 +19,7 @@
 #include "common_audio/include/audio_util.h"
 #include "modules/audio_mixer/audio_frame_manipulator.h"
 #include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_mixer/mixing_kernels.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
@@ -103,17 +104,35 @@ void MixFewFramesWithNoLimiter(const std::vector<AudioFrame*>& mix_list,
 std::array<OneChannelBuffer, kMaximumAmountOfChannels> MixToFloatFrame(
     const std::vector<AudioFrame*>& mix_list,
     size_t samples_per_channel,
-    size_t number_of_channels) {
+    size_t number_of_channels,
+    MixingOptimization optimization) {
   // Convert to FloatS16 and mix.
   using OneChannelBuffer = std::array<float, kMaximumChannelSize>;
   std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer{};
 
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < number_of_channels; ++j) {
-      for (size_t k = 0; k < samples_per_channel; ++k) {
-        mixing_buffer[j][k] += frame->data()[number_of_channels * k + j];
-      }
+  if (number_of_channels == 1) {
+    for (const AudioFrame* const frame : mix_list) {
+      AccumulateS16(
+          optimization,
+          rtc::ArrayView<const int16_t>(frame->data(), samples_per_channel),
+          rtc::ArrayView<float>(&mixing_buffer[0][0], samples_per_channel));
+    }
+    return mixing_buffer;
+  }
+
+  // Mix the interleaved samples and deinterleave the sum once, instead of
+  // deinterleaving every frame.
+  const size_t num_samples = samples_per_channel * number_of_channels;
+  std::array<float, kMaximumAmountOfChannels * kMaximumChannelSize>
+      interleaved_buffer{};
+  for (const AudioFrame* const frame : mix_list) {
+    AccumulateS16(optimization,
+                  rtc::ArrayView<const int16_t>(frame->data(), num_samples),
+                  rtc::ArrayView<float>(&interleaved_buffer[0], num_samples));
+  }
+  for (size_t j = 0; j < number_of_channels; ++j) {
+    for (size_t k = 0; k < samples_per_channel; ++k) {
+      mixing_buffer[j][k] = interleaved_buffer[number_of_channels * k + j];
     }
   }
   return mixing_buffer;
@@ -169,16 +188,59 @@ void RunApmAgc2Limiter(AudioFrameView<float> mixing_buffer_view,
 
 // Both interleaves and rounds.
 void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
+                            MixingOptimization optimization,
                             AudioFrame* audio_frame_for_mixing) {
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
+  const size_t num_samples = number_of_channels * samples_per_channel;
+  rtc::ArrayView<int16_t> output(audio_frame_for_mixing->mutable_data(),
+                                 num_samples);
+  if (number_of_channels == 1) {
+    ConvertFloatS16ToS16(optimization, mixing_buffer_view.channel(0), output);
+    return;
+  }
+
   // Put data in the result frame.
+  std::array<float, kMaximumAmountOfChannels * kMaximumChannelSize>
+      interleaved_buffer;
   for (size_t i = 0; i < number_of_channels; ++i) {
     for (size_t j = 0; j < samples_per_channel; ++j) {
-      audio_frame_for_mixing->mutable_data()[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
+      interleaved_buffer[number_of_channels * j + i] =
+          mixing_buffer_view.channel(i)[j];
     }
   }
+  ConvertFloatS16ToS16(
+      optimization,
+      rtc::ArrayView<const float>(&interleaved_buffer[0], num_samples),
+      output);
+}
+
+// Limits the mix, in place, and writes it to |audio_frame_for_mixing|.
+void LimitAndInterleave(
+    FrameCombiner::LimiterType limiter_type,
+    AudioProcessing* apm_agc_limiter,
+    FixedGainController* apm_agc2_limiter,
+    MixingOptimization optimization,
+    size_t number_of_channels,
+    size_t samples_per_channel,
+    std::array<OneChannelBuffer, kMaximumAmountOfChannels>* mixing_buffer,
+    AudioFrame* audio_frame_for_mixing) {
+  // Put float data in an AudioFrameView.
+  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
+  for (size_t i = 0; i < number_of_channels; ++i) {
+    channel_pointers[i] = &(*mixing_buffer)[i][0];
+  }
+  AudioFrameView<float> mixing_buffer_view(
+      &channel_pointers[0], number_of_channels, samples_per_channel);
+
+  if (limiter_type == FrameCombiner::LimiterType::kApmAgcLimiter) {
+    RunApmAgcLimiter(mixing_buffer_view, apm_agc_limiter);
+  } else if (limiter_type == FrameCombiner::LimiterType::kApmAgc2Limiter) {
+    RunApmAgc2Limiter(mixing_buffer_view, apm_agc2_limiter);
+  }
+
+  InterleaveToAudioFrame(mixing_buffer_view, optimization,
+                         audio_frame_for_mixing);
 }
 }  // namespace
 
@@ -188,7 +250,8 @@ FrameCombiner::FrameCombiner(LimiterType limiter_type)
                            ? CreateLimiter()
                            : nullptr),
       data_dumper_(new ApmDataDumper(0)),
-      apm_agc2_limiter_(data_dumper_.get()) {
+      apm_agc2_limiter_(data_dumper_.get()),
+      optimization_(DetectMixingOptimization()) {
   apm_agc2_limiter_.SetGain(0.f);
 }
 
@@ -240,23 +303,112 @@ void FrameCombiner::Combine(const std::vector<AudioFrame*>& mix_list,
   }
 
   std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer =
-      MixToFloatFrame(mix_list, samples_per_channel, number_of_channels);
+      MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
+                      optimization_);
+  LimitAndInterleave(limiter_type_, apm_agc_limiter_.get(), &apm_agc2_limiter_,
+                     optimization_, number_of_channels, samples_per_channel,
+                     &mixing_buffer, audio_frame_for_mixing);
+}
 
-  // Put float data in an AudioFrameView.
-  std::array<float*, kMaximumAmountOfChannels> channel_pointers{};
-  for (size_t i = 0; i < number_of_channels; ++i) {
-    channel_pointers[i] = &mixing_buffer[i][0];
+void FrameCombiner::CombineMixMinus(
+    const std::vector<AudioFrame*>& mix_list,
+    rtc::ArrayView<const size_t> mix_minus_limiters,
+    size_t number_of_channels,
+    int sample_rate,
+    size_t number_of_streams,
+    AudioFrame* audio_frame_for_mixing,
+    rtc::ArrayView<AudioFrame* const> mix_minus_frames) {
+  RTC_DCHECK(audio_frame_for_mixing);
+  RTC_DCHECK_EQ(mix_list.size(), mix_minus_limiters.size());
+  RTC_DCHECK_EQ(mix_list.size(), mix_minus_frames.size());
+  RTC_DCHECK_LE(mix_list.size(), number_of_streams);
+
+  LogMixingStats(mix_list, sample_rate, number_of_streams);
+
+  SetAudioFrameFields(mix_list, number_of_channels, sample_rate,
+                      number_of_streams, audio_frame_for_mixing);
+
+  const size_t samples_per_channel = static_cast<size_t>(
+      (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
+
+  for (auto* frame : mix_list) {
+    RTC_DCHECK_EQ(samples_per_channel, frame->samples_per_channel_);
+    RTC_DCHECK_EQ(sample_rate, frame->sample_rate_hz_);
+    RemixFrame(number_of_channels, frame);
   }
-  AudioFrameView<float> mixing_buffer_view(
-      &channel_pointers[0], number_of_channels, samples_per_channel);
 
-  if (limiter_type_ == LimiterType::kApmAgcLimiter) {
-    RunApmAgcLimiter(mixing_buffer_view, apm_agc_limiter_.get());
-  } else if (limiter_type_ == LimiterType::kApmAgc2Limiter) {
-    RunApmAgc2Limiter(mixing_buffer_view, &apm_agc2_limiter_);
+  if (number_of_streams <= 1) {
+    MixFewFramesWithNoLimiter(mix_list, audio_frame_for_mixing);
+    for (AudioFrame* mix_minus_frame : mix_minus_frames) {
+      SetAudioFrameFields({}, number_of_channels, sample_rate, 0,
+                          mix_minus_frame);
+      mix_minus_frame->Mute();
+    }
+    return;
   }
 
-  InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
+  // The frames are summed once. Since the samples are integers, the sum of a
+  // few frames is exact, and subtracting a frame from it gives exactly what
+  // mixing the other frames would.
+  const std::array<OneChannelBuffer, kMaximumAmountOfChannels> sum =
+      MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
+                      optimization_);
+
+  std::array<OneChannelBuffer, kMaximumAmountOfChannels> mixing_buffer = sum;
+  LimitAndInterleave(limiter_type_, apm_agc_limiter_.get(), &apm_agc2_limiter_,
+                     optimization_, number_of_channels, samples_per_channel,
+                     &mixing_buffer, audio_frame_for_mixing);
+
+  std::vector<AudioFrame*> other_frames;
+  for (size_t i = 0; i < mix_list.size(); ++i) {
+    AudioFrame* const mix_minus_frame = mix_minus_frames[i];
+    RTC_DCHECK(mix_minus_frame);
+    other_frames = mix_list;
+    other_frames.erase(other_frames.begin() + i);
+    SetAudioFrameFields(other_frames, number_of_channels, sample_rate,
+                        number_of_streams - 1, mix_minus_frame);
+    if (number_of_streams - 1 <= 1) {
+      MixFewFramesWithNoLimiter(other_frames, mix_minus_frame);
+      continue;
+    }
+
+    mixing_buffer = sum;
+    const int16_t* const frame_data = mix_list[i]->data();
+    for (size_t j = 0; j < number_of_channels; ++j) {
+      for (size_t k = 0; k < samples_per_channel; ++k) {
+        mixing_buffer[j][k] -= frame_data[number_of_channels * k + j];
+      }
+    }
+
+    const size_t limiter_index = mix_minus_limiters[i];
+    CreateMixMinusLimiters(limiter_index + 1);
+    LimitAndInterleave(limiter_type_,
+                       limiter_type_ == LimiterType::kApmAgcLimiter
+                           ? mix_minus_apm_agc_limiters_[limiter_index].get()
+                           : nullptr,
+                       mix_minus_apm_agc2_limiters_[limiter_index].get(),
+                       optimization_, number_of_channels, samples_per_channel,
+                       &mixing_buffer, mix_minus_frame);
+  }
+}
+
+void FrameCombiner::CreateMixMinusLimiters(size_t number_of_limiters) {
+  while (mix_minus_apm_agc2_limiters_.size() < number_of_limiters) {
+    mix_minus_apm_agc2_limiters_.emplace_back(
+        new FixedGainController(data_dumper_.get()));
+    mix_minus_apm_agc2_limiters_.back()->SetGain(0.f);
+  }
+  if (limiter_type_ != LimiterType::kApmAgcLimiter) {
+    return;
+  }
+  if (mix_minus_apm_agc_limiters_.size() < number_of_limiters) {
+    mix_minus_apm_agc_limiters_.resize(number_of_limiters);
+  }
+  for (auto& limiter : mix_minus_apm_agc_limiters_) {
+    if (!limiter) {
+      limiter = CreateLimiter();
+    }
+  }
 }
 
 void FrameCombiner::LogMixingStats(const std::vector<AudioFrame*>& mix_list,
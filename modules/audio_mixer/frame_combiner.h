@@ -14,6 +14,8 @@
 #include <memory>
 #include <vector>
 
+#include "api/array_view.h"
+#include "modules/audio_mixer/mixing_kernels.h"
 #include "modules/audio_processing/agc2/fixed_gain_controller.h"
 #include "modules/audio_processing/include/audio_processing.h"
 
@@ -42,7 +44,25 @@ class FrameCombiner {
                size_t number_of_streams,
                AudioFrame* audio_frame_for_mixing);
 
+  // Combines |mix_list| into |audio_frame_for_mixing| like Combine(), and in
+  // addition writes the combination of all frames except mix_list[i] to
+  // mix_minus_frames[i]. The frames are only summed once. Each mix-minus
+  // output is limited separately, by the limiter that mix_minus_limiters[i]
+  // selects, so that a caller can keep the limiter state of an output while
+  // the frames in |mix_list| change.
+  void CombineMixMinus(const std::vector<AudioFrame*>& mix_list,
+                       rtc::ArrayView<const size_t> mix_minus_limiters,
+                       size_t number_of_channels,
+                       int sample_rate,
+                       size_t number_of_streams,
+                       AudioFrame* audio_frame_for_mixing,
+                       rtc::ArrayView<AudioFrame* const> mix_minus_frames);
+
  private:
+  // Makes sure that there are at least |number_of_limiters| mix-minus
+  // limiters of the current limiter type.
+  void CreateMixMinusLimiters(size_t number_of_limiters);
+
   void LogMixingStats(const std::vector<AudioFrame*>& mix_list,
                       int sample_rate,
                       size_t number_of_streams) const;
@@ -51,6 +71,11 @@ class FrameCombiner {
   std::unique_ptr<AudioProcessing> apm_agc_limiter_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   FixedGainController apm_agc2_limiter_;
+  const MixingOptimization optimization_;
+  // Created when first used by CombineMixMinus().
+  std::vector<std::unique_ptr<AudioProcessing>> mix_minus_apm_agc_limiters_;
+  std::vector<std::unique_ptr<FixedGainController>>
+      mix_minus_apm_agc2_limiters_;
   mutable int uma_logging_counter_ = 0;
 };
 }  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "modules/audio_mixer/frame_combiner.h"
 
+#include <algorithm>
+#include <memory>
 #include <numeric>
 #include <sstream>
 #include <string>
@@ -221,4 +223,84 @@ TEST(FrameCombiner, GainCurveIsSmoothForAlternatingNumberOfStreams) {
     EXPECT_LT(change_calculator.LatestGain(), 1.01f);
   }
 }
+
+// The mix-minus outputs should be the same as what separate combiners
+// produce from all frames but one.
+TEST(FrameCombiner, MixMinusMatchesCombiningTheOtherFrames) {
+  constexpr int kRate = 48000;
+  constexpr size_t kNumFrames = 3;
+  for (const auto limiter_type :
+       {LimiterType::kNoLimiter, LimiterType::kApmAgcLimiter,
+        LimiterType::kApmAgc2Limiter}) {
+    for (const int number_of_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(kRate, number_of_channels, kNumFrames));
+      FrameCombiner combiner(limiter_type);
+      FrameCombiner reference_combiner(limiter_type);
+      std::vector<std::unique_ptr<FrameCombiner>> reference_mix_minus_combiners;
+      // Loud enough for the limiters to kick in.
+      std::vector<SineWaveGenerator> generators = {
+          {100.f, 12000}, {330.f, 14000}, {1000.f, 16000}};
+      std::vector<AudioFrame> frames(kNumFrames);
+      std::vector<AudioFrame> mix_minus_frames(kNumFrames);
+      std::vector<AudioFrame*> mix_list;
+      std::vector<AudioFrame*> mix_minus_frame_pointers;
+      for (size_t i = 0; i < kNumFrames; ++i) {
+        reference_mix_minus_combiners.emplace_back(
+            new FrameCombiner(limiter_type));
+        mix_list.push_back(&frames[i]);
+        mix_minus_frame_pointers.push_back(&mix_minus_frames[i]);
+      }
+      const std::vector<size_t> mix_minus_limiters = {0, 1, 2};
+
+      for (int j = 0; j < 20; ++j) {
+        for (size_t i = 0; i < kNumFrames; ++i) {
+          frames[i].UpdateFrame(0, nullptr, kRate / 100, kRate,
+                                AudioFrame::kNormalSpeech,
+                                AudioFrame::kVadActive, number_of_channels);
+          generators[i].GenerateNextFrame(&frames[i]);
+        }
+        combiner.CombineMixMinus(mix_list, mix_minus_limiters,
+                                 number_of_channels, kRate, kNumFrames,
+                                 &audio_frame_for_mixing,
+                                 mix_minus_frame_pointers);
+
+        const size_t num_samples = number_of_channels * kRate / 100;
+        AudioFrame reference;
+        reference_combiner.Combine(mix_list, number_of_channels, kRate,
+                                   kNumFrames, &reference);
+        EXPECT_TRUE(std::equal(reference.data(),
+                               reference.data() + num_samples,
+                               audio_frame_for_mixing.data()));
+        for (size_t i = 0; i < kNumFrames; ++i) {
+          std::vector<AudioFrame*> other_frames = mix_list;
+          other_frames.erase(other_frames.begin() + i);
+          reference_mix_minus_combiners[i]->Combine(
+              other_frames, number_of_channels, kRate, kNumFrames - 1,
+              &reference);
+          EXPECT_TRUE(std::equal(reference.data(),
+                                 reference.data() + num_samples,
+                                 mix_minus_frames[i].data()));
+        }
+      }
+    }
+  }
+}
+
+TEST(FrameCombiner, MixMinusOfTwoStreamsIsTheOtherFrame) {
+  FrameCombiner combiner(LimiterType::kApmAgc2Limiter);
+  constexpr int kRate = 16000;
+  SetUpFrames(kRate, 1);
+  std::fill(frame1.mutable_data(), frame1.mutable_data() + kRate / 100, 1000);
+  std::fill(frame2.mutable_data(), frame2.mutable_data() + kRate / 100, -2000);
+
+  AudioFrame mix_minus_frame1;
+  AudioFrame mix_minus_frame2;
+  const std::vector<size_t> mix_minus_limiters = {0, 1};
+  const std::vector<AudioFrame*> mix_minus_frames = {&mix_minus_frame1,
+                                                     &mix_minus_frame2};
+  combiner.CombineMixMinus({&frame1, &frame2}, mix_minus_limiters, 1, kRate, 2,
+                           &audio_frame_for_mixing, mix_minus_frames);
+  EXPECT_EQ(-2000, mix_minus_frame1.data()[0]);
+  EXPECT_EQ(1000, mix_minus_frame2.data()[0]);
+}
 }  // namespace webrtc
@@ -0,0 +1,268 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mixing_kernels.h"
+
+#include "typedefs.h"  // NOLINT(build/include)
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+MixingOptimization ProbeCpu() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return MixingOptimization::kSse2;
+  }
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+  return MixingOptimization::kNeon;
+#endif
+
+  return MixingOptimization::kNone;
+}
+
+int16_t TruncateAndSaturate(float v) {
+  v = std::min(v, static_cast<float>(std::numeric_limits<int16_t>::max()));
+  v = std::max(v, static_cast<float>(std::numeric_limits<int16_t>::min()));
+  return static_cast<int16_t>(v);
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Sign-extends the lower and upper four int16 samples of |x| to float.
+__m128 LowS16ToFloat(__m128i x) {
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+}
+
+__m128 HighS16ToFloat(__m128i x) {
+  return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+}
+
+// Rounds half away from zero. Values that are out of the int16 range are
+// clamped first so that the conversion to int32 is exact, and then saturated
+// when packing.
+__m128i RoundFloatS16(__m128 x) {
+  const __m128 kLimit = _mm_set1_ps(65536.f);
+  const __m128 kHalf = _mm_set1_ps(0.5f);
+  const __m128 kMinusHalf = _mm_set1_ps(-0.5f);
+  x = _mm_max_ps(_mm_min_ps(x, kLimit), _mm_sub_ps(_mm_setzero_ps(), kLimit));
+  const __m128 positive = _mm_cmpgt_ps(x, _mm_setzero_ps());
+  const __m128 offset = _mm_or_ps(_mm_and_ps(positive, kHalf),
+                                  _mm_andnot_ps(positive, kMinusHalf));
+  return _mm_cvttps_epi32(_mm_add_ps(x, offset));
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+int32x4_t RoundFloatS16(float32x4_t x) {
+  const float32x4_t kLimit = vdupq_n_f32(65536.f);
+  x = vmaxq_f32(vminq_f32(x, kLimit), vnegq_f32(kLimit));
+  const uint32x4_t positive = vcgtq_f32(x, vdupq_n_f32(0.f));
+  const float32x4_t offset =
+      vbslq_f32(positive, vdupq_n_f32(0.5f), vdupq_n_f32(-0.5f));
+  return vcvtq_s32_f32(vaddq_f32(x, offset));
+}
+#endif
+
+}  // namespace
+
+MixingOptimization DetectMixingOptimization() {
+  static const MixingOptimization optimization = ProbeCpu();
+  return optimization;
+}
+
+void AccumulateS16(MixingOptimization optimization,
+                   rtc::ArrayView<const int16_t> src,
+                   rtc::ArrayView<float> dst) {
+  RTC_DCHECK_EQ(src.size(), dst.size());
+  const size_t size = src.size();
+  size_t k = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case MixingOptimization::kSse2:
+      for (; k + 8 <= size; k += 8) {
+        const __m128i x =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[k]));
+        _mm_storeu_ps(&dst[k],
+                      _mm_add_ps(_mm_loadu_ps(&dst[k]), LowS16ToFloat(x)));
+        _mm_storeu_ps(&dst[k + 4],
+                      _mm_add_ps(_mm_loadu_ps(&dst[k + 4]), HighS16ToFloat(x)));
+      }
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case MixingOptimization::kNeon:
+      for (; k + 8 <= size; k += 8) {
+        const int16x8_t x = vld1q_s16(&src[k]);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x)));
+        vst1q_f32(&dst[k], vaddq_f32(vld1q_f32(&dst[k]), low));
+        vst1q_f32(&dst[k + 4], vaddq_f32(vld1q_f32(&dst[k + 4]), high));
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < size; ++k) {
+    dst[k] += src[k];
+  }
+}
+
+void ConvertFloatS16ToS16(MixingOptimization optimization,
+                          rtc::ArrayView<const float> src,
+                          rtc::ArrayView<int16_t> dst) {
+  RTC_DCHECK_EQ(src.size(), dst.size());
+  const size_t size = src.size();
+  size_t k = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case MixingOptimization::kSse2:
+      for (; k + 8 <= size; k += 8) {
+        const __m128i low = RoundFloatS16(_mm_loadu_ps(&src[k]));
+        const __m128i high = RoundFloatS16(_mm_loadu_ps(&src[k + 4]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[k]),
+                         _mm_packs_epi32(low, high));
+      }
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case MixingOptimization::kNeon:
+      for (; k + 8 <= size; k += 8) {
+        const int16x4_t low = vqmovn_s32(RoundFloatS16(vld1q_f32(&src[k])));
+        const int16x4_t high =
+            vqmovn_s32(RoundFloatS16(vld1q_f32(&src[k + 4])));
+        vst1q_s16(&dst[k], vcombine_s16(low, high));
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < size; ++k) {
+    dst[k] = FloatS16ToS16(src[k]);
+  }
+}
+
+void ApplyGainsS16(MixingOptimization optimization,
+                   rtc::ArrayView<const float> gains,
+                   rtc::ArrayView<int16_t> data) {
+  RTC_DCHECK_EQ(gains.size(), data.size());
+  const size_t size = data.size();
+  size_t k = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case MixingOptimization::kSse2: {
+      const __m128 kMax = _mm_set1_ps(std::numeric_limits<int16_t>::max());
+      const __m128 kMin = _mm_set1_ps(std::numeric_limits<int16_t>::min());
+      for (; k + 8 <= size; k += 8) {
+        const __m128i x =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[k]));
+        __m128 low = _mm_mul_ps(LowS16ToFloat(x), _mm_loadu_ps(&gains[k]));
+        __m128 high =
+            _mm_mul_ps(HighS16ToFloat(x), _mm_loadu_ps(&gains[k + 4]));
+        low = _mm_max_ps(_mm_min_ps(low, kMax), kMin);
+        high = _mm_max_ps(_mm_min_ps(high, kMax), kMin);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(&data[k]),
+            _mm_packs_epi32(_mm_cvttps_epi32(low), _mm_cvttps_epi32(high)));
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case MixingOptimization::kNeon: {
+      const float32x4_t kMax = vdupq_n_f32(std::numeric_limits<int16_t>::max());
+      const float32x4_t kMin = vdupq_n_f32(std::numeric_limits<int16_t>::min());
+      for (; k + 8 <= size; k += 8) {
+        const int16x8_t x = vld1q_s16(&data[k]);
+        float32x4_t low = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))),
+                                    vld1q_f32(&gains[k]));
+        float32x4_t high =
+            vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))),
+                      vld1q_f32(&gains[k + 4]));
+        low = vmaxq_f32(vminq_f32(low, kMax), kMin);
+        high = vmaxq_f32(vminq_f32(high, kMax), kMin);
+        vst1q_s16(&data[k], vcombine_s16(vmovn_s32(vcvtq_s32_f32(low)),
+                                         vmovn_s32(vcvtq_s32_f32(high))));
+      }
+    } break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < size; ++k) {
+    data[k] = TruncateAndSaturate(data[k] * gains[k]);
+  }
+}
+
+uint32_t SumOfSquaresS16(MixingOptimization optimization,
+                         rtc::ArrayView<const int16_t> data) {
+  const size_t size = data.size();
+  size_t k = 0;
+  uint32_t sum = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case MixingOptimization::kSse2: {
+      // The products and the sums wrap around in the same way as the scalar
+      // unsigned accumulation below.
+      __m128i acc = _mm_setzero_si128();
+      for (; k + 8 <= size; k += 8) {
+        const __m128i x =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[k]));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(x, x));
+      }
+      acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+      acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+      sum = static_cast<uint32_t>(_mm_cvtsi128_si32(acc));
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case MixingOptimization::kNeon: {
+      uint32x4_t acc = vdupq_n_u32(0);
+      for (; k + 8 <= size; k += 8) {
+        const int16x8_t x = vld1q_s16(&data[k]);
+        const int32x4_t low =
+            vmull_s16(vget_low_s16(x), vget_low_s16(x));
+        const int32x4_t high =
+            vmull_s16(vget_high_s16(x), vget_high_s16(x));
+        acc = vaddq_u32(acc, vreinterpretq_u32_s32(low));
+        acc = vaddq_u32(acc, vreinterpretq_u32_s32(high));
+      }
+      uint32x2_t acc2 = vadd_u32(vget_low_u32(acc), vget_high_u32(acc));
+      sum = vget_lane_u32(vpadd_u32(acc2, acc2), 0);
+    } break;
+#endif
+    default:
+      break;
+  }
+
+  for (; k < size; ++k) {
+    sum += static_cast<uint32_t>(data[k] * data[k]);
+  }
+  return sum;
+}
+
+}  // namespace webrtc
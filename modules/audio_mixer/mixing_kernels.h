@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+#define MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// The inner loops of the mixer, with SIMD implementations that give exactly
+// the same results as the plain C ones.
+enum class MixingOptimization { kNone, kSse2, kNeon };
+
+// Returns the best optimization supported by the CPU. The CPU is only probed
+// on the first call.
+MixingOptimization DetectMixingOptimization();
+
+// Adds the samples of |src| to |dst|, which must have the same size.
+void AccumulateS16(MixingOptimization optimization,
+                   rtc::ArrayView<const int16_t> src,
+                   rtc::ArrayView<float> dst);
+
+// Rounds and saturates FloatS16 samples to int16, like FloatS16ToS16() in
+// common_audio.
+void ConvertFloatS16ToS16(MixingOptimization optimization,
+                          rtc::ArrayView<const float> src,
+                          rtc::ArrayView<int16_t> dst);
+
+// Multiplies every sample of |data| by the corresponding gain, truncating the
+// result towards zero.
+void ApplyGainsS16(MixingOptimization optimization,
+                   rtc::ArrayView<const float> gains,
+                   rtc::ArrayView<int16_t> data);
+
+// Returns the sum of the squares of |data|, modulo 2^32.
+uint32_t SumOfSquaresS16(MixingOptimization optimization,
+                         rtc::ArrayView<const int16_t> data);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_mixer/mixing_kernels.h"
+
+#include <limits>
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/arraysize.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// An odd size, so that the scalar tail of the SIMD kernels is covered too.
+constexpr size_t kSize = 963;
+
+// Returns the optimizations that can be run on the current CPU, other than
+// kNone.
+std::vector<MixingOptimization> SimdOptimizations() {
+  std::vector<MixingOptimization> optimizations;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(MixingOptimization::kSse2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(MixingOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
+std::vector<int16_t> RandomS16(Random* random, size_t size) {
+  std::vector<int16_t> x(size);
+  for (auto& x_k : x) {
+    x_k = random->Rand<int16_t>();
+  }
+  x[0] = std::numeric_limits<int16_t>::min();
+  x[1] = std::numeric_limits<int16_t>::max();
+  return x;
+}
+
+}  // namespace
+
+TEST(MixingKernelsTest, AccumulateS16) {
+  Random random(42U);
+  for (MixingOptimization optimization : SimdOptimizations()) {
+    std::vector<float> y_c(kSize, 0.f);
+    std::vector<float> y_simd(kSize, 0.f);
+    for (int i = 0; i < 10; ++i) {
+      const std::vector<int16_t> x = RandomS16(&random, kSize);
+      AccumulateS16(MixingOptimization::kNone, x, y_c);
+      AccumulateS16(optimization, x, y_simd);
+    }
+    EXPECT_EQ(y_c, y_simd);
+  }
+}
+
+TEST(MixingKernelsTest, ConvertFloatS16ToS16) {
+  Random random(42U);
+  std::vector<float> x(kSize);
+  for (auto& x_k : x) {
+    x_k = 100000.f * (2.f * random.Rand<float>() - 1.f);
+  }
+  // Values around the rounding and saturation boundaries.
+  const float kEdges[] = {0.f,      0.5f,     -0.5f,    0.49999997f,
+                          1.5f,     -1.5f,    2.5f,     -2.5f,
+                          32766.5f, 32767.f,  32767.5f, -32767.5f,
+                          -32768.f, -32768.5f, 1e10f,   -1e10f};
+  for (size_t k = 0; k < arraysize(kEdges); ++k) {
+    x[2 * k] = kEdges[k];
+  }
+
+  std::vector<int16_t> y_c(kSize);
+  ConvertFloatS16ToS16(MixingOptimization::kNone, x, y_c);
+  for (size_t k = 0; k < kSize; ++k) {
+    EXPECT_EQ(FloatS16ToS16(x[k]), y_c[k]);
+  }
+  for (MixingOptimization optimization : SimdOptimizations()) {
+    std::vector<int16_t> y_simd(kSize);
+    ConvertFloatS16ToS16(optimization, x, y_simd);
+    EXPECT_EQ(y_c, y_simd);
+  }
+}
+
+TEST(MixingKernelsTest, ApplyGainsS16) {
+  Random random(42U);
+  const std::vector<int16_t> x = RandomS16(&random, kSize);
+  std::vector<float> gains(kSize);
+  for (auto& gains_k : gains) {
+    gains_k = random.Rand<float>();
+  }
+  gains[0] = gains[1] = 1.f;
+  // Gains above one saturate.
+  gains[2] = gains[3] = 4.f;
+
+  std::vector<int16_t> y_c = x;
+  ApplyGainsS16(MixingOptimization::kNone, gains, y_c);
+  for (size_t k = 4; k < kSize; ++k) {
+    EXPECT_EQ(static_cast<int16_t>(x[k] * gains[k]), y_c[k]);
+  }
+  for (MixingOptimization optimization : SimdOptimizations()) {
+    std::vector<int16_t> y_simd = x;
+    ApplyGainsS16(optimization, gains, y_simd);
+    EXPECT_EQ(y_c, y_simd);
+  }
+}
+
+TEST(MixingKernelsTest, SumOfSquaresS16) {
+  Random random(42U);
+  const std::vector<int16_t> x = RandomS16(&random, kSize);
+  uint32_t expected = 0;
+  for (int16_t x_k : x) {
+    expected += static_cast<uint32_t>(x_k * x_k);
+  }
+  EXPECT_EQ(expected, SumOfSquaresS16(MixingOptimization::kNone, x));
+  for (MixingOptimization optimization : SimdOptimizations()) {
+    EXPECT_EQ(expected, SumOfSquaresS16(optimization, x));
+  }
+
+  // Full scale samples, which overflow the pairwise products of some SIMD
+  // instructions.
+  const std::vector<int16_t> full_scale(kSize,
+                                        std::numeric_limits<int16_t>::min());
+  expected = SumOfSquaresS16(MixingOptimization::kNone, full_scale);
+  for (MixingOptimization optimization : SimdOptimizations()) {
+    EXPECT_EQ(expected, SumOfSquaresS16(optimization, full_scale));
+  }
+}
+
+}  // namespace webrtc
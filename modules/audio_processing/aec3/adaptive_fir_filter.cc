@@ -16,10 +16,14 @@
 #include "typedefs.h"  // NOLINT(build/include)
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #include <emmintrin.h>
+#include <stddef.h>
 #endif
 #include <algorithm>
 #include <functional>
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_processing/aec3/adaptive_fir_filter_avx2.h"
+#endif
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -413,6 +417,60 @@ void ApplyFilter_SSE2(const RenderBuffer& render_buffer,
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// The AVX2 kernels take spectra and power spectra as raw float arrays.
+static_assert(avx2::kNumBins == kFftLengthBy2Plus1, "Bin count mismatch");
+static_assert(sizeof(FftData) == avx2::kSpectrumSize * sizeof(float) &&
+                  offsetof(FftData, im) == avx2::kNumBins * sizeof(float),
+              "FftData must be laid out as the AVX2 kernels expect");
+static_assert(sizeof(std::array<float, kFftLengthBy2Plus1>) ==
+                  avx2::kNumBins * sizeof(float),
+              "Power spectra must be laid out as the AVX2 kernels expect");
+
+void UpdateFrequencyResponse_AVX2(
+    rtc::ArrayView<const FftData> H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  RTC_DCHECK_EQ(H.size(), H2->size());
+  avx2::UpdateFrequencyResponse(reinterpret_cast<const float*>(H.data()),
+                                H.size(),
+                                reinterpret_cast<float*>(H2->data()));
+}
+
+void UpdateErlEstimator_AVX2(
+    const std::vector<std::array<float, kFftLengthBy2Plus1>>& H2,
+    std::array<float, kFftLengthBy2Plus1>* erl) {
+  avx2::UpdateErlEstimator(reinterpret_cast<const float*>(H2.data()),
+                           H2.size(), erl->data());
+}
+
+void AdaptPartitions_AVX2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          rtc::ArrayView<FftData> H) {
+  rtc::ArrayView<const FftData> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  RTC_DCHECK_LT(render_buffer.Position(), render_buffer_data.size());
+  RTC_DCHECK_LE(H.size(), render_buffer_data.size());
+  avx2::AdaptPartitions(
+      reinterpret_cast<const float*>(render_buffer_data.data()),
+      render_buffer_data.size(), render_buffer.Position(),
+      reinterpret_cast<const float*>(&G), reinterpret_cast<float*>(H.data()),
+      H.size());
+}
+
+void ApplyFilter_AVX2(const RenderBuffer& render_buffer,
+                      rtc::ArrayView<const FftData> H,
+                      FftData* S) {
+  rtc::ArrayView<const FftData> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  RTC_DCHECK_LT(render_buffer.Position(), render_buffer_data.size());
+  RTC_DCHECK_LE(H.size(), render_buffer_data.size());
+  avx2::ApplyFilter(reinterpret_cast<const float*>(render_buffer_data.data()),
+                    render_buffer_data.size(), render_buffer.Position(),
+                    reinterpret_cast<const float*>(H.data()), H.size(),
+                    reinterpret_cast<float*>(S));
+}
+#endif
+
 }  // namespace aec3
 
 AdaptiveFirFilter::AdaptiveFirFilter(size_t max_size_partitions,
@@ -540,6 +598,9 @@ void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
     case Aec3Optimization::kSse2:
       aec3::ApplyFilter_SSE2(render_buffer, H_, S);
       break;
+    case Aec3Optimization::kAvx2:
+      aec3::ApplyFilter_AVX2(render_buffer, H_, S);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -562,6 +623,9 @@ void AdaptiveFirFilter::Adapt(const RenderBuffer& render_buffer,
     case Aec3Optimization::kSse2:
       aec3::AdaptPartitions_SSE2(render_buffer, G, H_);
       break;
+    case Aec3Optimization::kAvx2:
+      aec3::AdaptPartitions_AVX2(render_buffer, G, H_);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -582,6 +646,10 @@ void AdaptiveFirFilter::Adapt(const RenderBuffer& render_buffer,
       aec3::UpdateFrequencyResponse_SSE2(H_, &H2_);
       aec3::UpdateErlEstimator_SSE2(H2_, &erl_);
       break;
+    case Aec3Optimization::kAvx2:
+      aec3::UpdateFrequencyResponse_AVX2(H_, &H2_);
+      aec3::UpdateErlEstimator_AVX2(H2_, &erl_);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
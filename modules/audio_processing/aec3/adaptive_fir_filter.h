@@ -38,6 +38,9 @@ void UpdateFrequencyResponse_NEON(
 void UpdateFrequencyResponse_SSE2(
     rtc::ArrayView<const FftData> H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+void UpdateFrequencyResponse_AVX2(
+    rtc::ArrayView<const FftData> H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 
 // Computes and stores the echo return loss estimate of the filter, which is the
@@ -54,6 +57,9 @@ void UpdateErlEstimator_NEON(
 void UpdateErlEstimator_SSE2(
     const std::vector<std::array<float, kFftLengthBy2Plus1>>& H2,
     std::array<float, kFftLengthBy2Plus1>* erl);
+void UpdateErlEstimator_AVX2(
+    const std::vector<std::array<float, kFftLengthBy2Plus1>>& H2,
+    std::array<float, kFftLengthBy2Plus1>* erl);
 #endif
 
 // Adapts the filter partitions.
@@ -69,6 +75,9 @@ void AdaptPartitions_NEON(const RenderBuffer& render_buffer,
 void AdaptPartitions_SSE2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           rtc::ArrayView<FftData> H);
+void AdaptPartitions_AVX2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          rtc::ArrayView<FftData> H);
 #endif
 
 // Produces the filter output.
@@ -84,6 +93,9 @@ void ApplyFilter_NEON(const RenderBuffer& render_buffer,
 void ApplyFilter_SSE2(const RenderBuffer& render_buffer,
                       rtc::ArrayView<const FftData> H,
                       FftData* S);
+void ApplyFilter_AVX2(const RenderBuffer& render_buffer,
+                      rtc::ArrayView<const FftData> H,
+                      FftData* S);
 #endif
 
 }  // namespace aec3
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/adaptive_fir_filter_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace aec3 {
+namespace avx2 {
+namespace {
+// The bins below kLastBin are processed eight at a time, the last one on its
+// own.
+constexpr size_t kLastBin = kNumBins - 1;
+static_assert(kLastBin % 8 == 0, "The vectorized bins must fill whole vectors");
+}  // namespace
+
+void UpdateFrequencyResponse(const float* H, size_t num_partitions, float* H2) {
+  for (size_t p = 0; p < num_partitions; ++p) {
+    const float* H_re = H + p * kSpectrumSize;
+    const float* H_im = H_re + kNumBins;
+    float* H2_p = H2 + p * kNumBins;
+    for (size_t k = 0; k < kLastBin; k += 8) {
+      const __m256 re = _mm256_loadu_ps(&H_re[k]);
+      const __m256 im = _mm256_loadu_ps(&H_im[k]);
+      const __m256 re2 = _mm256_mul_ps(re, re);
+      const __m256 H2_k = _mm256_fmadd_ps(im, im, re2);
+      _mm256_storeu_ps(&H2_p[k], H2_k);
+    }
+    H2_p[kLastBin] =
+        H_re[kLastBin] * H_re[kLastBin] + H_im[kLastBin] * H_im[kLastBin];
+  }
+}
+
+void UpdateErlEstimator(const float* H2, size_t num_partitions, float* erl) {
+  for (size_t k = 0; k < kNumBins; ++k) {
+    erl[k] = 0.f;
+  }
+  for (size_t p = 0; p < num_partitions; ++p) {
+    const float* H2_p = H2 + p * kNumBins;
+    for (size_t k = 0; k < kLastBin; k += 8) {
+      const __m256 H2_p_k = _mm256_loadu_ps(&H2_p[k]);
+      __m256 erl_k = _mm256_loadu_ps(&erl[k]);
+      erl_k = _mm256_add_ps(erl_k, H2_p_k);
+      _mm256_storeu_ps(&erl[k], erl_k);
+    }
+    erl[kLastBin] += H2_p[kLastBin];
+  }
+}
+
+void AdaptPartitions(const float* X,
+                     size_t num_X,
+                     size_t x_position,
+                     const float* G,
+                     float* H,
+                     size_t num_partitions) {
+  const float* G_re = G;
+  const float* G_im = G + kNumBins;
+  // The render buffer wraps around after |lim1| partitions.
+  const size_t lim1 = num_X - x_position < num_partitions
+                          ? num_X - x_position
+                          : num_partitions;
+
+  for (size_t k = 0; k < kLastBin; k += 8) {
+    const __m256 G_re_k = _mm256_loadu_ps(&G_re[k]);
+    const __m256 G_im_k = _mm256_loadu_ps(&G_im[k]);
+    for (size_t p = 0; p < num_partitions; ++p) {
+      const float* X_re =
+          X + (p < lim1 ? x_position + p : p - lim1) * kSpectrumSize;
+      const float* X_im = X_re + kNumBins;
+      float* H_re = H + p * kSpectrumSize;
+      float* H_im = H_re + kNumBins;
+      const __m256 X_re_k = _mm256_loadu_ps(&X_re[k]);
+      const __m256 X_im_k = _mm256_loadu_ps(&X_im[k]);
+      const __m256 H_re_k = _mm256_loadu_ps(&H_re[k]);
+      const __m256 H_im_k = _mm256_loadu_ps(&H_im[k]);
+      const __m256 a = _mm256_fmadd_ps(X_re_k, G_re_k, H_re_k);
+      const __m256 b = _mm256_fmadd_ps(X_re_k, G_im_k, H_im_k);
+      const __m256 g = _mm256_fmadd_ps(X_im_k, G_im_k, a);
+      const __m256 h = _mm256_fnmadd_ps(X_im_k, G_re_k, b);
+      _mm256_storeu_ps(&H_re[k], g);
+      _mm256_storeu_ps(&H_im[k], h);
+    }
+  }
+
+  for (size_t p = 0; p < num_partitions; ++p) {
+    const float* X_re =
+        X + (p < lim1 ? x_position + p : p - lim1) * kSpectrumSize;
+    const float* X_im = X_re + kNumBins;
+    float* H_re = H + p * kSpectrumSize;
+    float* H_im = H_re + kNumBins;
+    H_re[kLastBin] += X_re[kLastBin] * G_re[kLastBin] +
+                      X_im[kLastBin] * G_im[kLastBin];
+    H_im[kLastBin] += X_re[kLastBin] * G_im[kLastBin] -
+                      X_im[kLastBin] * G_re[kLastBin];
+  }
+}
+
+void ApplyFilter(const float* X,
+                 size_t num_X,
+                 size_t x_position,
+                 const float* H,
+                 size_t num_partitions,
+                 float* S) {
+  float* S_re = S;
+  float* S_im = S + kNumBins;
+  for (size_t k = 0; k < kNumBins; ++k) {
+    S_re[k] = 0.f;
+    S_im[k] = 0.f;
+  }
+  const size_t lim1 = num_X - x_position < num_partitions
+                          ? num_X - x_position
+                          : num_partitions;
+
+  for (size_t p = 0; p < num_partitions; ++p) {
+    const float* X_re =
+        X + (p < lim1 ? x_position + p : p - lim1) * kSpectrumSize;
+    const float* X_im = X_re + kNumBins;
+    const float* H_re = H + p * kSpectrumSize;
+    const float* H_im = H_re + kNumBins;
+    for (size_t k = 0; k < kLastBin; k += 8) {
+      const __m256 X_re_k = _mm256_loadu_ps(&X_re[k]);
+      const __m256 X_im_k = _mm256_loadu_ps(&X_im[k]);
+      const __m256 H_re_k = _mm256_loadu_ps(&H_re[k]);
+      const __m256 H_im_k = _mm256_loadu_ps(&H_im[k]);
+      const __m256 S_re_k = _mm256_loadu_ps(&S_re[k]);
+      const __m256 S_im_k = _mm256_loadu_ps(&S_im[k]);
+      const __m256 a = _mm256_fmadd_ps(X_re_k, H_re_k, S_re_k);
+      const __m256 b = _mm256_fmadd_ps(X_re_k, H_im_k, S_im_k);
+      const __m256 g = _mm256_fnmadd_ps(X_im_k, H_im_k, a);
+      const __m256 h = _mm256_fmadd_ps(X_im_k, H_re_k, b);
+      _mm256_storeu_ps(&S_re[k], g);
+      _mm256_storeu_ps(&S_im[k], h);
+    }
+    S_re[kLastBin] += X_re[kLastBin] * H_re[kLastBin] -
+                      X_im[kLastBin] * H_im[kLastBin];
+    S_im[kLastBin] += X_re[kLastBin] * H_im[kLastBin] +
+                      X_im[kLastBin] * H_re[kLastBin];
+  }
+}
+
+}  // namespace avx2
+}  // namespace aec3
+}  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX2_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX2_H_
+
+#include <stddef.h>
+
+namespace webrtc {
+namespace aec3 {
+namespace avx2 {
+
+// The kernels behind the *_AVX2 functions of adaptive_fir_filter.h. They are
+// built with AVX2 and FMA code generation enabled, so they only take raw
+// pointers and sizes and call no inline functions from other headers: the
+// linker may keep any copy of such a function, including one with AVX2
+// instructions, for the whole binary. They may only be called when
+// DetectOptimization() returns Aec3Optimization::kAvx2.
+//
+// A spectrum is laid out as FftData: the real parts of its kNumBins bins
+// followed by their imaginary parts.
+constexpr size_t kNumBins = 65;
+constexpr size_t kSpectrumSize = 2 * kNumBins;
+
+// Computes the power spectra |H2|, kNumBins floats each, of the
+// |num_partitions| spectra in |H|.
+void UpdateFrequencyResponse(const float* H, size_t num_partitions, float* H2);
+
+// Computes the echo return loss estimate |erl| as the sum of the
+// |num_partitions| power spectra in |H2|.
+void UpdateErlEstimator(const float* H2, size_t num_partitions, float* erl);
+
+// Adapts the |num_partitions| spectra in |H| with the gain |G|. |X| is a
+// circular buffer of |num_X| render spectra, where the one for the first
+// partition is at |x_position|.
+void AdaptPartitions(const float* X,
+                     size_t num_X,
+                     size_t x_position,
+                     const float* G,
+                     float* H,
+                     size_t num_partitions);
+
+// Produces the filter output |S| of the |num_partitions| spectra in |H| for
+// the render spectra in |X|, laid out as for AdaptPartitions().
+void ApplyFilter(const float* X,
+                 size_t num_X,
+                 size_t x_position,
+                 const float* H,
+                 size_t num_partitions,
+                 float* S);
+
+}  // namespace avx2
+}  // namespace aec3
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_ADAPTIVE_FIR_FILTER_AVX2_H_
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumBlocksToProcess = 2500;
+constexpr size_t kNumWarmupBlocks = 100;
+
+std::string OptimizationName(Aec3Optimization optimization) {
+  switch (optimization) {
+    case Aec3Optimization::kSse2:
+      return "sse2";
+    case Aec3Optimization::kAvx2:
+      return "avx2";
+    case Aec3Optimization::kNeon:
+      return "neon";
+    default:
+      return "c";
+  }
+}
+
+// Returns the optimizations that can be run on the current CPU.
+std::vector<Aec3Optimization> AvailableOptimizations() {
+  std::vector<Aec3Optimization> optimizations = {Aec3Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(Aec3Optimization::kSse2);
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0 && WebRtc_GetCPUInfo(kFMA3) != 0) {
+    optimizations.push_back(Aec3Optimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Aec3Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
+void FillRandomBlock(Random* random_generator, std::vector<float>* v) {
+  for (auto& v_k : *v) {
+    v_k = 32767.f * (2.f * random_generator->Rand<float>() - 1.f);
+  }
+}
+
+void PrintTiming(const std::string& kernel,
+                 Aec3Optimization optimization,
+                 const test::PerformanceTimer& timer) {
+  test::PrintResultMeanAndError(
+      "aec3_block_timing", "_" + kernel, OptimizationName(optimization),
+      timer.GetDurationAverage(kNumWarmupBlocks),
+      timer.GetDurationStandardDeviation(kNumWarmupBlocks), "us", false);
+}
+
+}  // namespace
+
+// Measures the time spent per block in filtering and adapting the main
+// adaptive filter, for each optimization supported by the CPU.
+TEST(Aec3KernelsPerformance, AdaptiveFirFilterPerBlock) {
+  for (Aec3Optimization optimization : AvailableOptimizations()) {
+    SCOPED_TRACE(OptimizationName(optimization));
+    ApmDataDumper data_dumper(42);
+    EchoCanceller3Config config;
+    AdaptiveFirFilter filter(config.filter.main.length_blocks,
+                             config.filter.main.length_blocks,
+                             config.filter.config_change_duration_blocks,
+                             optimization, &data_dumper);
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, 3));
+    Random random_generator(42U);
+    std::vector<std::vector<float>> x(3, std::vector<float>(kBlockSize, 0.f));
+    FftData S;
+    FftData G;
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      G.re[k] = 1e-6f * (2.f * random_generator.Rand<float>() - 1.f);
+      G.im[k] = 1e-6f * (2.f * random_generator.Rand<float>() - 1.f);
+    }
+
+    test::PerformanceTimer timer(kNumBlocksToProcess);
+    for (size_t j = 0; j < kNumBlocksToProcess; ++j) {
+      FillRandomBlock(&random_generator, &x[0]);
+      render_delay_buffer->Insert(x);
+      if (j == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      const RenderBuffer& render_buffer =
+          *render_delay_buffer->GetRenderBuffer();
+
+      timer.StartTimer();
+      filter.Filter(render_buffer, &S);
+      filter.Adapt(render_buffer, G);
+      timer.StopTimer();
+    }
+    PrintTiming("adaptive_fir_filter", optimization, timer);
+  }
+}
+
+// Measures the time spent per block in updating the matched filters used for
+// delay estimation, for each optimization supported by the CPU.
+TEST(Aec3KernelsPerformance, MatchedFilterPerBlock) {
+  for (Aec3Optimization optimization : AvailableOptimizations()) {
+    SCOPED_TRACE(OptimizationName(optimization));
+    ApmDataDumper data_dumper(42);
+    EchoCanceller3Config config;
+    const size_t down_sampling_factor = config.delay.down_sampling_factor;
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    MatchedFilter filter(&data_dumper, optimization, sub_block_size,
+                         kMatchedFilterWindowSizeSubBlocks,
+                         config.delay.num_filters,
+                         kMatchedFilterAlignmentShiftSizeSubBlocks,
+                         config.render_levels.poor_excitation_render_limit);
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, 3));
+    Random random_generator(42U);
+    std::vector<std::vector<float>> x(3, std::vector<float>(kBlockSize, 0.f));
+    std::vector<std::vector<float>> y(
+        down_sampling_factor, std::vector<float>(sub_block_size, 0.f));
+
+    test::PerformanceTimer timer(kNumBlocksToProcess);
+    for (size_t j = 0; j < kNumBlocksToProcess; ++j) {
+      FillRandomBlock(&random_generator, &x[0]);
+      render_delay_buffer->Insert(x);
+      if (j == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      const DownsampledRenderBuffer& downsampled_render_buffer =
+          render_delay_buffer->GetDownsampledRenderBuffer();
+      for (auto& y_k : y) {
+        FillRandomBlock(&random_generator, &y_k);
+      }
+
+      timer.StartTimer();
+      for (const auto& y_k : y) {
+        filter.Update(downsampled_render_buffer, y_k);
+      }
+      timer.StopTimer();
+    }
+    PrintTiming("matched_filter", optimization, timer);
+  }
+}
+
+}  // namespace webrtc
@@ -20,6 +20,9 @@
 #include <numeric>
 
 #include "api/audio/echo_canceller3_config.h"
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/audio_processing/aec3/matched_filter_avx2.h"
+#endif
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/logging.h"
 
@@ -253,6 +256,20 @@ void MatchedFilterCore_SSE2(size_t x_start_index,
     x_start_index = x_start_index > 0 ? x_start_index - 1 : x_size - 1;
   }
 }
+
+void MatchedFilterCore_AVX2(size_t x_start_index,
+                            float x2_sum_threshold,
+                            rtc::ArrayView<const float> x,
+                            rtc::ArrayView<const float> y,
+                            rtc::ArrayView<float> h,
+                            bool* filters_updated,
+                            float* error_sum) {
+  RTC_DCHECK_EQ(0, h.size() % 4);
+  RTC_DCHECK_GT(x.size(), x_start_index);
+  avx2::MatchedFilterCore(x_start_index, x2_sum_threshold, x.data(), x.size(),
+                          y.data(), y.size(), h.data(), h.size(),
+                          filters_updated, error_sum);
+}
 #endif
 
 void MatchedFilterCore(size_t x_start_index,
@@ -363,6 +380,11 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
                                      render_buffer.buffer, y, filters_[n],
                                      &filters_updated, &error_sum);
         break;
+      case Aec3Optimization::kAvx2:
+        aec3::MatchedFilterCore_AVX2(x_start_index, x2_sum_threshold,
+                                     render_buffer.buffer, y, filters_[n],
+                                     &filters_updated, &error_sum);
+        break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
       case Aec3Optimization::kNeon:
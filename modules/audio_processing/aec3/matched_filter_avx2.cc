@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/matched_filter_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace aec3 {
+namespace avx2 {
+
+void MatchedFilterCore(size_t x_start_index,
+                       float x2_sum_threshold,
+                       const float* x,
+                       size_t x_size,
+                       const float* y,
+                       size_t y_size,
+                       float* h,
+                       size_t h_size,
+                       bool* filters_updated,
+                       float* error_sum) {
+  const int h_size_int = static_cast<int>(h_size);
+  const int x_size_int = static_cast<int>(x_size);
+  const __m128 kMinError = _mm_set_ss(-32768.f);
+  const __m128 kMaxError = _mm_set_ss(32767.f);
+
+  // Process for all samples in the sub-block.
+  for (size_t i = 0; i < y_size; ++i) {
+    // Apply the matched filter as filter * x, and compute x * x.
+    const float* x_p = &x[x_start_index];
+    const float* h_p = &h[0];
+
+    // Initialize values for the accumulation.
+    __m256 s_256 = _mm256_setzero_ps();
+    __m256 x2_sum_256 = _mm256_setzero_ps();
+    float x2_sum = 0.f;
+    float s = 0;
+
+    // Compute loop chunk sizes until, and after, the wraparound of the circular
+    // buffer for x.
+    const int x_left = x_size_int - static_cast<int>(x_start_index);
+    const int chunk1 = h_size_int < x_left ? h_size_int : x_left;
+    const int chunk2 = h_size_int - chunk1;
+    const int limits[2] = {chunk1, chunk2};
+
+    // Perform the loop in two chunks.
+    for (int c = 0; c < 2; ++c) {
+      const int limit = limits[c];
+      // Perform 256 bit vector operations.
+      const int limit_by_8 = limit >> 3;
+      for (int k = limit_by_8; k > 0; --k, h_p += 8, x_p += 8) {
+        // Load the data into 256 bit vectors.
+        const __m256 x_k = _mm256_loadu_ps(x_p);
+        const __m256 h_k = _mm256_loadu_ps(h_p);
+        // Compute and accumulate x * x and h * x.
+        x2_sum_256 = _mm256_fmadd_ps(x_k, x_k, x2_sum_256);
+        s_256 = _mm256_fmadd_ps(h_k, x_k, s_256);
+      }
+
+      // Perform non-vector operations for any remaining items.
+      for (int k = limit - limit_by_8 * 8; k > 0; --k, ++h_p, ++x_p) {
+        const float x_k = *x_p;
+        x2_sum += x_k * x_k;
+        s += *h_p * x_k;
+      }
+
+      x_p = &x[0];
+    }
+
+    // Combine the accumulated vector and scalar values.
+    __m128 x2_sum_128 = _mm_add_ps(_mm256_extractf128_ps(x2_sum_256, 0),
+                                   _mm256_extractf128_ps(x2_sum_256, 1));
+    __m128 s_128 = _mm_add_ps(_mm256_extractf128_ps(s_256, 0),
+                              _mm256_extractf128_ps(s_256, 1));
+    float* v = reinterpret_cast<float*>(&x2_sum_128);
+    x2_sum += v[0] + v[1] + v[2] + v[3];
+    v = reinterpret_cast<float*>(&s_128);
+    s += v[0] + v[1] + v[2] + v[3];
+
+    // Compute the matched filter error.
+    float e = y[i] - s;
+    const bool saturation = y[i] >= 32000.f || y[i] <= -32000.f ||
+                            s >= 32000.f || s <= -32000.f || e >= 32000.f ||
+                            e <= -32000.f;
+
+    e = _mm_cvtss_f32(
+        _mm_min_ss(_mm_max_ss(_mm_set_ss(e), kMinError), kMaxError));
+    (*error_sum) += e * e;
+
+    // Update the matched filter estimate in an NLMS manner.
+    if (x2_sum > x2_sum_threshold && !saturation) {
+      const float alpha = 0.7f * e / x2_sum;
+      const __m256 alpha_256 = _mm256_set1_ps(alpha);
+
+      // filter = filter + 0.7 * (y - filter * x) / x * x.
+      float* h_p = &h[0];
+      x_p = &x[x_start_index];
+
+      // Perform the loop in two chunks.
+      for (int c = 0; c < 2; ++c) {
+        const int limit = limits[c];
+        // Perform 256 bit vector operations.
+        const int limit_by_8 = limit >> 3;
+        for (int k = limit_by_8; k > 0; --k, h_p += 8, x_p += 8) {
+          // Load the data into 256 bit vectors.
+          __m256 h_k = _mm256_loadu_ps(h_p);
+          const __m256 x_k = _mm256_loadu_ps(x_p);
+
+          // Compute h = h + alpha * x.
+          h_k = _mm256_fmadd_ps(alpha_256, x_k, h_k);
+
+          // Store the result.
+          _mm256_storeu_ps(h_p, h_k);
+        }
+
+        // Perform non-vector operations for any remaining items.
+        for (int k = limit - limit_by_8 * 8; k > 0; --k, ++h_p, ++x_p) {
+          *h_p += alpha * *x_p;
+        }
+
+        x_p = &x[0];
+      }
+
+      *filters_updated = true;
+    }
+
+    x_start_index = x_start_index > 0 ? x_start_index - 1 : x_size - 1;
+  }
+}
+
+}  // namespace avx2
+}  // namespace aec3
+}  // namespace webrtc
@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batched_low_cut_filter.h"
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// The coefficients of the LowCutFilter biquad.
+const int16_t kFilterCoefficients8kHz[5] = {3798, -7596, 3798, 7807, -3733};
+const int16_t kFilterCoefficients[5] = {4012, -8024, 4012, 8002, -3913};
+}  // namespace
+
+BatchedLowCutFilter::BatchedLowCutFilter(size_t num_streams,
+                                         const Config& config)
+    : config_(config),
+      num_streams_(num_streams),
+      samples_per_frame_(AudioProcessing::kChunkSizeMs *
+                         config.sample_rate_hz / 1000),
+      audio_(num_streams * samples_per_frame_, 0),
+      x0_(num_streams, 0),
+      x1_(num_streams, 0),
+      y0_(num_streams, 0),
+      y1_(num_streams, 0),
+      y2_(num_streams, 0),
+      y3_(num_streams, 0),
+      sum_square_(config.level_estimation ? num_streams : 0, 0.f),
+      levels_(config.level_estimation ? num_streams : 0) {
+  RTC_DCHECK(config.sample_rate_hz == AudioProcessing::kSampleRate8kHz ||
+             config.sample_rate_hz == AudioProcessing::kSampleRate16kHz);
+}
+
+BatchedLowCutFilter::~BatchedLowCutFilter() = default;
+
+void BatchedLowCutFilter::ProcessStreams(
+    rtc::ArrayView<int16_t* const> frames) {
+  RTC_DCHECK_EQ(num_streams_, frames.size());
+  CopyFromFrames(frames);
+  Filter();
+  if (config_.level_estimation) {
+    AnalyzeLevels();
+  }
+  CopyToFrames(frames);
+}
+
+int BatchedLowCutFilter::RMS(size_t stream) {
+  if (!config_.level_estimation) {
+    return AudioProcessing::kNotEnabledError;
+  }
+  RTC_DCHECK_LT(stream, num_streams_);
+  return levels_[stream].Average();
+}
+
+void BatchedLowCutFilter::CopyFromFrames(
+    rtc::ArrayView<int16_t* const> frames) {
+  for (size_t n = 0; n < num_streams_; ++n) {
+    const int16_t* frame = frames[n];
+    for (size_t k = 0; k < samples_per_frame_; ++k) {
+      audio_[k * num_streams_ + n] = frame[k];
+    }
+  }
+}
+
+void BatchedLowCutFilter::CopyToFrames(
+    rtc::ArrayView<int16_t* const> frames) const {
+  for (size_t n = 0; n < num_streams_; ++n) {
+    int16_t* frame = frames[n];
+    for (size_t k = 0; k < samples_per_frame_; ++k) {
+      frame[k] = audio_[k * num_streams_ + n];
+    }
+  }
+}
+
+// Applies the LowCutFilter biquad to all streams. The computations are the
+// same as in LowCutFilter, but the loop over the streams is innermost so that
+// it can be vectorized.
+void BatchedLowCutFilter::Filter() {
+  const int16_t* const ba =
+      config_.sample_rate_hz == AudioProcessing::kSampleRate8kHz
+          ? kFilterCoefficients8kHz
+          : kFilterCoefficients;
+  const int32_t b0 = ba[0];
+  const int32_t b1 = ba[1];
+  const int32_t b2 = ba[2];
+  const int32_t a1 = ba[3];
+  const int32_t a2 = ba[4];
+  int16_t* const x0 = x0_.data();
+  int16_t* const x1 = x1_.data();
+  int16_t* const y0 = y0_.data();
+  int16_t* const y1 = y1_.data();
+  int16_t* const y2 = y2_.data();
+  int16_t* const y3 = y3_.data();
+
+  for (size_t k = 0; k < samples_per_frame_; ++k) {
+    int16_t* const data = &audio_[k * num_streams_];
+    for (size_t n = 0; n < num_streams_; ++n) {
+      //  y[i] = b[0] * x[i] +  b[1] * x[i-1] +  b[2] * x[i-2]
+      //                     + -a[1] * y[i-1] + -a[2] * y[i-2];
+      int32_t tmp_int32 = y1[n] * a1;  // -a[1] * y[i-1] (low part)
+      tmp_int32 += y3[n] * a2;         // -a[2] * y[i-2] (low part)
+      tmp_int32 = (tmp_int32 >> 15);
+      tmp_int32 += y0[n] * a1;  // -a[1] * y[i-1] (high part)
+      tmp_int32 += y2[n] * a2;  // -a[2] * y[i-2] (high part)
+      tmp_int32 *= 2;
+
+      tmp_int32 += data[n] * b0;  // b[0] * x[0]
+      tmp_int32 += x0[n] * b1;    // b[1] * x[i-1]
+      tmp_int32 += x1[n] * b2;    // b[2] * x[i-2]
+
+      // Update state (input part).
+      x1[n] = x0[n];
+      x0[n] = data[n];
+
+      // Update state (filtered part).
+      y2[n] = y0[n];
+      y3[n] = y1[n];
+      y0[n] = static_cast<int16_t>(tmp_int32 >> 13);
+      y1[n] = static_cast<int16_t>((tmp_int32 & 0x00001FFF) * 4);
+
+      // Rounding in Q12, i.e. add 2^11.
+      tmp_int32 += 2048;
+
+      // Saturate (to 2^27) so that the HP filtered signal does not overflow.
+      tmp_int32 = WEBRTC_SPL_SAT(static_cast<int32_t>(134217727), tmp_int32,
+                                 static_cast<int32_t>(-134217728));
+
+      // Convert back to Q0 and use rounding.
+      data[n] = static_cast<int16_t>(tmp_int32 >> 12);
+    }
+  }
+}
+
+// Accumulates the sum of squares of every stream in the same sample order as
+// RmsLevel::Analyze() does, which keeps the levels bitexact.
+void BatchedLowCutFilter::AnalyzeLevels() {
+  std::fill(sum_square_.begin(), sum_square_.end(), 0.f);
+  float* const sum_square = sum_square_.data();
+  for (size_t k = 0; k < samples_per_frame_; ++k) {
+    const int16_t* const data = &audio_[k * num_streams_];
+    for (size_t n = 0; n < num_streams_; ++n) {
+      sum_square[n] += data[n] * data[n];
+    }
+  }
+
+  for (size_t n = 0; n < num_streams_; ++n) {
+    levels_[n].AnalyzeSumSquare(sum_square[n], samples_per_frame_);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_BATCHED_LOW_CUT_FILTER_H_
+#define MODULES_AUDIO_PROCESSING_BATCHED_LOW_CUT_FILTER_H_
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/rms_level.h"
+#include "rtc_base/constructormagic.h"
+
+namespace webrtc {
+
+// Applies the high-pass filter of AudioProcessing to many independent mono
+// capture streams at once, and optionally measures their levels afterwards,
+// as needed by servers that handle every participant of a call. The filter
+// and level states are laid out structure-of-arrays, so that the per-sample
+// loops run across all streams.
+//
+// The output for each stream matches that of an AudioProcessing instance with
+// only the high-pass filter (and level estimator) enabled, fed with the same
+// 10 ms mono int16 frames.
+//
+// The class is not thread-safe; all calls must be made on the same thread.
+class BatchedLowCutFilter {
+ public:
+  struct Config {
+    // Only the full-band rates are supported, as no band splitting is done.
+    int sample_rate_hz = AudioProcessing::kSampleRate16kHz;
+    bool level_estimation = false;
+  };
+
+  BatchedLowCutFilter(size_t num_streams, const Config& config);
+  ~BatchedLowCutFilter();
+
+  size_t num_streams() const { return num_streams_; }
+  size_t samples_per_frame() const { return samples_per_frame_; }
+
+  // Filters one 10 ms frame for every stream, in place. |frames| holds one
+  // pointer per stream, each to samples_per_frame() samples.
+  void ProcessStreams(rtc::ArrayView<int16_t* const> frames);
+
+  // Returns the RMS level of |stream| since the last call, in the format of
+  // LevelEstimation::RMS(). Requires |level_estimation| to be enabled.
+  int RMS(size_t stream);
+
+ private:
+  void CopyFromFrames(rtc::ArrayView<int16_t* const> frames);
+  void CopyToFrames(rtc::ArrayView<int16_t* const> frames) const;
+  void Filter();
+  void AnalyzeLevels();
+
+  const Config config_;
+  const size_t num_streams_;
+  const size_t samples_per_frame_;
+
+  // The audio of all streams for the current frame, with the samples of the
+  // streams interleaved: sample k of stream n is at k * num_streams_ + n.
+  std::vector<int16_t> audio_;
+
+  // Filter states, one entry per stream.
+  std::vector<int16_t> x0_;
+  std::vector<int16_t> x1_;
+  std::vector<int16_t> y0_;
+  std::vector<int16_t> y1_;
+  std::vector<int16_t> y2_;
+  std::vector<int16_t> y3_;
+
+  // Level estimation states, one entry per stream.
+  std::vector<float> sum_square_;
+  std::vector<RmsLevel> levels_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BatchedLowCutFilter);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_BATCHED_LOW_CUT_FILTER_H_
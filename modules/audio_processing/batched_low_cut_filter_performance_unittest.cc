@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batched_low_cut_filter.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumStreams = 500;
+constexpr size_t kNumFramesToProcess = 200;
+
+void FillRandomFrames(Random* random_generator,
+                      std::vector<std::vector<int16_t>>* frames) {
+  for (auto& frame : *frames) {
+    for (auto& sample : frame) {
+      sample = static_cast<int16_t>(random_generator->Rand(-10000, 10000));
+    }
+  }
+}
+
+// Returns how many streams of 10 ms frames a single core keeps up with, given
+// the time it took to process |kNumFramesToProcess| frames of |kNumStreams|
+// streams.
+double StreamsPerCore(int64_t elapsed_us) {
+  const double audio_duration_us =
+      kNumFramesToProcess * AudioProcessing::kChunkSizeMs * 1000.0;
+  return kNumStreams * audio_duration_us / std::max<int64_t>(elapsed_us, 1);
+}
+
+}  // namespace
+
+// Measures the number of mono streams that can be processed in real time on
+// one core, by BatchedLowCutFilter and by one AudioProcessing instance per
+// stream with the same submodules enabled.
+TEST(BatchedLowCutFilterPerformance, StreamsPerCore) {
+  BatchedLowCutFilter::Config config;
+  config.level_estimation = true;
+  Random random_generator(42U);
+
+  BatchedLowCutFilter batched(kNumStreams, config);
+  std::vector<std::vector<int16_t>> frames(
+      kNumStreams, std::vector<int16_t>(batched.samples_per_frame()));
+  std::vector<int16_t*> frame_pointers;
+  for (auto& frame : frames) {
+    frame_pointers.push_back(frame.data());
+  }
+
+  int64_t elapsed_us = 0;
+  for (size_t j = 0; j < kNumFramesToProcess; ++j) {
+    FillRandomFrames(&random_generator, &frames);
+    const int64_t start_us = rtc::TimeMicros();
+    batched.ProcessStreams(frame_pointers);
+    elapsed_us += rtc::TimeMicros() - start_us;
+  }
+  test::PrintResult("low_cut_filter_streams_per_core", "", "batched",
+                    StreamsPerCore(elapsed_us), "streams", false);
+
+  std::vector<std::unique_ptr<AudioProcessing>> apms;
+  for (size_t n = 0; n < kNumStreams; ++n) {
+    apms.emplace_back(AudioProcessingBuilder().Create());
+    AudioProcessing::Config apm_config;
+    apm_config.high_pass_filter.enabled = true;
+    apms.back()->ApplyConfig(apm_config);
+    apms.back()->level_estimator()->Enable(config.level_estimation);
+  }
+
+  AudioFrame frame;
+  elapsed_us = 0;
+  for (size_t j = 0; j < kNumFramesToProcess; ++j) {
+    FillRandomFrames(&random_generator, &frames);
+    const int64_t start_us = rtc::TimeMicros();
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      frame.UpdateFrame(0, frames[n].data(), frames[n].size(),
+                        config.sample_rate_hz, AudioFrame::kNormalSpeech,
+                        AudioFrame::kVadUnknown, 1);
+      ASSERT_EQ(AudioProcessing::kNoError, apms[n]->ProcessStream(&frame));
+    }
+    elapsed_us += rtc::TimeMicros() - start_us;
+  }
+  test::PrintResult("low_cut_filter_streams_per_core", "", "per_stream_apm",
+                    StreamsPerCore(elapsed_us), "streams", false);
+}
+
+}  // namespace webrtc
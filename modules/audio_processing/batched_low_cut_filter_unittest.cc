@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/batched_low_cut_filter.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumStreams = 13;
+constexpr size_t kNumFramesToProcess = 300;
+
+std::string ProduceDebugText(int sample_rate_hz, size_t stream) {
+  std::ostringstream ss;
+  ss << "Sample rate: " << sample_rate_hz << ", Stream: " << stream;
+  return ss.str();
+}
+
+std::unique_ptr<AudioProcessing> CreateReference(
+    const BatchedLowCutFilter::Config& config) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  AudioProcessing::Config apm_config;
+  apm_config.high_pass_filter.enabled = true;
+  apm->ApplyConfig(apm_config);
+  apm->level_estimator()->Enable(config.level_estimation);
+  return apm;
+}
+
+// Runs BatchedLowCutFilter and one AudioProcessing instance per stream on
+// the same random input, and verifies that their outputs are bitexact.
+void RunBitexactnessTest(const BatchedLowCutFilter::Config& config) {
+  BatchedLowCutFilter batched(kNumStreams, config);
+  std::vector<std::unique_ptr<AudioProcessing>> references;
+  for (size_t n = 0; n < kNumStreams; ++n) {
+    references.push_back(CreateReference(config));
+  }
+
+  Random random_generator(42U);
+  std::vector<std::vector<int16_t>> frames(
+      kNumStreams, std::vector<int16_t>(batched.samples_per_frame()));
+  std::vector<int16_t*> frame_pointers;
+  for (auto& frame : frames) {
+    frame_pointers.push_back(frame.data());
+  }
+  AudioFrame reference_frame;
+  for (size_t j = 0; j < kNumFramesToProcess; ++j) {
+    for (auto& frame : frames) {
+      for (auto& sample : frame) {
+        sample = static_cast<int16_t>(random_generator.Rand(-10000, 10000));
+      }
+    }
+
+    std::vector<std::vector<int16_t>> reference_outputs;
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      reference_frame.UpdateFrame(0, frames[n].data(), frames[n].size(),
+                                  config.sample_rate_hz,
+                                  AudioFrame::kNormalSpeech,
+                                  AudioFrame::kVadUnknown, 1);
+      ASSERT_EQ(AudioProcessing::kNoError,
+                references[n]->ProcessStream(&reference_frame));
+      reference_outputs.emplace_back(
+          reference_frame.data(),
+          reference_frame.data() + reference_frame.samples_per_channel_);
+    }
+
+    batched.ProcessStreams(frame_pointers);
+
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      SCOPED_TRACE(ProduceDebugText(config.sample_rate_hz, n));
+      EXPECT_EQ(reference_outputs[n], frames[n]);
+    }
+  }
+
+  if (config.level_estimation) {
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      SCOPED_TRACE(ProduceDebugText(config.sample_rate_hz, n));
+      EXPECT_EQ(references[n]->level_estimator()->RMS(), batched.RMS(n));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BatchedLowCutFilter, BitexactWithAudioProcessing) {
+  for (int sample_rate_hz : {AudioProcessing::kSampleRate8kHz,
+                             AudioProcessing::kSampleRate16kHz}) {
+    BatchedLowCutFilter::Config config;
+    config.sample_rate_hz = sample_rate_hz;
+    RunBitexactnessTest(config);
+  }
+}
+
+TEST(BatchedLowCutFilter, BitexactWithLevelEstimation) {
+  for (int sample_rate_hz : {AudioProcessing::kSampleRate8kHz,
+                             AudioProcessing::kSampleRate16kHz}) {
+    BatchedLowCutFilter::Config config;
+    config.sample_rate_hz = sample_rate_hz;
+    config.level_estimation = true;
+    RunBitexactnessTest(config);
+  }
+}
+
+TEST(BatchedLowCutFilter, LevelEstimationNotEnabled) {
+  BatchedLowCutFilter::Config config;
+  BatchedLowCutFilter batched(2, config);
+  EXPECT_EQ(AudioProcessing::kNotEnabledError, batched.RMS(0));
+}
+
+}  // namespace webrtc
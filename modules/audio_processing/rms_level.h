@@ -44,6 +44,10 @@ class RmsLevel {
   // Pass each chunk of audio to Analyze() to accumulate the level.
   void Analyze(rtc::ArrayView<const int16_t> data);
 
+  // Like Analyze(), but for a chunk of |length| samples whose sum of squares
+  // has already been computed by the caller.
+  void AnalyzeSumSquare(float sum_square, size_t length);
+
   // If all samples with the given |length| have a magnitude of zero, this is
   // a shortcut to avoid some computation.
   void AnalyzeMuted(size_t length);
@@ -21,6 +21,7 @@
 #include "modules/pacing/alr_detector.h"
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
+#include "modules/pacing/pooled_packet_queue.h"
 #include "modules/pacing/round_robin_packet_queue.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
@@ -41,6 +42,13 @@ const int64_t kMaxElapsedTimeMs = 2000;
 // time.
 const int64_t kMaxIntervalTimeMs = 30;
 
+std::unique_ptr<webrtc::PacketQueueInterface> CreatePacketQueue(
+    const webrtc::Clock* clock) {
+  if (webrtc::field_trial::IsEnabled("WebRTC-Pacer-PooledPacketQueue"))
+    return rtc::MakeUnique<webrtc::PooledPacketQueue>(clock);
+  return rtc::MakeUnique<webrtc::RoundRobinPacketQueue>(clock);
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -54,7 +62,7 @@ PacedSender::PacedSender(const Clock* clock,
     : PacedSender(clock,
                   packet_sender,
                   event_log,
-                  rtc::MakeUnique<RoundRobinPacketQueue>(clock)) {}
+                  CreatePacketQueue(clock)) {}
 
 PacedSender::PacedSender(const Clock* clock,
                          PacketSender* packet_sender,
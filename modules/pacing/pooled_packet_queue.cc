@@ -0,0 +1,301 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+constexpr size_t PooledPacketQueue::kQuantumBytes;
+constexpr int PooledPacketQueue::kNumPriorities;
+constexpr uint32_t PooledPacketQueue::kInvalid;
+constexpr uint32_t PooledPacketQueue::kNodesPerBlock;
+
+PooledPacketQueue::Node::Node()
+    : packet(RtpPacketSender::kNormalPriority, 0, 0, 0, 0, 0, false, 0) {}
+
+PooledPacketQueue::PooledPacketQueue(const Clock* clock)
+    : clock_(clock), time_last_updated_(clock_->TimeInMilliseconds()) {
+  std::fill(buckets_, buckets_ + kNumPriorities, kInvalid);
+}
+
+PooledPacketQueue::~PooledPacketQueue() {}
+
+void PooledPacketQueue::Push(const Packet& packet) {
+  RTC_CHECK_GE(packet.priority, 0);
+  RTC_CHECK_LT(packet.priority, kNumPriorities);
+
+  // See RoundRobinPacketQueue::Push() for how pause time is accounted for.
+  UpdateQueueTime(packet.enqueue_time_ms);
+
+  uint32_t index = AllocateNode();
+  Node& entry = node(index);
+  entry.packet = packet;
+  entry.enqueue_time_ms = packet.enqueue_time_ms;
+  entry.packet.enqueue_time_ms -= pause_time_sum_ms_;
+  entry.next = kInvalid;
+  entry.older = newest_node_;
+  entry.newer = kInvalid;
+  if (newest_node_ != kInvalid)
+    node(newest_node_).newer = index;
+  else
+    oldest_node_ = index;
+  newest_node_ = index;
+
+  uint32_t stream_index = GetOrCreateStream(packet.ssrc);
+  Stream* stream = &streams_[stream_index];
+  Fifo* fifo = FifoFor(stream, packet);
+  if (fifo->empty())
+    fifo->head = index;
+  else
+    node(fifo->tail).next = index;
+  fifo->tail = index;
+  ++stream->num_packets;
+
+  // Note that RtpPacketSender::Priority uses lower ordinal for higher
+  // priority.
+  if (stream->scheduled_priority == -1) {
+    Schedule(stream_index, packet.priority);
+  } else if (packet.priority < stream->scheduled_priority) {
+    Unschedule(stream_index);
+    Schedule(stream_index, packet.priority);
+  }
+
+  size_packets_ += 1;
+  size_bytes_ += packet.bytes;
+}
+
+const PacketQueueInterface::Packet& PooledPacketQueue::BeginPop() {
+  RTC_CHECK(pop_node_ == kInvalid);
+
+  pop_stream_ = NextStream();
+  Fifo* fifo = TopFifo(&streams_[pop_stream_]);
+  RTC_CHECK(fifo);
+  pop_node_ = fifo->head;
+  fifo->head = node(pop_node_).next;
+  if (fifo->empty())
+    fifo->tail = kInvalid;
+  return node(pop_node_).packet;
+}
+
+void PooledPacketQueue::CancelPop(const Packet& packet) {
+  RTC_CHECK(pop_node_ != kInvalid);
+  Fifo* fifo = FifoFor(&streams_[pop_stream_], node(pop_node_).packet);
+  node(pop_node_).next = fifo->head;
+  fifo->head = pop_node_;
+  if (fifo->tail == kInvalid)
+    fifo->tail = pop_node_;
+  pop_node_ = kInvalid;
+  pop_stream_ = kInvalid;
+}
+
+void PooledPacketQueue::FinalizePop(const Packet& packet) {
+  RTC_CHECK(!paused_);
+  if (Empty())
+    return;
+  RTC_CHECK(pop_node_ != kInvalid);
+  Node& entry = node(pop_node_);
+  Stream* stream = &streams_[pop_stream_];
+
+  int64_t time_in_non_paused_state_ms =
+      time_last_updated_ - entry.packet.enqueue_time_ms - pause_time_sum_ms_;
+  queue_time_sum_ms_ -= time_in_non_paused_state_ms;
+
+  if (entry.older != kInvalid)
+    node(entry.older).newer = entry.newer;
+  else
+    oldest_node_ = entry.newer;
+  if (entry.newer != kInvalid)
+    node(entry.newer).older = entry.older;
+  else
+    newest_node_ = entry.older;
+
+  stream->deficit_bytes -= std::min(stream->deficit_bytes, entry.packet.bytes);
+  --stream->num_packets;
+  size_bytes_ -= entry.packet.bytes;
+  size_packets_ -= 1;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ms_ == 0);
+
+  if (stream->num_packets == 0) {
+    // An idle stream does not keep its unused share of the round.
+    Unschedule(pop_stream_);
+    stream->deficit_bytes = 0;
+  } else {
+    int priority = node(TopFifo(stream)->head).packet.priority;
+    if (priority != stream->scheduled_priority) {
+      Unschedule(pop_stream_);
+      Schedule(pop_stream_, priority);
+    }
+  }
+
+  FreeNode(pop_node_);
+  pop_node_ = kInvalid;
+  pop_stream_ = kInvalid;
+}
+
+bool PooledPacketQueue::Empty() const {
+  return size_packets_ == 0;
+}
+
+size_t PooledPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+uint64_t PooledPacketQueue::SizeInBytes() const {
+  return size_bytes_;
+}
+
+int64_t PooledPacketQueue::OldestEnqueueTimeMs() const {
+  if (Empty())
+    return 0;
+  RTC_CHECK(oldest_node_ != kInvalid);
+  return node(oldest_node_).enqueue_time_ms;
+}
+
+void PooledPacketQueue::UpdateQueueTime(int64_t timestamp_ms) {
+  RTC_CHECK_GE(timestamp_ms, time_last_updated_);
+  if (timestamp_ms == time_last_updated_)
+    return;
+
+  int64_t delta_ms = timestamp_ms - time_last_updated_;
+
+  if (paused_) {
+    pause_time_sum_ms_ += delta_ms;
+  } else {
+    queue_time_sum_ms_ += delta_ms * size_packets_;
+  }
+
+  time_last_updated_ = timestamp_ms;
+}
+
+void PooledPacketQueue::SetPauseState(bool paused, int64_t timestamp_ms) {
+  if (paused_ == paused)
+    return;
+  UpdateQueueTime(timestamp_ms);
+  paused_ = paused;
+}
+
+int64_t PooledPacketQueue::AverageQueueTimeMs() const {
+  if (Empty())
+    return 0;
+  return queue_time_sum_ms_ / size_packets_;
+}
+
+uint32_t PooledPacketQueue::AllocateNode() {
+  if (free_nodes_ == kInvalid) {
+    // Grow the pool by one block and thread it onto the free list.
+    uint32_t first =
+        static_cast<uint32_t>(node_blocks_.size()) * kNodesPerBlock;
+    node_blocks_.emplace_back(new Node[kNodesPerBlock]);
+    for (uint32_t i = 0; i + 1 < kNodesPerBlock; ++i)
+      node(first + i).next = first + i + 1;
+    node(first + kNodesPerBlock - 1).next = kInvalid;
+    free_nodes_ = first;
+  }
+  uint32_t index = free_nodes_;
+  free_nodes_ = node(index).next;
+  return index;
+}
+
+void PooledPacketQueue::FreeNode(uint32_t index) {
+  node(index).next = free_nodes_;
+  free_nodes_ = index;
+}
+
+uint32_t PooledPacketQueue::GetOrCreateStream(uint32_t ssrc) {
+  auto it = stream_index_by_ssrc_.find(ssrc);
+  if (it != stream_index_by_ssrc_.end())
+    return it->second;
+  uint32_t index = static_cast<uint32_t>(streams_.size());
+  streams_.emplace_back(ssrc);
+  stream_index_by_ssrc_.emplace(ssrc, index);
+  return index;
+}
+
+PooledPacketQueue::Fifo* PooledPacketQueue::TopFifo(Stream* stream) {
+  for (auto& fifos : stream->packets) {
+    for (Fifo& fifo : fifos) {
+      if (!fifo.empty())
+        return &fifo;
+    }
+  }
+  return nullptr;
+}
+
+PooledPacketQueue::Fifo* PooledPacketQueue::FifoFor(Stream* stream,
+                                                    const Packet& packet) {
+  return &stream->packets[packet.priority][packet.retransmission ? 0 : 1];
+}
+
+void PooledPacketQueue::Schedule(uint32_t stream_index, int priority) {
+  Stream& stream = streams_[stream_index];
+  RTC_DCHECK_EQ(stream.scheduled_priority, -1);
+  uint32_t& head = buckets_[priority];
+  if (head == kInvalid) {
+    head = stream_index;
+    stream.prev = stream_index;
+    stream.next = stream_index;
+    // The head of a bucket always holds the quantum for its current turn.
+    stream.deficit_bytes += kQuantumBytes;
+  } else {
+    // Insert at the back of the round, i.e. just before the head.
+    uint32_t tail = streams_[head].prev;
+    stream.prev = tail;
+    stream.next = head;
+    streams_[tail].next = stream_index;
+    streams_[head].prev = stream_index;
+  }
+  stream.scheduled_priority = priority;
+}
+
+void PooledPacketQueue::Unschedule(uint32_t stream_index) {
+  Stream& stream = streams_[stream_index];
+  RTC_DCHECK_NE(stream.scheduled_priority, -1);
+  uint32_t& head = buckets_[stream.scheduled_priority];
+  if (stream.next == stream_index) {
+    head = kInvalid;
+  } else {
+    streams_[stream.prev].next = stream.next;
+    streams_[stream.next].prev = stream.prev;
+    if (head == stream_index) {
+      head = stream.next;
+      streams_[head].deficit_bytes += kQuantumBytes;
+    }
+  }
+  stream.prev = kInvalid;
+  stream.next = kInvalid;
+  stream.scheduled_priority = -1;
+}
+
+uint32_t PooledPacketQueue::NextStream() {
+  for (uint32_t& head : buckets_) {
+    if (head == kInvalid)
+      continue;
+    // Deficit round robin: the stream at the head keeps sending while its
+    // deficit covers the next packet, then the turn passes on and the next
+    // stream is granted another quantum.
+    while (true) {
+      Stream& stream = streams_[head];
+      size_t bytes = node(TopFifo(&stream)->head).packet.bytes;
+      if (stream.deficit_bytes >= bytes)
+        return head;
+      head = stream.next;
+      streams_[head].deficit_bytes += kQuantumBytes;
+    }
+  }
+  RTC_NOTREACHED();
+  return kInvalid;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_POOLED_PACKET_QUEUE_H_
+#define MODULES_PACING_POOLED_PACKET_QUEUE_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "modules/pacing/packet_queue_interface.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+
+namespace webrtc {
+
+// Round robin packet queue that keeps packets in a pool of reusable nodes
+// linked by index, so that Push() and FinalizePop() do not allocate once the
+// pool and the set of streams have reached their steady-state size. The pool
+// grows in blocks, so nodes never move and the packet returned by BeginPop()
+// stays valid while other packets are pushed.
+//
+// Streams are scheduled in one bucket per priority level. Within a bucket,
+// streams take turns using deficit round robin with a quantum of
+// kQuantumBytes, which keeps streams sending at different packet sizes
+// byte-fair like RoundRobinPacketQueue. Within a stream, packets are ordered
+// by priority, retransmissions first, then in enqueue order.
+class PooledPacketQueue : public PacketQueueInterface {
+ public:
+  explicit PooledPacketQueue(const Clock* clock);
+  ~PooledPacketQueue() override;
+
+  using Packet = PacketQueueInterface::Packet;
+
+  void Push(const Packet& packet) override;
+  const Packet& BeginPop() override;
+  void CancelPop(const Packet& packet) override;
+  void FinalizePop(const Packet& packet) override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  uint64_t SizeInBytes() const override;
+
+  int64_t OldestEnqueueTimeMs() const override;
+  int64_t AverageQueueTimeMs() const override;
+  void UpdateQueueTime(int64_t timestamp_ms) override;
+  void SetPauseState(bool paused, int64_t timestamp_ms) override;
+
+ private:
+  static constexpr size_t kQuantumBytes = 1400;
+  // One bucket per RtpPacketSender::Priority value.
+  static constexpr int kNumPriorities = RtpPacketSender::kLowPriority + 1;
+  static constexpr uint32_t kInvalid = 0xffffffff;
+  static constexpr uint32_t kNodesPerBlock = 256;
+
+  // Intrusive FIFO of nodes, linked through Node::next.
+  struct Fifo {
+    bool empty() const { return head == kInvalid; }
+    uint32_t head = kInvalid;
+    uint32_t tail = kInvalid;
+  };
+
+  struct Node {
+    Node();
+
+    Packet packet;
+    // Enqueue time as pushed, before pause time is subtracted.
+    int64_t enqueue_time_ms = 0;
+    // Next packet of the same stream, priority and retransmission flag.
+    uint32_t next = kInvalid;
+    // Doubly linked list of all queued packets in push order, used to find
+    // the oldest one.
+    uint32_t older = kInvalid;
+    uint32_t newer = kInvalid;
+  };
+
+  struct Stream {
+    explicit Stream(uint32_t ssrc) : ssrc(ssrc) {}
+
+    uint32_t ssrc;
+    // Packets per priority, split into retransmissions [0] and others [1].
+    Fifo packets[kNumPriorities][2];
+    size_t num_packets = 0;
+    // Bytes this stream may still send in the current round.
+    size_t deficit_bytes = 0;
+    // Bucket the stream is scheduled in, or -1 if it has no packets.
+    int scheduled_priority = -1;
+    // Links within the scheduling bucket.
+    uint32_t prev = kInvalid;
+    uint32_t next = kInvalid;
+  };
+
+  Node& node(uint32_t index) {
+    return node_blocks_[index / kNodesPerBlock][index % kNodesPerBlock];
+  }
+  const Node& node(uint32_t index) const {
+    return node_blocks_[index / kNodesPerBlock][index % kNodesPerBlock];
+  }
+  uint32_t AllocateNode();
+  void FreeNode(uint32_t index);
+  uint32_t GetOrCreateStream(uint32_t ssrc);
+  // Returns the FIFO holding the next packet of |stream|, or null if the
+  // stream has no queued packets.
+  static Fifo* TopFifo(Stream* stream);
+  static Fifo* FifoFor(Stream* stream, const Packet& packet);
+  void Schedule(uint32_t stream_index, int priority);
+  void Unschedule(uint32_t stream_index);
+  // Picks the stream to send from next, advancing the round robin.
+  uint32_t NextStream();
+
+  const Clock* const clock_;
+  int64_t time_last_updated_;
+  bool paused_ = false;
+  size_t size_packets_ = 0;
+  size_t size_bytes_ = 0;
+  int64_t queue_time_sum_ms_ = 0;
+  int64_t pause_time_sum_ms_ = 0;
+
+  // Node currently handed out by BeginPop() and its stream, or kInvalid.
+  uint32_t pop_node_ = kInvalid;
+  uint32_t pop_stream_ = kInvalid;
+
+  std::vector<std::unique_ptr<Node[]>> node_blocks_;
+  uint32_t free_nodes_ = kInvalid;
+  uint32_t oldest_node_ = kInvalid;
+  uint32_t newest_node_ = kInvalid;
+
+  std::vector<Stream> streams_;
+  std::unordered_map<uint32_t, uint32_t> stream_index_by_ssrc_;
+  // Circular lists of scheduled streams, by priority; the head is served
+  // next.
+  uint32_t buckets_[kNumPriorities];
+};
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_POOLED_PACKET_QUEUE_H_
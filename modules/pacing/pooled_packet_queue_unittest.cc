@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_packet_queue.h"
+
+#include <stdio.h>
+
+#include <memory>
+
+#include "modules/pacing/packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
+#include "rtc_base/timeutils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kSsrc1 = 12345;
+constexpr uint32_t kSsrc2 = 67890;
+
+class PooledPacketQueueTest : public ::testing::Test {
+ protected:
+  PooledPacketQueueTest() : clock_(1000), queue_(&clock_) {}
+
+  void Push(RtpPacketSender::Priority priority,
+            uint32_t ssrc,
+            uint16_t sequence_number,
+            size_t bytes,
+            bool retransmission = false) {
+    queue_.Push(PacketQueueInterface::Packet(
+        priority, ssrc, sequence_number, clock_.TimeInMilliseconds(),
+        clock_.TimeInMilliseconds(), bytes, retransmission, enqueue_order_++));
+  }
+
+  // Pops the next packet and returns its ssrc and sequence number.
+  std::pair<uint32_t, uint16_t> Pop() {
+    const PacketQueueInterface::Packet& packet = queue_.BeginPop();
+    std::pair<uint32_t, uint16_t> result(packet.ssrc, packet.sequence_number);
+    queue_.FinalizePop(packet);
+    return result;
+  }
+
+  SimulatedClock clock_;
+  PooledPacketQueue queue_;
+  uint64_t enqueue_order_ = 0;
+};
+
+}  // namespace
+
+TEST_F(PooledPacketQueueTest, StartsEmpty) {
+  EXPECT_TRUE(queue_.Empty());
+  EXPECT_EQ(0u, queue_.SizeInPackets());
+  EXPECT_EQ(0u, queue_.SizeInBytes());
+  EXPECT_EQ(0, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(0, queue_.AverageQueueTimeMs());
+}
+
+TEST_F(PooledPacketQueueTest, HigherPriorityStreamGoesFirst) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 1, 100);
+  Push(RtpPacketSender::kLowPriority, kSsrc1, 2, 100);
+  Push(RtpPacketSender::kHighPriority, kSsrc2, 1, 100);
+  EXPECT_EQ(3u, queue_.SizeInPackets());
+  EXPECT_EQ(300u, queue_.SizeInBytes());
+
+  EXPECT_EQ(std::make_pair(kSsrc2, uint16_t{1}), Pop());
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{1}), Pop());
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{2}), Pop());
+  EXPECT_TRUE(queue_.Empty());
+}
+
+TEST_F(PooledPacketQueueTest, RetransmissionsGoFirstWithinStream) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 10, 100);
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 11, 100);
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 3, 100, true);
+
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{3}), Pop());
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{10}), Pop());
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{11}), Pop());
+}
+
+TEST_F(PooledPacketQueueTest, AlternatesBetweenStreams) {
+  for (uint16_t i = 0; i < 10; ++i) {
+    Push(RtpPacketSender::kNormalPriority, kSsrc1, i, 1200);
+    Push(RtpPacketSender::kNormalPriority, kSsrc2, i, 1200);
+  }
+  // With equally sized packets neither stream gets more than two turns in a
+  // row.
+  uint32_t last_ssrc = 0;
+  int run_length = 0;
+  for (int i = 0; i < 20; ++i) {
+    uint32_t ssrc = Pop().first;
+    run_length = (ssrc == last_ssrc) ? run_length + 1 : 1;
+    EXPECT_LE(run_length, 2);
+    last_ssrc = ssrc;
+  }
+  EXPECT_TRUE(queue_.Empty());
+}
+
+TEST_F(PooledPacketQueueTest, SharesBytesFairlyBetweenStreams) {
+  // Stream 1 sends four times larger packets than stream 2.
+  for (uint16_t i = 0; i < 100; ++i) {
+    Push(RtpPacketSender::kNormalPriority, kSsrc1, i, 1200);
+    for (int j = 0; j < 4; ++j)
+      Push(RtpPacketSender::kNormalPriority, kSsrc2, i * 4 + j, 300);
+  }
+  size_t bytes[2] = {0, 0};
+  for (int i = 0; i < 100; ++i) {
+    const PacketQueueInterface::Packet& packet = queue_.BeginPop();
+    bytes[packet.ssrc == kSsrc1 ? 0 : 1] += packet.bytes;
+    queue_.FinalizePop(packet);
+  }
+  // Deficit round robin keeps the streams within one quantum plus one
+  // packet of each other.
+  EXPECT_NEAR(bytes[0], bytes[1], 1400u + 1200u);
+}
+
+TEST_F(PooledPacketQueueTest, CancelPopKeepsPacketFirst) {
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 1, 100);
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 2, 100);
+
+  const PacketQueueInterface::Packet& packet = queue_.BeginPop();
+  EXPECT_EQ(1, packet.sequence_number);
+  // Packets pushed while a pop is outstanding must not disturb it.
+  for (uint16_t i = 3; i < 1000; ++i)
+    Push(RtpPacketSender::kNormalPriority, kSsrc2, i, 100);
+  EXPECT_EQ(1, packet.sequence_number);
+  queue_.CancelPop(packet);
+
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{1}), Pop());
+  EXPECT_EQ(998u, queue_.SizeInPackets());
+}
+
+TEST_F(PooledPacketQueueTest, TracksQueueTimeAndPauses) {
+  const int64_t start_ms = clock_.TimeInMilliseconds();
+  Push(RtpPacketSender::kNormalPriority, kSsrc1, 1, 100);
+  clock_.AdvanceTimeMilliseconds(10);
+  Push(RtpPacketSender::kNormalPriority, kSsrc2, 1, 100);
+  EXPECT_EQ(start_ms, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(5, queue_.AverageQueueTimeMs());
+
+  // Time spent paused does not count as queue time.
+  queue_.SetPauseState(true, clock_.TimeInMilliseconds());
+  clock_.AdvanceTimeMilliseconds(100);
+  queue_.SetPauseState(false, clock_.TimeInMilliseconds());
+  EXPECT_EQ(5, queue_.AverageQueueTimeMs());
+
+  queue_.UpdateQueueTime(clock_.TimeInMilliseconds());
+  EXPECT_EQ(std::make_pair(kSsrc1, uint16_t{1}), Pop());
+  EXPECT_EQ(start_ms + 10, queue_.OldestEnqueueTimeMs());
+  EXPECT_EQ(0, queue_.AverageQueueTimeMs());
+  Pop();
+  EXPECT_TRUE(queue_.Empty());
+}
+
+namespace {
+
+// Pushes and pops |kNumPackets| packets across |kNumStreams| streams, keeping
+// about |kQueueDepth| packets queued, and returns the time per packet in ns.
+double MeasurePushPop(PacketQueueInterface* queue, SimulatedClock* clock) {
+  constexpr int kNumPackets = 2000000;
+  constexpr int kNumStreams = 16;
+  constexpr int kQueueDepth = 500;
+  const RtpPacketSender::Priority kPriorities[] = {
+      RtpPacketSender::kHighPriority, RtpPacketSender::kNormalPriority,
+      RtpPacketSender::kNormalPriority, RtpPacketSender::kLowPriority};
+  uint64_t enqueue_order = 0;
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumPackets; ++i) {
+    if (i % 100 == 0) {
+      clock->AdvanceTimeMilliseconds(1);
+      queue->UpdateQueueTime(clock->TimeInMilliseconds());
+    }
+    queue->Push(PacketQueueInterface::Packet(
+        kPriorities[i % 4], i % kNumStreams, static_cast<uint16_t>(i),
+        clock->TimeInMilliseconds(), clock->TimeInMilliseconds(),
+        300 + (i % 5) * 200, i % 10 == 0, enqueue_order++));
+    if (i >= kQueueDepth)
+      queue->FinalizePop(queue->BeginPop());
+  }
+  while (!queue->Empty())
+    queue->FinalizePop(queue->BeginPop());
+  return static_cast<double>(rtc::TimeNanos() - start_ns) / kNumPackets;
+}
+
+}  // namespace
+
+// Compares push + pop cost of the three pacer queues. Disabled by default;
+// run manually.
+TEST(PacketQueuePerformanceTest, DISABLED_PushPop) {
+  SimulatedClock clock(1000);
+  PacketQueue packet_queue(&clock);
+  printf("PacketQueue: %.1f ns/packet\n",
+         MeasurePushPop(&packet_queue, &clock));
+  RoundRobinPacketQueue round_robin_queue(&clock);
+  printf("RoundRobinPacketQueue: %.1f ns/packet\n",
+         MeasurePushPop(&round_robin_queue, &clock));
+  PooledPacketQueue pooled_queue(&clock);
+  printf("PooledPacketQueue: %.1f ns/packet\n",
+         MeasurePushPop(&pooled_queue, &clock));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include "typedefs.h"  // NOLINT(build/include)
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#include <string.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+// Number of blocks that are XORed per pass over the destination. Every pass
+// loads and stores the destination once, so XORing several blocks per pass
+// saves memory traffic.
+constexpr size_t kMaxBlocksPerPass = 4;
+
+// XORs the first |length| bytes of each of the |num_srcs| sources into |dst|,
+// a 64-bit word at a time.
+void XorC(const uint8_t* const* srcs,
+          size_t num_srcs,
+          size_t length,
+          uint8_t* dst) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t x;
+    memcpy(&x, dst + i, sizeof(x));
+    for (size_t k = 0; k < num_srcs; ++k) {
+      uint64_t src;
+      memcpy(&src, srcs[k] + i, sizeof(src));
+      x ^= src;
+    }
+    memcpy(dst + i, &x, sizeof(x));
+  }
+  for (; i < length; ++i) {
+    uint8_t x = dst[i];
+    for (size_t k = 0; k < num_srcs; ++k) {
+      x ^= srcs[k][i];
+    }
+    dst[i] = x;
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorSse2(const uint8_t* const* srcs,
+             size_t num_srcs,
+             size_t length,
+             uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    for (size_t k = 0; k < num_srcs; ++k) {
+      x = _mm_xor_si128(
+          x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcs[k] + i)));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), x);
+  }
+  const uint8_t* tails[kMaxBlocksPerPass];
+  for (size_t k = 0; k < num_srcs; ++k) {
+    tails[k] = srcs[k] + i;
+  }
+  XorC(tails, num_srcs, length - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void XorNeon(const uint8_t* const* srcs,
+             size_t num_srcs,
+             size_t length,
+             uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    uint8x16_t x = vld1q_u8(dst + i);
+    for (size_t k = 0; k < num_srcs; ++k) {
+      x = veorq_u8(x, vld1q_u8(srcs[k] + i));
+    }
+    vst1q_u8(dst + i, x);
+  }
+  const uint8_t* tails[kMaxBlocksPerPass];
+  for (size_t k = 0; k < num_srcs; ++k) {
+    tails[k] = srcs[k] + i;
+  }
+  XorC(tails, num_srcs, length - i, dst + i);
+}
+#endif
+
+void Xor(FecXorOptimization optimization,
+         const uint8_t* const* srcs,
+         size_t num_srcs,
+         size_t length,
+         uint8_t* dst) {
+  RTC_DCHECK_LE(num_srcs, kMaxBlocksPerPass);
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case FecXorOptimization::kSse2:
+      XorSse2(srcs, num_srcs, length, dst);
+      return;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case FecXorOptimization::kNeon:
+      XorNeon(srcs, num_srcs, length, dst);
+      return;
+#endif
+    default:
+      XorC(srcs, num_srcs, length, dst);
+  }
+}
+
+}  // namespace
+
+std::vector<FecXorOptimization> AvailableFecXorOptimizations() {
+  std::vector<FecXorOptimization> optimizations = {FecXorOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(FecXorOptimization::kSse2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(FecXorOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
+FecXorOptimization DetectFecXorOptimization() {
+  static const FecXorOptimization optimization =
+      AvailableFecXorOptimizations().back();
+  return optimization;
+}
+
+void XorBlocks(FecXorOptimization optimization,
+               rtc::ArrayView<const FecXorBlock> srcs,
+               uint8_t* dst) {
+  for (size_t first = 0; first < srcs.size(); first += kMaxBlocksPerPass) {
+    const size_t num_srcs = std::min(kMaxBlocksPerPass, srcs.size() - first);
+    // XOR the part that all blocks of the pass have in common in one pass, and
+    // the rest of the longer blocks one by one.
+    const uint8_t* data[kMaxBlocksPerPass];
+    size_t common_length = srcs[first].length;
+    for (size_t k = 0; k < num_srcs; ++k) {
+      data[k] = srcs[first + k].data;
+      common_length = std::min(common_length, srcs[first + k].length);
+    }
+    Xor(optimization, data, num_srcs, common_length, dst);
+    for (size_t k = 0; k < num_srcs; ++k) {
+      const FecXorBlock& src = srcs[first + k];
+      if (src.length > common_length) {
+        const uint8_t* tail = src.data + common_length;
+        Xor(optimization, &tail, 1, src.length - common_length,
+            dst + common_length);
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
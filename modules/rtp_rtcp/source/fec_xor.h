@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// The XOR kernel used by ForwardErrorCorrection to generate FEC payloads and
+// to recover media packets, with SIMD implementations.
+enum class FecXorOptimization { kNone, kSse2, kNeon };
+
+// Returns the optimizations supported by the CPU, from worst to best, for
+// tests and benchmarks that compare them.
+std::vector<FecXorOptimization> AvailableFecXorOptimizations();
+
+// Returns the best optimization supported by the CPU. The CPU is only probed
+// on the first call.
+FecXorOptimization DetectFecXorOptimization();
+
+// A block of bytes to XOR into the destination.
+struct FecXorBlock {
+  const uint8_t* data;
+  size_t length;
+};
+
+// XORs every block of |srcs| into the start of |dst|, which must be at least as
+// long as the longest block. Several blocks are XORed per pass over |dst|.
+void XorBlocks(FecXorOptimization optimization,
+               rtc::ArrayView<const FecXorBlock> srcs,
+               uint8_t* dst);
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
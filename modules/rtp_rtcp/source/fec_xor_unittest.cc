@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxLength = 1500;
+
+std::vector<uint8_t> RandomBytes(size_t length, Random* random) {
+  std::vector<uint8_t> bytes(length);
+  for (uint8_t& byte : bytes) {
+    byte = random->Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+// XORs |num_blocks| blocks of random lengths into a random destination with
+// every optimization, and compares the result with a byte-wise XOR.
+void TestXorBlocks(size_t num_blocks, Random* random) {
+  std::vector<std::vector<uint8_t>> blocks;
+  std::vector<FecXorBlock> srcs;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    // Test lengths that aren't a multiple of the vector size, and blocks that
+    // don't start at an aligned address.
+    const size_t offset = random->Rand(0, 15);
+    blocks.push_back(RandomBytes(offset + random->Rand(0, kMaxLength), random));
+    srcs.push_back(
+        {blocks.back().data() + offset, blocks.back().size() - offset});
+  }
+  const std::vector<uint8_t> dst = RandomBytes(kMaxLength, random);
+
+  std::vector<uint8_t> expected = dst;
+  for (const FecXorBlock& src : srcs) {
+    for (size_t i = 0; i < src.length; ++i) {
+      expected[i] ^= src.data[i];
+    }
+  }
+
+  for (FecXorOptimization optimization : AvailableFecXorOptimizations()) {
+    SCOPED_TRACE(static_cast<int>(optimization));
+    std::vector<uint8_t> actual = dst;
+    XorBlocks(optimization, srcs, actual.data());
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+}  // namespace
+
+TEST(FecXorTest, XorsNothingWithoutBlocks) {
+  Random random(42);
+  TestXorBlocks(0, &random);
+}
+
+TEST(FecXorTest, XorsSingleBlock) {
+  Random random(42);
+  for (int i = 0; i < 100; ++i) {
+    TestXorBlocks(1, &random);
+  }
+}
+
+TEST(FecXorTest, XorsBlocksOfDifferentLengths) {
+  Random random(42);
+  for (size_t num_blocks = 2; num_blocks <= 48; ++num_blocks) {
+    SCOPED_TRACE(num_blocks);
+    TestXorBlocks(num_blocks, &random);
+  }
+}
+
+TEST(FecXorTest, XorsEmptyBlocks) {
+  const uint8_t src[] = {0xff};
+  const FecXorBlock srcs[] = {{src, 0}, {src, 1}, {src, 0}};
+  for (FecXorOptimization optimization : AvailableFecXorOptimizations()) {
+    uint8_t dst[] = {0x0f, 0x0f};
+    XorBlocks(optimization, srcs, dst);
+    EXPECT_EQ(0xf0, dst[0]);
+    EXPECT_EQ(0x0f, dst[1]);
+  }
+}
+
+}  // namespace webrtc
@@ -18,6 +18,7 @@
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -81,7 +82,8 @@ ForwardErrorCorrection::ForwardErrorCorrection(
       fec_header_reader_(std::move(fec_header_reader)),
       fec_header_writer_(std::move(fec_header_writer)),
       generated_fec_packets_(fec_header_writer_->MaxFecPackets()),
-      packet_mask_size_(0) {}
+      packet_mask_size_(0),
+      xor_optimization_(DetectFecXorOptimization()) {}
 
 ForwardErrorCorrection::~ForwardErrorCorrection() = default;
 
@@ -208,6 +210,10 @@ void ForwardErrorCorrection::GenerateFecPayloads(
     const size_t fec_header_size =
         fec_header_writer_->FecHeaderSize(min_packet_mask_size);
 
+    // The payloads of the protected packets, except for the first one which
+    // is copied, are XORed into the FEC packet together once all of them are
+    // known.
+    xor_blocks_.clear();
     size_t media_pkt_idx = 0;
     auto media_packets_it = media_packets.cbegin();
     uint16_t prev_seq_num = ParseSequenceNumber((*media_packets_it)->data);
@@ -240,8 +246,9 @@ void ForwardErrorCorrection::GenerateFecPayloads(
                  &media_packet->data[kRtpHeaderSize], media_payload_length);
         } else {
           XorHeaders(*media_packet, fec_packet);
-          XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                      fec_packet);
+          RTC_DCHECK_LE(fec_packet_length, sizeof(fec_packet->data));
+          xor_blocks_.push_back(
+              {&media_packet->data[kRtpHeaderSize], media_payload_length});
         }
       }
       media_packets_it++;
@@ -253,6 +260,8 @@ void ForwardErrorCorrection::GenerateFecPayloads(
       pkt_mask_idx += media_pkt_idx / 8;
       media_pkt_idx %= 8;
     }
+    XorBlocks(xor_optimization_, xor_blocks_,
+              &fec_packet->data[fec_header_size]);
     RTC_DCHECK_GT(fec_packet->length, 0)
         << "Packet mask is wrong or poorly designed.";
   }
@@ -604,33 +613,26 @@ void ForwardErrorCorrection::XorHeaders(const Packet& src, Packet* dst) {
   // Skip the 9th to 12th bytes of the header.
 }
 
-void ForwardErrorCorrection::XorPayloads(const Packet& src,
-                                         size_t payload_length,
-                                         size_t dst_offset,
-                                         Packet* dst) {
-  // XOR the payload.
-  RTC_DCHECK_LE(kRtpHeaderSize + payload_length, sizeof(src.data));
-  RTC_DCHECK_LE(dst_offset + payload_length, sizeof(dst->data));
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst->data[dst_offset + i] ^= src.data[kRtpHeaderSize + i];
-  }
-}
-
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
                                            RecoveredPacket* recovered_packet) {
   if (!StartPacketRecovery(fec_packet, recovered_packet)) {
     return false;
   }
+  xor_blocks_.clear();
   for (const auto& protected_packet : fec_packet.protected_packets) {
     if (protected_packet->pkt == nullptr) {
       // This is the packet we're recovering.
       recovered_packet->seq_num = protected_packet->seq_num;
     } else {
       XorHeaders(*protected_packet->pkt, recovered_packet->pkt);
-      XorPayloads(*protected_packet->pkt, protected_packet->pkt->length,
-                  kRtpHeaderSize, recovered_packet->pkt);
+      RTC_DCHECK_LE(kRtpHeaderSize + protected_packet->pkt->length,
+                    sizeof(protected_packet->pkt->data));
+      xor_blocks_.push_back({&protected_packet->pkt->data[kRtpHeaderSize],
+                             protected_packet->pkt->length});
     }
   }
+  XorBlocks(xor_optimization_, xor_blocks_,
+            &recovered_packet->pkt->data[kRtpHeaderSize]);
   if (!FinishPacketRecovery(fec_packet, recovered_packet)) {
     return false;
   }
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "rtc_base/constructormagic.h"
 #include "rtc_base/refcount.h"
@@ -302,22 +303,14 @@ class ForwardErrorCorrection {
   // the length recovery field.
   static void XorHeaders(const Packet& src, Packet* dst);
 
-  // Performs XOR between the payloads of |src| and |dst| and stores the result
-  // in |dst|. The parameter |dst_offset| determines at  what byte the
-  // XOR operation starts in |dst|. In total, |payload_length| bytes are XORed.
-  static void XorPayloads(const Packet& src,
-                          size_t payload_length,
-                          size_t dst_offset,
-                          Packet* dst);
-
   // Finalizes recovery of packet by setting RTP header fields.
   // This is not specific to the FEC scheme used.
   static bool FinishPacketRecovery(const ReceivedFecPacket& fec_packet,
                                    RecoveredPacket* recovered_packet);
 
   // Recover a missing packet.
-  static bool RecoverPacket(const ReceivedFecPacket& fec_packet,
-                            RecoveredPacket* recovered_packet);
+  bool RecoverPacket(const ReceivedFecPacket& fec_packet,
+                     RecoveredPacket* recovered_packet);
 
   // Get the number of missing media packets which are covered by |fec_packet|.
   // An FEC packet can recover at most one packet, and if zero packets are
@@ -345,6 +338,11 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+
+  const FecXorOptimization xor_optimization_;
+  // The payloads to XOR into the FEC packet being generated, or into the packet
+  // being recovered. Kept to avoid allocating memory for every packet.
+  std::vector<FecXorBlock> xor_blocks_;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
@@ -64,8 +64,12 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions)
 RtpPacket::RtpPacket(const RtpPacket&) = default;
 
 RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
-    : buffer_(capacity) {
-  RTC_DCHECK_GE(capacity, kFixedHeaderSize);
+    : RtpPacket(extensions, rtc::CopyOnWriteBuffer(capacity)) {}
+
+RtpPacket::RtpPacket(const ExtensionManager* extensions,
+                     rtc::CopyOnWriteBuffer buffer)
+    : buffer_(std::move(buffer)) {
+  RTC_DCHECK_GE(buffer_.capacity(), kFixedHeaderSize);
   Clear();
   if (extensions) {
     IdentifyExtensions(*extensions);
@@ -75,6 +79,12 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   }
 }
 
+RtpPacket::RtpPacket(const RtpPacket& packet, rtc::CopyOnWriteBuffer buffer)
+    : RtpPacket(packet) {
+  buffer.SetData(packet.data(), packet.size());
+  buffer_ = std::move(buffer);
+}
+
 RtpPacket::~RtpPacket() {}
 
 void RtpPacket::IdentifyExtensions(const ExtensionManager& extensions) {
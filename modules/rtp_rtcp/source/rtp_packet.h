@@ -36,6 +36,11 @@ class RtpPacket {
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const RtpPacket&);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
+  // Builds the packet in |buffer|, with the capacity of |buffer|, e.g. to use
+  // a buffer from a pool.
+  RtpPacket(const ExtensionManager* extensions, rtc::CopyOnWriteBuffer buffer);
+  // Copies |packet| into |buffer| rather than sharing the buffer of |packet|.
+  RtpPacket(const RtpPacket& packet, rtc::CopyOnWriteBuffer buffer);
   ~RtpPacket();
 
   RtpPacket& operator=(const RtpPacket&) = default;
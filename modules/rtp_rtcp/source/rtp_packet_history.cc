@@ -25,6 +25,20 @@ namespace {
 // Min packet size for BestFittingPacket() to honor.
 constexpr size_t kMinPacketRequestBytes = 50;
 
+// Bounds for the size of the packet ring. The sizes are powers of two that
+// divide 2^16, so sequence numbers map to the same slot across wrap-around.
+constexpr size_t kMinRingSize = 16;
+constexpr size_t kMaxRingSize = 1 << 14;
+static_assert(kMaxRingSize >= RtpPacketHistory::kMaxCapacity,
+              "Ring must be able to hold kMaxCapacity packets.");
+
+size_t RingSizeFor(size_t number_to_store) {
+  size_t size = kMinRingSize;
+  while (size < number_to_store && size < kMaxRingSize)
+    size *= 2;
+  return size;
+}
+
 // Utility function to get the absolute difference in size between the provided
 // target size and the size of packet.
 size_t SizeDiff(const std::unique_ptr<RtpPacketToSend>& packet, size_t size) {
@@ -55,7 +69,9 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock)
     : clock_(clock),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
-      rtt_ms_(-1) {}
+      rtt_ms_(-1),
+      num_packets_(0),
+      end_seqno_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -96,9 +112,13 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
-  StoredPacket& stored_packet = packet_history_[rtp_seq_no];
+  MakeRoomFor(rtp_seq_no);
+  StoredPacket& stored_packet =
+      packet_history_[rtp_seq_no & (packet_history_.size() - 1)];
   RTC_DCHECK(stored_packet.packet == nullptr);
   stored_packet.packet = std::move(packet);
+  stored_packet.sequence_number = rtp_seq_no;
+  ++num_packets_;
 
   if (stored_packet.packet->capture_time_ms() <= 0) {
     stored_packet.packet->set_capture_time_ms(now_ms);
@@ -106,10 +126,6 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   stored_packet.send_time_ms = send_time_ms;
   stored_packet.storage_type = type;
   stored_packet.times_retransmitted = 0;
-
-  if (!start_seqno_) {
-    start_seqno_ = rtp_seq_no;
-  }
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
@@ -121,13 +137,13 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
-  StoredPacketIterator rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  StoredPacket* stored_packet = FindPacket(sequence_number);
+  if (!stored_packet) {
     return nullptr;
   }
 
-  StoredPacket& packet = rtp_it->second;
-  if (verify_rtt && !VerifyRtt(rtp_it->second, now_ms)) {
+  StoredPacket& packet = *stored_packet;
+  if (verify_rtt && !VerifyRtt(packet, now_ms)) {
     return nullptr;
   }
 
@@ -141,7 +157,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   if (packet.storage_type == StorageType::kDontRetransmit) {
     // Non retransmittable packet, so call must come from paced sender.
     // Remove from history and return actual packet instance.
-    return RemovePacket(rtp_it);
+    return RemovePacket(stored_packet);
   }
   return rtc::MakeUnique<RtpPacketToSend>(*packet.packet);
 }
@@ -154,16 +170,16 @@ rtc::Optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     return rtc::nullopt;
   }
 
-  auto rtp_it = packet_history_.find(sequence_number);
-  if (rtp_it == packet_history_.end()) {
+  const StoredPacket* stored_packet = FindPacket(sequence_number);
+  if (!stored_packet) {
     return rtc::nullopt;
   }
 
-  if (verify_rtt && !VerifyRtt(rtp_it->second, clock_->TimeInMilliseconds())) {
+  if (verify_rtt && !VerifyRtt(*stored_packet, clock_->TimeInMilliseconds())) {
     return rtc::nullopt;
   }
 
-  return StoredPacketToPacketState(rtp_it->second);
+  return StoredPacketToPacketState(*stored_packet);
 }
 
 bool RtpPacketHistory::VerifyRtt(const RtpPacketHistory::StoredPacket& packet,
@@ -186,17 +202,26 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetBestFittingPacket(
     size_t packet_length) const {
   // TODO(sprang): Make this smarter, taking retransmit count etc into account.
   rtc::CritScope cs(&lock_);
-  if (packet_length < kMinPacketRequestBytes || packet_history_.empty()) {
+  if (packet_length < kMinPacketRequestBytes || num_packets_ == 0) {
     return nullptr;
   }
 
+  // Only visit the slots from the oldest to the latest packet, stopping once
+  // all packets have been seen, rather than the whole ring.
   size_t min_diff = std::numeric_limits<size_t>::max();
   RtpPacketToSend* best_packet = nullptr;
-  for (auto& it : packet_history_) {
-    size_t diff = SizeDiff(it.second.packet, packet_length);
+  size_t packets_left = num_packets_;
+  for (uint16_t sequence_number = *start_seqno_; packets_left > 0;
+       ++sequence_number) {
+    const StoredPacket* stored_packet = FindPacket(sequence_number);
+    if (!stored_packet) {
+      continue;
+    }
+    --packets_left;
+    size_t diff = SizeDiff(stored_packet->packet, packet_length);
     if (!min_diff || diff < min_diff) {
       min_diff = diff;
-      best_packet = it.second.packet.get();
+      best_packet = stored_packet->packet.get();
       if (diff == 0) {
         break;
       }
@@ -208,24 +233,25 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetBestFittingPacket(
 
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
+  num_packets_ = 0;
   start_seqno_.reset();
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    auto stored_packet_it = packet_history_.find(*start_seqno_);
-    RTC_DCHECK(stored_packet_it != packet_history_.end());
+  while (num_packets_ > 0) {
+    StoredPacket* oldest_packet = FindPacket(*start_seqno_);
+    RTC_DCHECK(oldest_packet);
 
-    if (packet_history_.size() >= kMaxCapacity) {
+    if (num_packets_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
-      RemovePacket(stored_packet_it);
+      RemovePacket(oldest_packet);
       continue;
     }
 
-    const StoredPacket& stored_packet = stored_packet_it->second;
+    const StoredPacket& stored_packet = *oldest_packet;
     if (!stored_packet.send_time_ms) {
       // Don't remove packets that have not been sent.
       return;
@@ -236,14 +262,14 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_packets_ >= number_to_store_ ||
         (mode_ == StorageMode::kStoreAndCull &&
          *stored_packet.send_time_ms +
                  (packet_duration_ms * kPacketCullingDelayFactor) <=
              now_ms)) {
       // Too many packets in history, or this packet has timed out. Remove it
       // and continue.
-      RemovePacket(stored_packet_it);
+      RemovePacket(oldest_packet);
     } else {
       // No more packets can be removed right now.
       return;
@@ -251,25 +277,125 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   }
 }
 
+RtpPacketHistory::StoredPacket* RtpPacketHistory::FindPacket(
+    uint16_t sequence_number) {
+  if (num_packets_ == 0) {
+    return nullptr;
+  }
+  StoredPacket& stored_packet =
+      packet_history_[sequence_number & (packet_history_.size() - 1)];
+  if (!stored_packet.packet ||
+      stored_packet.sequence_number != sequence_number) {
+    return nullptr;
+  }
+  return &stored_packet;
+}
+
+const RtpPacketHistory::StoredPacket* RtpPacketHistory::FindPacket(
+    uint16_t sequence_number) const {
+  return const_cast<RtpPacketHistory*>(this)->FindPacket(sequence_number);
+}
+
+void RtpPacketHistory::MakeRoomFor(uint16_t sequence_number) {
+  if (packet_history_.empty()) {
+    packet_history_.resize(RingSizeFor(number_to_store_));
+  }
+  if (num_packets_ == 0) {
+    start_seqno_ = sequence_number;
+    end_seqno_ = sequence_number;
+    return;
+  }
+
+  // Sequence numbers less than half the sequence number space ahead of
+  // |end_seqno_| are newer than all stored packets, the others older.
+  const uint16_t ahead = sequence_number - end_seqno_;
+  if (ahead < 0x8000) {
+    // The new packet extends the window forward. Packets that the ring can't
+    // span together with it are dropped from the old end; on a jump larger
+    // than the ring that is all of them.
+    while (static_cast<uint16_t>(end_seqno_ - *start_seqno_) + size_t{ahead} >=
+               packet_history_.size() &&
+           packet_history_.size() < kMaxRingSize) {
+      GrowRing();
+    }
+    while (num_packets_ > 0 &&
+           static_cast<uint16_t>(end_seqno_ - *start_seqno_) + size_t{ahead} >=
+               packet_history_.size()) {
+      RemovePacket(FindPacket(*start_seqno_));
+    }
+    if (num_packets_ == 0) {
+      start_seqno_ = sequence_number;
+    }
+    end_seqno_ = sequence_number;
+    return;
+  }
+
+  if (static_cast<uint16_t>(sequence_number - *start_seqno_) <=
+      static_cast<uint16_t>(end_seqno_ - *start_seqno_)) {
+    // Within the window, e.g. put out of order.
+    return;
+  }
+
+  // Older than all stored packets. The window extends backward, and packets
+  // the ring can't span together with the new one are dropped from the new
+  // end, so that a stream that restarts at a lower sequence number is stored
+  // just like one that jumps ahead.
+  while (static_cast<uint16_t>(end_seqno_ - sequence_number) >=
+             packet_history_.size() &&
+         packet_history_.size() < kMaxRingSize) {
+    GrowRing();
+  }
+  while (num_packets_ > 0 &&
+         static_cast<uint16_t>(end_seqno_ - sequence_number) >=
+             packet_history_.size()) {
+    RemovePacket(FindPacket(end_seqno_));
+  }
+  start_seqno_ = sequence_number;
+  if (num_packets_ == 0) {
+    end_seqno_ = sequence_number;
+  }
+}
+
+void RtpPacketHistory::GrowRing() {
+  // All packets lie within the old size from |start_seqno_|, so they cannot
+  // collide in the new ring.
+  std::vector<StoredPacket> new_history(packet_history_.size() * 2);
+  for (StoredPacket& stored_packet : packet_history_) {
+    if (stored_packet.packet) {
+      new_history[stored_packet.sequence_number & (new_history.size() - 1)] =
+          std::move(stored_packet);
+    }
+  }
+  packet_history_.swap(new_history);
+}
+
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    StoredPacketIterator packet_it) {
-  // Move the packet out from the StoredPacket container.
+    StoredPacket* stored_packet) {
+  RTC_DCHECK(stored_packet);
+  // Move the packet out from the StoredPacket container, leaving the slot
+  // free for reuse.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_it->second.packet);
-  // Erase the packet from the map, and capture iterator to the next one.
-  StoredPacketIterator next_it = packet_history_.erase(packet_it);
-
-  // |next_it| now points to the next element, or to the end. If the end,
-  // check if we can wrap around.
-  if (next_it == packet_history_.end()) {
-    next_it = packet_history_.begin();
-  }
+      std::move(stored_packet->packet);
+  stored_packet->send_time_ms.reset();
+  --num_packets_;
 
-  // Update |start_seq_no| to the new oldest item.
-  if (next_it != packet_history_.end()) {
-    start_seqno_ = next_it->first;
-  } else {
+  if (num_packets_ == 0) {
     start_seqno_.reset();
+  } else if (stored_packet->sequence_number == *start_seqno_) {
+    // Update |start_seq_no| to the new oldest item. All packets lie within
+    // one ring size from the old start, so the scan ends within the ring.
+    uint16_t sequence_number = *start_seqno_;
+    do {
+      ++sequence_number;
+    } while (!FindPacket(sequence_number));
+    start_seqno_ = sequence_number;
+  } else if (stored_packet->sequence_number == end_seqno_) {
+    // Likewise for |end_seqno_|, scanning backwards.
+    uint16_t sequence_number = end_seqno_;
+    do {
+      --sequence_number;
+    } while (!FindPacket(sequence_number));
+    end_seqno_ = sequence_number;
   }
 
   return rtp_packet;
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <map>
 #include <memory>
 #include <vector>
 
@@ -110,21 +109,37 @@ class RtpPacketHistory {
     // only used as temporary storage until sent by the pacer sender.
     StorageType storage_type = kDontRetransmit;
 
-    // The actual packet.
+    // Sequence number of |packet|, cached to avoid touching the packet when
+    // looking up a slot.
+    uint16_t sequence_number = 0;
+
+    // The actual packet, or null if this slot is free.
     std::unique_ptr<RtpPacketToSend> packet;
   };
 
-  using StoredPacketIterator = std::map<uint16_t, StoredPacket>::iterator;
-
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
   // check if packet has too recently been sent.
   bool VerifyRtt(const StoredPacket& packet, int64_t now_ms) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void Reset() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the slot holding |sequence_number|, or null if not stored.
+  StoredPacket* FindPacket(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket* FindPacket(uint16_t sequence_number) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Makes sure |sequence_number| fits in the ring together with the packets
+  // already stored, growing the ring or, once it is at its maximum size,
+  // dropping the stored packets that fall outside the ring's window. Whether
+  // the new packet is newer or older is decided against |end_seqno_|; the
+  // packets dropped are those at the other end of the window.
+  void MakeRoomFor(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Moves all packets into a ring twice the size.
+  void GrowRing() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(StoredPacketIterator packet)
+  std::unique_ptr<RtpPacketToSend> RemovePacket(StoredPacket* packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   static PacketState StoredPacketToPacketState(
       const StoredPacket& stored_packet);
@@ -135,12 +150,19 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
 
-  // Map from rtp sequence numbers to stored packet.
-  std::map<uint16_t, StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Ring of stored packets, indexed by rtp sequence number modulo its size.
+  // The size is a power of two, so indexing is unaffected by sequence number
+  // wrap-around, and all stored packets lie within one ring size from
+  // |start_seqno_|. Slots are reused, so storing a packet does not allocate
+  // once the ring has reached its working size.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  size_t num_packets_ RTC_GUARDED_BY(lock_);
 
   // The earliest packet in the history. This might not be the lowest sequence
   // number, in case there is a wraparound.
   rtc::Optional<uint16_t> start_seqno_ RTC_GUARDED_BY(lock_);
+  // The latest packet in the history, set whenever |start_seqno_| is.
+  uint16_t end_seqno_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
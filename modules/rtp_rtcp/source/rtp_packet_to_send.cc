@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 
+#include <utility>
+
 namespace webrtc {
 
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions)
@@ -17,7 +19,15 @@ RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions)
 RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions,
                                  size_t capacity)
     : RtpPacket(extensions, capacity) {}
+RtpPacketToSend::RtpPacketToSend(const ExtensionManager* extensions,
+                                 rtc::CopyOnWriteBuffer buffer)
+    : RtpPacket(extensions, std::move(buffer)) {}
 RtpPacketToSend::RtpPacketToSend(const RtpPacketToSend& packet) = default;
+RtpPacketToSend::RtpPacketToSend(const RtpPacketToSend& packet,
+                                 rtc::CopyOnWriteBuffer buffer)
+    : RtpPacket(packet, std::move(buffer)),
+      capture_time_ms_(packet.capture_time_ms_),
+      application_data_(packet.application_data_) {}
 RtpPacketToSend::RtpPacketToSend(RtpPacketToSend&& packet) = default;
 
 RtpPacketToSend& RtpPacketToSend::operator=(const RtpPacketToSend& packet) =
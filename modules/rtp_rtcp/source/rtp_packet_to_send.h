@@ -22,7 +22,10 @@ class RtpPacketToSend : public RtpPacket {
  public:
   explicit RtpPacketToSend(const ExtensionManager* extensions);
   RtpPacketToSend(const ExtensionManager* extensions, size_t capacity);
+  RtpPacketToSend(const ExtensionManager* extensions,
+                  rtc::CopyOnWriteBuffer buffer);
   RtpPacketToSend(const RtpPacketToSend& packet);
+  RtpPacketToSend(const RtpPacketToSend& packet, rtc::CopyOnWriteBuffer buffer);
   RtpPacketToSend(RtpPacketToSend&& packet);
 
   RtpPacketToSend& operator=(const RtpPacketToSend& packet);
@@ -49,6 +49,10 @@ constexpr int kBitrateStatisticsWindowMs = 1000;
 
 constexpr size_t kMinFlexfecPacketsToStoreForPacing = 50;
 
+// Packet buffers return to the pool once sent, or once evicted from the send
+// history, so the free buffers only need to cover bursts.
+constexpr size_t kMaxFreePacketBuffers = 64;
+
 template <typename Extension>
 constexpr RtpExtensionSize CreateExtensionSize() {
   return {Extension::kId, Extension::kValueSizeBytes};
@@ -126,6 +130,9 @@ RTPSender::RTPSender(
       transport_(transport),
       sending_media_(true),                   // Default to sending media.
       max_packet_size_(IP_PACKET_SIZE - 28),  // Default is IP-v4/UDP.
+      packet_buffer_pool_(
+          rtc::ReceiveBufferPool::Create(max_packet_size_,
+                                         kMaxFreePacketBuffers)),
       last_payload_type_(-1),
       payload_type_map_(),
       rtp_header_extension_map_(),
@@ -311,7 +318,13 @@ void RTPSender::SetMaxRtpPacketSize(size_t max_packet_size) {
   RTC_DCHECK_GE(max_packet_size, 100);
   RTC_DCHECK_LE(max_packet_size, IP_PACKET_SIZE);
   rtc::CritScope lock(&send_critsect_);
+  if (max_packet_size == max_packet_size_)
+    return;
   max_packet_size_ = max_packet_size;
+  // Buffers of the previous size still in use return to the old pool, which
+  // they keep alive until then.
+  packet_buffer_pool_ =
+      rtc::ReceiveBufferPool::Create(max_packet_size_, kMaxFreePacketBuffers);
 }
 
 size_t RTPSender::MaxRtpPacketSize() const {
@@ -1068,10 +1081,25 @@ void RTPSender::GetDataCounters(StreamDataCounters* rtp_stats,
   *rtx_stats = rtx_rtp_stats_;
 }
 
+std::unique_ptr<RtpPacketToSend> RTPSender::CopyPacket(
+    const RtpPacketToSend& packet) const {
+  rtc::CopyOnWriteBuffer buffer;
+  {
+    rtc::CritScope lock(&send_critsect_);
+    buffer = packet_buffer_pool_->Get();
+  }
+  return rtc::MakeUnique<RtpPacketToSend>(packet, std::move(buffer));
+}
+
+size_t RTPSender::allocated_packet_buffers() const {
+  rtc::CritScope lock(&send_critsect_);
+  return packet_buffer_pool_->allocated_buffers();
+}
+
 std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket() const {
   rtc::CritScope lock(&send_critsect_);
-  std::unique_ptr<RtpPacketToSend> packet(
-      new RtpPacketToSend(&rtp_header_extension_map_, max_packet_size_));
+  std::unique_ptr<RtpPacketToSend> packet(new RtpPacketToSend(
+      &rtp_header_extension_map_, packet_buffer_pool_->Get()));
   RTC_DCHECK(ssrc_);
   packet->SetSsrc(*ssrc_);
   packet->SetCsrcs(csrcs_);
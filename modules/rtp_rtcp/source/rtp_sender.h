@@ -33,6 +33,7 @@
 #include "rtc_base/deprecation.h"
 #include "rtc_base/random.h"
 #include "rtc_base/rate_statistics.h"
+#include "rtc_base/receivebufferpool.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -159,6 +160,13 @@ class RTPSender {
   // Create empty packet, fills ssrc, csrcs and reserve place for header
   // extensions RtpSender updates before sending.
   std::unique_ptr<RtpPacketToSend> AllocatePacket() const;
+  // Returns a copy of |packet| that does not share its buffer, e.g. to build
+  // the packets of a frame from a common header.
+  std::unique_ptr<RtpPacketToSend> CopyPacket(
+      const RtpPacketToSend& packet) const;
+  // Number of packet buffers allocated at the current max packet size, for
+  // tests.
+  size_t allocated_packet_buffers() const;
   // Allocate sequence number for provided packet.
   // Save packet's fields to generate padding that doesn't break media stream.
   // Return false if sending was turned off.
@@ -276,6 +284,10 @@ class RTPSender {
   bool sending_media_ RTC_GUARDED_BY(send_critsect_);
 
   size_t max_packet_size_;
+  // Buffers of |max_packet_size_| bytes that packets are built in, so that
+  // sending does not allocate per packet in the steady state.
+  rtc::scoped_refptr<rtc::ReceiveBufferPool> packet_buffer_pool_
+      RTC_GUARDED_BY(send_critsect_);
 
   int8_t last_payload_type_ RTC_GUARDED_BY(send_critsect_);
   std::map<int8_t, RtpUtility::Payload*> payload_type_map_;
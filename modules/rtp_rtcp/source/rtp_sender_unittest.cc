@@ -995,6 +995,32 @@ TEST_P(RtpSenderTestWithoutPacer, SendGenericVideo) {
   EXPECT_THAT(sent_payload.subview(1), ElementsAreArray(payload));
 }
 
+TEST_P(RtpSenderTestWithoutPacer, SendingVideoReusesPacketBuffers) {
+  char payload_name[RTP_PAYLOAD_NAME_SIZE] = "GENERIC";
+  const uint8_t payload_type = 127;
+  ASSERT_EQ(0, rtp_sender_->RegisterPayload(payload_name, payload_type, 90000,
+                                            0, 1500));
+  // Large enough to be split into several packets.
+  const uint8_t payload[4 * kMaxPacketLength] = {};
+  uint32_t timestamp = 1234;
+  auto send_frame = [&] {
+    timestamp += 3000;
+    ASSERT_TRUE(rtp_sender_->SendOutgoingData(
+        kVideoFrameDelta, payload_type, timestamp, timestamp / 90, payload,
+        sizeof(payload), nullptr, nullptr, nullptr,
+        kDefaultExpectedRetransmissionTimeMs));
+  };
+
+  send_frame();
+  const size_t allocated_packet_buffers =
+      rtp_sender_->allocated_packet_buffers();
+  EXPECT_GT(allocated_packet_buffers, 0u);
+
+  for (int i = 0; i < 30; ++i)
+    send_frame();
+  EXPECT_EQ(allocated_packet_buffers, rtp_sender_->allocated_packet_buffers());
+}
+
 TEST_P(RtpSenderTest, SendFlexfecPackets) {
   constexpr int kMediaPayloadType = 127;
   constexpr int kFlexfecPayloadType = 118;
@@ -124,8 +124,8 @@ void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
   uint32_t rtp_timestamp = media_packet->Timestamp();
   uint16_t media_seq_num = media_packet->SequenceNumber();
 
-  std::unique_ptr<RtpPacketToSend> red_packet(
-      new RtpPacketToSend(*media_packet));
+  std::unique_ptr<RtpPacketToSend> red_packet =
+      rtp_sender_->CopyPacket(*media_packet);
   BuildRedPayload(*media_packet, red_packet.get());
 
   std::vector<std::unique_ptr<RedPacket>> fec_packets;
@@ -167,8 +167,8 @@ void RTPSenderVideo::SendVideoPacketAsRedMaybeWithUlpfec(
   for (const auto& fec_packet : fec_packets) {
     // TODO(danilchap): Make ulpfec_generator_ generate RtpPacketToSend to avoid
     // reparsing them.
-    std::unique_ptr<RtpPacketToSend> rtp_packet(
-        new RtpPacketToSend(*media_packet));
+    std::unique_ptr<RtpPacketToSend> rtp_packet =
+        rtp_sender_->CopyPacket(*media_packet);
     RTC_CHECK(rtp_packet->Parse(fec_packet->data(), fec_packet->length()));
     rtp_packet->set_capture_time_ms(media_packet->capture_time_ms());
     uint16_t fec_sequence_number = rtp_packet->SequenceNumber();
@@ -304,7 +304,7 @@ bool RTPSenderVideo::SendVideo(enum VideoCodecType video_type,
   rtp_header->SetPayloadType(payload_type);
   rtp_header->SetTimestamp(rtp_timestamp);
   rtp_header->set_capture_time_ms(capture_time_ms);
-  auto last_packet = rtc::MakeUnique<RtpPacketToSend>(*rtp_header);
+  auto last_packet = rtp_sender_->CopyPacket(*rtp_header);
 
   size_t fec_packet_overhead;
   bool red_enabled;
@@ -383,7 +383,7 @@ bool RTPSenderVideo::SendVideo(enum VideoCodecType video_type,
   for (size_t i = 0; i < num_packets; ++i) {
     bool last = (i + 1) == num_packets;
     auto packet = last ? std::move(last_packet)
-                       : rtc::MakeUnique<RtpPacketToSend>(*rtp_header);
+                       : rtp_sender_->CopyPacket(*rtp_header);
     if (!packetizer->NextPacket(packet.get()))
       return false;
     RTC_DCHECK_LE(packet->payload_size(),
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * Throughput of FEC generation and of the XOR kernel, in MB of protected
+ * media per second.
+ */
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
+#include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFlexfecSsrc = 5678;
+constexpr int kNumIterations = 2000;
+constexpr size_t kMinPacketSize = 1000;
+constexpr size_t kMaxPacketSize = 1200;
+
+double MegabytesPerSecond(size_t bytes, int64_t elapsed_us) {
+  return static_cast<double>(bytes) / std::max<int64_t>(elapsed_us, 1);
+}
+
+void RunEncodeBenchmark(const std::string& fec_name,
+                        ForwardErrorCorrection* fec,
+                        int num_media_packets,
+                        int protection_percent) {
+  Random random(42);
+  fec::MediaPacketGenerator generator(kMinPacketSize, kMaxPacketSize,
+                                      kMediaSsrc, &random);
+  ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(num_media_packets);
+  size_t media_bytes = 0;
+  for (const auto& media_packet : media_packets) {
+    media_bytes += media_packet->length;
+  }
+  const uint8_t protection_factor = protection_percent * 256 / 100;
+
+  std::list<ForwardErrorCorrection::Packet*> fec_packets;
+  const int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    fec_packets.clear();
+    EXPECT_EQ(0, fec->EncodeFec(media_packets, protection_factor, 0, false,
+                                kFecMaskBursty, &fec_packets));
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  EXPECT_FALSE(fec_packets.empty());
+
+  PrintResult("fec_encode_throughput",
+              "_" + std::to_string(num_media_packets) + "_packets_" +
+                  std::to_string(protection_percent) + "_percent",
+              fec_name,
+              MegabytesPerSecond(media_bytes * kNumIterations, elapsed_us),
+              "MB/s", false);
+}
+
+std::string OptimizationName(FecXorOptimization optimization) {
+  switch (optimization) {
+    case FecXorOptimization::kSse2:
+      return "sse2";
+    case FecXorOptimization::kNeon:
+      return "neon";
+    default:
+      return "c";
+  }
+}
+
+}  // namespace
+
+// Measures FEC generation for a 4 Mbps screenshare stream, for frames of
+// 12 to 48 packets at 20% and 30% protection.
+TEST(FecPerformanceTest, EncodeThroughput) {
+  std::unique_ptr<ForwardErrorCorrection> ulpfec =
+      ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  std::unique_ptr<ForwardErrorCorrection> flexfec =
+      ForwardErrorCorrection::CreateFlexfec(kFlexfecSsrc, kMediaSsrc);
+  for (int num_media_packets : {12, 24, 48}) {
+    for (int protection_percent : {20, 30}) {
+      RunEncodeBenchmark("ulpfec", ulpfec.get(), num_media_packets,
+                         protection_percent);
+      RunEncodeBenchmark("flexfec", flexfec.get(), num_media_packets,
+                         protection_percent);
+    }
+  }
+}
+
+// Measures the XOR kernel alone, XORing 1 to 48 packets into one FEC packet,
+// for each optimization supported by the CPU.
+TEST(FecPerformanceTest, XorThroughput) {
+  Random random(42);
+  std::vector<std::vector<uint8_t>> payloads(48);
+  for (auto& payload : payloads) {
+    payload.resize(kMaxPacketSize);
+    for (uint8_t& byte : payload) {
+      byte = random.Rand<uint8_t>();
+    }
+  }
+  std::vector<uint8_t> dst(kMaxPacketSize);
+
+  for (FecXorOptimization optimization : AvailableFecXorOptimizations()) {
+    for (size_t num_blocks : {1, 4, 12, 48}) {
+      std::vector<FecXorBlock> srcs;
+      for (size_t i = 0; i < num_blocks; ++i) {
+        srcs.push_back({payloads[i].data(), payloads[i].size()});
+      }
+      const int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < 10 * kNumIterations; ++i) {
+        XorBlocks(optimization, srcs, dst.data());
+      }
+      const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      PrintResult("fec_xor_throughput",
+                  "_" + std::to_string(num_blocks) + "_packets",
+                  OptimizationName(optimization),
+                  MegabytesPerSecond(10 * kNumIterations * num_blocks *
+                                         kMaxPacketSize,
+                                     elapsed_us),
+                  "MB/s", false);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -211,6 +211,7 @@ LibvpxVp8Encoder::LibvpxVp8Encoder()
   temporal_layers_checkers_.reserve(kMaxSimulcastStreams);
   raw_images_.reserve(kMaxSimulcastStreams);
   encoded_images_.reserve(kMaxSimulcastStreams);
+  encoded_buffers_.reserve(kMaxSimulcastStreams);
   send_stream_.reserve(kMaxSimulcastStreams);
   cpu_speed_.assign(kMaxSimulcastStreams, cpu_speed_default_);
   encoders_.reserve(kMaxSimulcastStreams);
@@ -225,11 +226,8 @@ LibvpxVp8Encoder::~LibvpxVp8Encoder() {
 int LibvpxVp8Encoder::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
-  while (!encoded_images_.empty()) {
-    EncodedImage& image = encoded_images_.back();
-    delete[] image._buffer;
-    encoded_images_.pop_back();
-  }
+  encoded_images_.clear();
+  encoded_buffers_.clear();
   while (!encoders_.empty()) {
     vpx_codec_ctx_t& encoder = encoders_.back();
     if (inited_) {
@@ -398,6 +396,7 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   }
 
   encoded_images_.resize(number_of_streams);
+  encoded_buffers_.resize(number_of_streams);
   encoders_.resize(number_of_streams);
   configurations_.resize(number_of_streams);
   downsampling_factors_.resize(number_of_streams);
@@ -421,13 +420,11 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     downsampling_factors_[number_of_streams - 1].den = 1;
   }
   for (int i = 0; i < number_of_streams; ++i) {
-    // allocate memory for encoded image
-    if (encoded_images_[i]._buffer != NULL) {
-      delete[] encoded_images_[i]._buffer;
-    }
-    encoded_images_[i]._size =
-        CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
-    encoded_images_[i]._buffer = new uint8_t[encoded_images_[i]._size];
+    // Get memory for encoded image from the pool.
+    encoded_buffers_[i] = encoded_buffer_pool_.CreateBuffer(
+        CalcBufferSize(VideoType::kI420, codec_.width, codec_.height));
+    encoded_images_[i]._buffer = encoded_buffers_[i]->data();
+    encoded_images_[i]._size = encoded_buffers_[i]->size();
     encoded_images_[i]._completeFrame = true;
   }
   // populate encoder configuration with default values
@@ -889,11 +886,13 @@ int LibvpxVp8Encoder::GetEncodedPartitions(
           size_t length = encoded_images_[encoder_idx]._length;
           if (pkt->data.frame.sz + length >
               encoded_images_[encoder_idx]._size) {
-            uint8_t* buffer = new uint8_t[pkt->data.frame.sz + length];
-            memcpy(buffer, encoded_images_[encoder_idx]._buffer, length);
-            delete[] encoded_images_[encoder_idx]._buffer;
-            encoded_images_[encoder_idx]._buffer = buffer;
-            encoded_images_[encoder_idx]._size = pkt->data.frame.sz + length;
+            rtc::scoped_refptr<EncodedImageBufferPool::Buffer> buffer =
+                encoded_buffer_pool_.CreateBuffer(pkt->data.frame.sz + length);
+            memcpy(buffer->data(), encoded_images_[encoder_idx]._buffer,
+                   length);
+            encoded_buffers_[encoder_idx] = buffer;
+            encoded_images_[encoder_idx]._buffer = buffer->data();
+            encoded_images_[encoder_idx]._size = buffer->size();
           }
           memcpy(&encoded_images_[encoder_idx]._buffer[length],
                  pkt->data.frame.buf, pkt->data.frame.sz);
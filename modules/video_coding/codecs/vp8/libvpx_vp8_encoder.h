@@ -17,6 +17,7 @@
 #include "api/video/video_frame.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_types.h"  // NOLINT(build/include)
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "common_video/include/video_frame.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/temporal_layers.h"
@@ -56,6 +57,12 @@ class LibvpxVp8Encoder : public VP8Encoder {
   static vpx_enc_frame_flags_t EncodeFlags(
       const TemporalLayers::FrameConfig& references);
 
+  // Number of buffers allocated for the bitstream of encoded images, for
+  // tests.
+  size_t num_allocated_encoded_buffers() const {
+    return encoded_buffer_pool_.num_allocated_buffers();
+  }
+
  private:
   void SetupTemporalLayers(int num_streams,
                            int num_temporal_layers,
@@ -101,6 +108,11 @@ class LibvpxVp8Encoder : public VP8Encoder {
   std::vector<int> cpu_speed_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
+  EncodedImageBufferPool encoded_buffer_pool_;
+  // Storage of the bitstream of |encoded_images_|, from
+  // |encoded_buffer_pool_|.
+  std::vector<rtc::scoped_refptr<EncodedImageBufferPool::Buffer>>
+      encoded_buffers_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> configurations_;
   std::vector<vpx_rational_t> downsampling_factors_;
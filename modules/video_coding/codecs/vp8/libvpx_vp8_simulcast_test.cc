@@ -104,5 +104,10 @@ TEST(LibvpxVp8SimulcastTest, TestStrideEncodeDecode) {
   fixture->TestStrideEncodeDecode();
 }
 
+TEST(LibvpxVp8SimulcastTest, TestEncodeTime) {
+  auto fixture = CreateSpecificSimulcastTestFixture();
+  fixture->TestEncodeTime();
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -22,7 +22,10 @@
 #include "modules/video_coding/codecs/vp8/temporal_layers.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 using ::testing::_;
 using ::testing::AllOf;
@@ -44,6 +47,7 @@ const int kMaxBitrates[kNumberOfSimulcastStreams] = {150, 600, 1200};
 const int kMinBitrates[kNumberOfSimulcastStreams] = {50, 150, 600};
 const int kTargetBitrates[kNumberOfSimulcastStreams] = {100, 450, 1000};
 const int kDefaultTemporalLayerProfile[3] = {3, 3, 3};
+const int kNumberOfTimedFrames = 30;
 
 template <typename T>
 void SetExpectedValues3(T value0, T value1, T value2, T* expected_values) {
@@ -802,5 +806,33 @@ void SimulcastTestFixtureImpl::TestStrideEncodeDecode() {
   EXPECT_EQ(2, decoder_callback.DecodedFrames());
 }
 
+void SimulcastTestFixtureImpl::TestEncodeTime() {
+  SetRates(kMaxBitrates[0] + kMaxBitrates[1] + kMaxBitrates[2], 30);
+  EXPECT_CALL(encoder_callback_, OnEncodedImage(_, _, _))
+      .Times(kNumberOfSimulcastStreams * kNumberOfTimedFrames)
+      .WillRepeatedly(Return(
+          EncodedImageCallback::Result(EncodedImageCallback::Result::OK, 0)));
+
+  Random random(0x1234);
+  int64_t encode_time_us = 0;
+  for (int i = 0; i < kNumberOfTimedFrames; ++i) {
+    // New noise in every frame, so that the encoders can't skip any work.
+    uint8_t* data_y = input_buffer_->MutableDataY();
+    for (int y = 0; y < input_buffer_->height(); ++y) {
+      for (int x = 0; x < input_buffer_->width(); ++x) {
+        data_y[y * input_buffer_->StrideY() + x] = random.Rand<uint8_t>();
+      }
+    }
+    input_frame_->set_timestamp(input_frame_->timestamp() + 3000);
+    const int64_t start_us = rtc::TimeMicros();
+    EXPECT_EQ(0, encoder_->Encode(*input_frame_, NULL, NULL));
+    encode_time_us += rtc::TimeMicros() - start_us;
+  }
+  PrintResult("simulcast_encode_time", "", encoder_->ImplementationName(),
+              static_cast<double>(encode_time_us) / kNumberOfTimedFrames /
+                  rtc::kNumMicrosecsPerMillisec,
+              "ms", false);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -11,10 +11,12 @@
 #include <stdio.h>
 
 #include <memory>
+#include <vector>
 
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/codecs/test/video_codec_unittest.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
+#include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
 #include "modules/video_coding/codecs/vp8/temporal_layers.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
 #include "rtc_base/timeutils.h"
@@ -36,7 +38,9 @@ constexpr int kHeight = 144;
 class TestVp8Impl : public VideoCodecUnitTest {
  protected:
   std::unique_ptr<VideoEncoder> CreateEncoder() override {
-    return VP8Encoder::Create();
+    std::unique_ptr<LibvpxVp8Encoder> encoder(new LibvpxVp8Encoder());
+    vp8_encoder_ = encoder.get();
+    return std::move(encoder);
   }
 
   std::unique_ptr<VideoDecoder> CreateDecoder() override {
@@ -79,6 +83,8 @@ class TestVp8Impl : public VideoCodecUnitTest {
     ASSERT_TRUE(vp8::GetQp(encoded_frame._buffer, encoded_frame._length, &qp));
     EXPECT_EQ(encoded_frame.qp_, qp) << "Encoder QP != parsed bitstream QP.";
   }
+
+  LibvpxVp8Encoder* vp8_encoder_ = nullptr;
 };
 
 TEST_F(TestVp8Impl, SetRateAllocation) {
@@ -112,6 +118,48 @@ TEST_F(TestVp8Impl, EncodeFrameAndRelease) {
             encoder_->Encode(*NextInputFrame(), nullptr, nullptr));
 }
 
+TEST_F(TestVp8Impl, EncodingReusesEncodedImageBuffers) {
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame,
+                        &codec_specific_info);
+  const size_t num_allocated_buffers =
+      vp8_encoder_->num_allocated_encoded_buffers();
+  EXPECT_GT(num_allocated_buffers, 0u);
+
+  for (int i = 0; i < 30; ++i) {
+    EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame,
+                          &codec_specific_info);
+  }
+  std::vector<FrameType> frame_types(1, kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->Encode(*NextInputFrame(), nullptr, &frame_types));
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  EXPECT_EQ(kVideoFrameKey, encoded_frame._frameType);
+  EXPECT_EQ(num_allocated_buffers,
+            vp8_encoder_->num_allocated_encoded_buffers());
+}
+
+TEST_F(TestVp8Impl, ReinitializationReusesEncodedImageBuffers) {
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame,
+                        &codec_specific_info);
+  const size_t num_allocated_buffers =
+      vp8_encoder_->num_allocated_encoded_buffers();
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Release());
+    EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              encoder_->InitEncode(&codec_settings_, kNumCores,
+                                   kMaxPayloadSize));
+    EncodeAndWaitForFrame(*NextInputFrame(), &encoded_frame,
+                          &codec_specific_info);
+  }
+  EXPECT_EQ(num_allocated_buffers,
+            vp8_encoder_->num_allocated_encoded_buffers());
+}
+
 TEST_F(TestVp8Impl, InitDecode) {
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Release());
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
@@ -97,10 +97,9 @@ VP9EncoderImpl::~VP9EncoderImpl() {
 int VP9EncoderImpl::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
-  if (encoded_image_._buffer != nullptr) {
-    delete[] encoded_image_._buffer;
-    encoded_image_._buffer = nullptr;
-  }
+  encoded_buffer_ = nullptr;
+  encoded_image_._buffer = nullptr;
+  encoded_image_._size = 0;
   if (encoder_ != nullptr) {
     if (inited_) {
       if (vpx_codec_destroy(encoder_)) {
@@ -298,13 +297,11 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
   // to get reference list in SVC mode.
   RTC_DCHECK(!inst->VP9().flexibleMode || is_svc_);
 
-  // Allocate memory for encoded image
-  if (encoded_image_._buffer != nullptr) {
-    delete[] encoded_image_._buffer;
-  }
-  encoded_image_._size =
-      CalcBufferSize(VideoType::kI420, codec_.width, codec_.height);
-  encoded_image_._buffer = new uint8_t[encoded_image_._size];
+  // Get memory for encoded image from the pool.
+  encoded_buffer_ = encoded_buffer_pool_.CreateBuffer(
+      CalcBufferSize(VideoType::kI420, codec_.width, codec_.height));
+  encoded_image_._buffer = encoded_buffer_->data();
+  encoded_image_._size = encoded_buffer_->size();
   encoded_image_._completeFrame = true;
   // Creating a wrapper to the image - setting image data to nullptr. Actual
   // pointer will be set in encode. Setting align to 1, as it is meaningless
@@ -849,9 +846,10 @@ int VP9EncoderImpl::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
   DeliverBufferedFrame(end_of_picture);
 
   if (pkt->data.frame.sz > encoded_image_._size) {
-    delete[] encoded_image_._buffer;
-    encoded_image_._size = pkt->data.frame.sz;
-    encoded_image_._buffer = new uint8_t[encoded_image_._size];
+    encoded_buffer_ = nullptr;
+    encoded_buffer_ = encoded_buffer_pool_.CreateBuffer(pkt->data.frame.sz);
+    encoded_image_._buffer = encoded_buffer_->data();
+    encoded_image_._size = encoded_buffer_->size();
   }
   memcpy(encoded_image_._buffer, pkt->data.frame.buf, pkt->data.frame.sz);
   encoded_image_._length = pkt->data.frame.sz;
@@ -16,6 +16,7 @@
 #include <memory>
 #include <vector>
 
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 #include "rtc_base/rate_statistics.h"
@@ -91,6 +92,9 @@ class VP9EncoderImpl : public VP9Encoder {
   uint32_t MaxIntraTarget(uint32_t optimal_buffer_size);
 
   EncodedImage encoded_image_;
+  EncodedImageBufferPool encoded_buffer_pool_;
+  // Storage of the bitstream of |encoded_image_|, from |encoded_buffer_pool_|.
+  rtc::scoped_refptr<EncodedImageBufferPool::Buffer> encoded_buffer_;
   CodecSpecificInfo codec_specific_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
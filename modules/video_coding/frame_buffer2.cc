@@ -12,7 +12,6 @@
 
 #include <algorithm>
 #include <cstring>
-#include <queue>
 
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/jitter_estimator.h"
@@ -367,18 +366,33 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
     }
   }
 
-  // Test if inserting this frame would cause the order of the frames to become
-  // ambiguous (covering more than half the interval of 2^16). This can happen
-  // when the picture id make large jumps mid stream.
-  if (!frames_.empty() && id < frames_.begin()->first &&
-      frames_.rbegin()->first < id) {
-    RTC_LOG(LS_WARNING)
-        << "A jump in picture id was detected, clearing buffer.";
-    ClearFramesAndHistory();
-    last_continuous_picture_id = -1;
+  // Test if inserting this frame would cause the frames to cover more picture
+  // ids than |frames_| can index. This can happen when the picture id make
+  // large jumps mid stream. Old history is dropped first, since it is only
+  // kept to look up references of new frames.
+  while (!frames_.CanInsert(id.picture_id) &&
+         last_decoded_frame_it_ != frames_.end() &&
+         frames_.begin() != last_decoded_frame_it_) {
+    frames_.erase(frames_.begin());
+    --num_frames_history_;
+  }
+  if (!frames_.CanInsert(id.picture_id)) {
+    if (frame->is_keyframe()) {
+      RTC_LOG(LS_WARNING)
+          << "A jump in picture id was detected, clearing buffer.";
+      ClearFramesAndHistory();
+      last_continuous_picture_id = -1;
+    } else {
+      RTC_LOG(LS_WARNING) << "Frame with (picture_id:spatial_id) ("
+                          << id.picture_id << ":"
+                          << static_cast<int>(id.spatial_layer)
+                          << ") is too far from the buffered frames, dropping"
+                          << " frame.";
+      return last_continuous_picture_id;
+    }
   }
 
-  auto info = frames_.emplace(id, FrameInfo()).first;
+  auto info = frames_.emplace(id).first;
 
   if (info->second.frame) {
     RTC_LOG(LS_WARNING) << "Frame with (picture_id:spatial_id) ("
@@ -415,13 +429,12 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
   if (last_continuous_frame_it_ == frames_.end())
     last_continuous_frame_it_ = start;
 
-  std::queue<FrameMap::iterator> continuous_frames;
-  continuous_frames.push(start);
+  continuous_frames_.clear();
+  continuous_frames_.push_back(start);
 
   // A simple BFS to traverse continuous frames.
-  while (!continuous_frames.empty()) {
-    auto frame = continuous_frames.front();
-    continuous_frames.pop();
+  for (size_t i = 0; i < continuous_frames_.size(); ++i) {
+    auto frame = continuous_frames_[i];
 
     if (last_continuous_frame_it_->first < frame->first)
       last_continuous_frame_it_ = frame;
@@ -437,7 +450,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
         --frame_ref->second.num_missing_continuous;
         if (frame_ref->second.num_missing_continuous == 0) {
           frame_ref->second.continuous = true;
-          continuous_frames.push(frame_ref);
+          continuous_frames_.push_back(frame_ref);
         }
       }
     }
@@ -517,8 +530,17 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
       --info->second.num_missing_continuous;
       --info->second.num_missing_decodable;
     } else {
-      if (ref_info == frames_.end())
-        ref_info = frames_.insert(std::make_pair(ref_key, FrameInfo())).first;
+      if (ref_info == frames_.end()) {
+        if (!frames_.CanInsert(ref_key.picture_id)) {
+          RTC_LOG(LS_WARNING)
+              << "Frame with (picture_id:spatial_id) (" << id.picture_id
+              << ":" << static_cast<int>(id.spatial_layer)
+              << ") references a frame too far from the buffered frames,"
+              << " dropping frame.";
+          return false;
+        }
+        ref_info = frames_.emplace(ref_key).first;
+      }
 
       if (ref_info->second.continuous)
         --info->second.num_missing_continuous;
@@ -547,7 +569,7 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
 
     VideoLayerFrameId ref_key(frame.id.picture_id, frame.id.spatial_layer - 1);
     // Gets or create the FrameInfo for the referenced frame.
-    auto ref_info = frames_.insert(std::make_pair(ref_key, FrameInfo())).first;
+    auto ref_info = frames_.emplace(ref_key).first;
     if (ref_info->second.continuous)
       --info->second.num_missing_continuous;
 
@@ -608,7 +630,195 @@ void FrameBuffer::ClearFramesAndHistory() {
 
 FrameBuffer::FrameInfo::FrameInfo() = default;
 FrameBuffer::FrameInfo::FrameInfo(FrameInfo&&) = default;
+FrameBuffer::FrameInfo& FrameBuffer::FrameInfo::operator=(FrameInfo&&) =
+    default;
 FrameBuffer::FrameInfo::~FrameInfo() = default;
 
+constexpr uint32_t FrameBuffer::FrameMap::kNone;
+constexpr size_t FrameBuffer::FrameMap::kInitialNumSlots;
+constexpr int64_t FrameBuffer::FrameMap::kMaxPictureIdSpan;
+
+FrameBuffer::FrameMap::FrameMap() : slots_(kInitialNumSlots, kNone) {}
+
+FrameBuffer::FrameMap::~FrameMap() = default;
+
+FrameBuffer::FrameMap::value_type& FrameBuffer::FrameMap::iterator::operator*()
+    const {
+  return map_->nodes_[index_].value;
+}
+
+FrameBuffer::FrameMap::value_type* FrameBuffer::FrameMap::iterator::operator->()
+    const {
+  return &map_->nodes_[index_].value;
+}
+
+FrameBuffer::FrameMap::iterator& FrameBuffer::FrameMap::iterator::operator++() {
+  index_ = map_->Next(index_);
+  return *this;
+}
+
+FrameBuffer::FrameMap::iterator FrameBuffer::FrameMap::begin() {
+  if (empty())
+    return end();
+  return iterator(this, Slot(min_picture_id_));
+}
+
+FrameBuffer::FrameMap::iterator FrameBuffer::FrameMap::find(
+    const VideoLayerFrameId& id) {
+  if (empty() || id.picture_id < min_picture_id_ ||
+      id.picture_id > max_picture_id_) {
+    return end();
+  }
+
+  for (uint32_t index = Slot(id.picture_id); index != kNone;
+       index = nodes_[index].next) {
+    const VideoLayerFrameId& key = nodes_[index].value.first;
+    if (key.spatial_layer >= id.spatial_layer) {
+      if (key.spatial_layer == id.spatial_layer)
+        return iterator(this, index);
+      break;
+    }
+  }
+  return end();
+}
+
+bool FrameBuffer::FrameMap::CanInsert(int64_t picture_id) const {
+  if (empty())
+    return true;
+  return std::max(max_picture_id_, picture_id) -
+             std::min(min_picture_id_, picture_id) <
+         kMaxPictureIdSpan;
+}
+
+std::pair<FrameBuffer::FrameMap::iterator, bool>
+FrameBuffer::FrameMap::emplace(const VideoLayerFrameId& id) {
+  RTC_DCHECK(CanInsert(id.picture_id));
+  if (empty()) {
+    min_picture_id_ = id.picture_id;
+    max_picture_id_ = id.picture_id;
+  } else if (id.picture_id < min_picture_id_ ||
+             id.picture_id > max_picture_id_) {
+    Grow(std::min(min_picture_id_, id.picture_id),
+         std::max(max_picture_id_, id.picture_id));
+  }
+
+  // Find where |id| goes in the ordered list of spatial layers.
+  uint32_t prev = kNone;
+  uint32_t next = Slot(id.picture_id);
+  while (next != kNone) {
+    const VideoLayerFrameId& key = nodes_[next].value.first;
+    if (key.spatial_layer == id.spatial_layer)
+      return std::make_pair(iterator(this, next), false);
+    if (key.spatial_layer > id.spatial_layer)
+      break;
+    prev = next;
+    next = nodes_[next].next;
+  }
+
+  const uint32_t index = AllocateNode(id);
+  nodes_[index].next = next;
+  if (prev == kNone) {
+    Slot(id.picture_id) = index;
+  } else {
+    nodes_[prev].next = index;
+  }
+
+  min_picture_id_ = std::min(min_picture_id_, id.picture_id);
+  max_picture_id_ = std::max(max_picture_id_, id.picture_id);
+  ++size_;
+  return std::make_pair(iterator(this, index), true);
+}
+
+FrameBuffer::FrameMap::iterator FrameBuffer::FrameMap::erase(iterator it) {
+  RTC_DCHECK(it != end());
+  const uint32_t index = it.index_;
+  const int64_t picture_id = nodes_[index].value.first.picture_id;
+  const iterator next(this, Next(index));
+
+  // Unlink the node from the spatial layers of its picture.
+  uint32_t* link = &Slot(picture_id);
+  while (*link != index) {
+    RTC_DCHECK_NE(*link, kNone);
+    link = &nodes_[*link].next;
+  }
+  *link = nodes_[index].next;
+
+  // Return the node to the pool, releasing the frame it holds.
+  nodes_[index].value.second = FrameInfo();
+  nodes_[index].next = free_nodes_;
+  free_nodes_ = index;
+  --size_;
+
+  if (empty() || Slot(picture_id) != kNone)
+    return next;
+
+  // The picture has no frames left, tighten the picture id window.
+  if (picture_id == min_picture_id_) {
+    while (Slot(min_picture_id_) == kNone)
+      ++min_picture_id_;
+  } else if (picture_id == max_picture_id_) {
+    while (Slot(max_picture_id_) == kNone)
+      --max_picture_id_;
+  }
+  return next;
+}
+
+void FrameBuffer::FrameMap::clear() {
+  for (Node& node : nodes_) {
+    node.value.second = FrameInfo();
+    node.next = kNone;
+  }
+  std::fill(slots_.begin(), slots_.end(), kNone);
+  // Rebuild the free list so that all nodes are reused.
+  free_nodes_ = kNone;
+  for (size_t i = nodes_.size(); i > 0; --i) {
+    nodes_[i - 1].next = free_nodes_;
+    free_nodes_ = static_cast<uint32_t>(i - 1);
+  }
+  size_ = 0;
+}
+
+uint32_t FrameBuffer::FrameMap::Next(uint32_t index) {
+  if (nodes_[index].next != kNone)
+    return nodes_[index].next;
+
+  for (int64_t picture_id = nodes_[index].value.first.picture_id + 1;
+       picture_id <= max_picture_id_; ++picture_id) {
+    if (Slot(picture_id) != kNone)
+      return Slot(picture_id);
+  }
+  return kNone;
+}
+
+uint32_t FrameBuffer::FrameMap::AllocateNode(const VideoLayerFrameId& id) {
+  uint32_t index = free_nodes_;
+  if (index == kNone) {
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  } else {
+    free_nodes_ = nodes_[index].next;
+  }
+  nodes_[index].value.first = id;
+  return index;
+}
+
+void FrameBuffer::FrameMap::Grow(int64_t min_picture_id,
+                                 int64_t max_picture_id) {
+  const size_t span = max_picture_id - min_picture_id + 1;
+  if (span <= slots_.size())
+    return;
+
+  size_t num_slots = slots_.size();
+  while (num_slots < span)
+    num_slots *= 2;
+
+  std::vector<uint32_t> slots(num_slots, kNone);
+  for (int64_t picture_id = min_picture_id_; picture_id <= max_picture_id_;
+       ++picture_id) {
+    slots[picture_id & (num_slots - 1)] = Slot(picture_id);
+  }
+  slots_.swap(slots);
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
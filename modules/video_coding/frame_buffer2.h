@@ -12,9 +12,9 @@
 #define MODULES_VIDEO_CODING_FRAME_BUFFER2_H_
 
 #include <array>
-#include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "api/video/encoded_frame.h"
 #include "modules/video_coding/include/video_coding_defines.h"
@@ -82,6 +82,7 @@ class FrameBuffer {
   struct FrameInfo {
     FrameInfo();
     FrameInfo(FrameInfo&&);
+    FrameInfo& operator=(FrameInfo&&);
     ~FrameInfo();
 
     // The maximum number of frames that can depend on this frame.
@@ -112,7 +113,90 @@ class FrameBuffer {
     std::unique_ptr<EncodedFrame> frame;
   };
 
-  using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
+  // Ordered map from VideoLayerFrameId to FrameInfo. The frames of a picture
+  // are found through a ring indexed by picture id, and the FrameInfos are
+  // kept in a pool that is reused as frames are erased, so that lookups and
+  // in-order inserts and erases are O(1) and do not allocate once the buffer
+  // has warmed up. All picture ids in the map must fit within a window of
+  // kMaxPictureIdSpan, see CanInsert().
+  class FrameMap {
+   public:
+    using value_type = std::pair<VideoLayerFrameId, FrameInfo>;
+
+    // Iterators stay valid until the element they point to is erased, like
+    // std::map iterators.
+    class iterator {
+     public:
+      iterator() = default;
+
+      value_type& operator*() const;
+      value_type* operator->() const;
+      iterator& operator++();
+      bool operator==(const iterator& other) const {
+        return index_ == other.index_;
+      }
+      bool operator!=(const iterator& other) const { return !(*this == other); }
+
+     private:
+      friend class FrameMap;
+      iterator(FrameMap* map, uint32_t index) : map_(map), index_(index) {}
+
+      FrameMap* map_ = nullptr;
+      uint32_t index_ = kNone;
+    };
+
+    FrameMap();
+    ~FrameMap();
+
+    iterator begin();
+    iterator end() { return iterator(this, kNone); }
+    bool empty() const { return size_ == 0; }
+
+    iterator find(const VideoLayerFrameId& id);
+
+    // Returns true if a frame with |picture_id| can be inserted without the
+    // map spanning more than kMaxPictureIdSpan picture ids.
+    bool CanInsert(int64_t picture_id) const;
+
+    // Inserts a default constructed FrameInfo for |id| unless |id| is already
+    // in the map. Requires CanInsert(id.picture_id).
+    std::pair<iterator, bool> emplace(const VideoLayerFrameId& id);
+
+    // Returns the iterator following |it|.
+    iterator erase(iterator it);
+    void clear();
+
+   private:
+    static constexpr uint32_t kNone = 0xFFFFFFFF;
+    static constexpr size_t kInitialNumSlots = 256;
+    // Same limit as where the order of unwrapped 16 bit picture ids would
+    // become ambiguous.
+    static constexpr int64_t kMaxPictureIdSpan = 1 << 15;
+
+    struct Node {
+      value_type value;
+      // The node of the next spatial layer of the same picture, or the next
+      // free node when in the free list.
+      uint32_t next = kNone;
+    };
+
+    uint32_t& Slot(int64_t picture_id) {
+      return slots_[picture_id & (slots_.size() - 1)];
+    }
+    uint32_t Next(uint32_t index);
+    uint32_t AllocateNode(const VideoLayerFrameId& id);
+    void Grow(int64_t min_picture_id, int64_t max_picture_id);
+
+    // |slots_[picture_id % slots_.size()]| holds the node of the lowest
+    // spatial layer of |picture_id|, with the other spatial layers following
+    // in increasing order through |Node::next|.
+    std::vector<uint32_t> slots_;
+    std::vector<Node> nodes_;
+    uint32_t free_nodes_ = kNone;
+    int64_t min_picture_id_ = 0;
+    int64_t max_picture_id_ = 0;
+    size_t size_ = 0;
+  };
 
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
@@ -153,6 +237,8 @@ class FrameBuffer {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   FrameMap frames_ RTC_GUARDED_BY(crit_);
+  // Work queue of PropagateContinuity(), kept to reuse its memory.
+  std::vector<FrameMap::iterator> continuous_frames_ RTC_GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
   Clock* const clock_;
@@ -21,9 +21,11 @@
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 using testing::_;
 using testing::Return;
@@ -592,5 +594,84 @@ TEST_F(TestFrameBuffer2, KeyframeClearsFullBuffer) {
   CheckFrame(1, kMaxBufferSize + 1, 0);
 }
 
+
+TEST_F(TestFrameBuffer2, FrameTooFarAheadDropped) {
+  EXPECT_EQ(1, InsertFrame(1, 0, 1000, false));
+  EXPECT_EQ(1, InsertFrame(40001, 0, 2000, false, 40000));
+  ExtractFrame();
+  ExtractFrame();
+  CheckFrame(0, 1, 0);
+  CheckNoFrame(1);
+}
+
+TEST_F(TestFrameBuffer2, KeyframeTooFarAheadClearsBuffer) {
+  EXPECT_EQ(1, InsertFrame(1, 0, 1000, false));
+  ExtractFrame();
+  EXPECT_EQ(1, InsertFrame(3, 0, 3000, false, 2));
+  EXPECT_EQ(40001, InsertFrame(40001, 0, 4000, false));
+  ExtractFrame();
+  ExtractFrame();
+  CheckFrame(0, 1, 0);
+  CheckFrame(1, 40001, 0);
+  CheckNoFrame(2);
+}
+
+// Replays streams with the temporal and spatial layer structures used by VP8
+// and VP9 through the frame buffer, and reports the time spent per frame on
+// inserting it and on handing it off for decoding.
+TEST_F(TestFrameBuffer2, LayeredStreamsPerformance) {
+  struct Pattern {
+    const char* name;
+    int num_spatial_layers;
+  };
+  const Pattern kPatterns[] = {{"L1T3", 1}, {"L3T3", 3}, {"L5T3", 5}};
+  const int kNumPictures = 3000;
+  // Picture id distance to the reference of each picture of a T3 cycle, where
+  // T0 references the previous T0, T1 references T0, and T2 references the
+  // previous picture.
+  const int kReferenceDistance[] = {4, 1, 2, 1};
+
+  for (const Pattern& pattern : kPatterns) {
+    SCOPED_TRACE(pattern.name);
+    buffer_.reset(
+        new FrameBuffer(&clock_, &jitter_estimator_, &timing_, nullptr));
+
+    auto insert_picture = [&](int picture_id) {
+      for (int layer = 0; layer < pattern.num_spatial_layers; ++layer) {
+        if (picture_id == 0) {
+          InsertFrame(picture_id, layer, 0, layer > 0);
+        } else {
+          InsertFrame(picture_id, layer, picture_id * kFps20, layer > 0,
+                      picture_id - kReferenceDistance[picture_id % 4]);
+        }
+      }
+    };
+
+    int num_decoded_frames = 0;
+    std::unique_ptr<EncodedFrame> frame;
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPictures; ++i) {
+      // Some pictures arrive after the next one, making the buffer hold a
+      // placeholder for a referenced frame that has not been received yet.
+      if (i % 8 == 2 && i + 1 < kNumPictures) {
+        insert_picture(i + 1);
+        insert_picture(i);
+        ++i;
+      } else {
+        insert_picture(i);
+      }
+      while (buffer_->NextFrame(0, &frame) == FrameBuffer::kFrameFound)
+        ++num_decoded_frames;
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+    const int num_frames = kNumPictures * pattern.num_spatial_layers;
+    EXPECT_EQ(num_frames, num_decoded_frames);
+    test::PrintResult("frame_buffer2_time_per_frame", "", pattern.name,
+                      static_cast<double>(elapsed_us) / num_frames, "us",
+                      false);
+  }
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -28,16 +28,18 @@ const int kProcessFrequency = 50;
 const int kProcessIntervalMs = 1000 / kProcessFrequency;
 const int kMaxReorderedPackets = 128;
 const int kNumReorderingBuckets = 10;
+// Must be a power of 2 larger than |kMaxPacketAge|.
+const size_t kSeqNumWindowSize = 1 << 14;
 }  // namespace
 
 NackModule::NackInfo::NackInfo()
-    : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
+    : sent_at_time(-1), retries(0), seq_num(0), send_at_seq_num(0) {}
 
 NackModule::NackInfo::NackInfo(uint16_t seq_num, uint16_t send_at_seq_num)
-    : seq_num(seq_num),
-      send_at_seq_num(send_at_seq_num),
-      sent_at_time(-1),
-      retries(0) {}
+    : sent_at_time(-1),
+      retries(0),
+      seq_num(seq_num),
+      send_at_seq_num(send_at_seq_num) {}
 
 NackModule::NackModule(Clock* clock,
                        NackSender* nack_sender,
@@ -45,6 +47,10 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      nack_list_(kSeqNumWindowSize),
+      unsent_nack_list_(kSeqNumWindowSize),
+      nack_infos_(kSeqNumWindowSize),
+      keyframe_list_(kSeqNumWindowSize),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
@@ -53,6 +59,8 @@ NackModule::NackModule(Clock* clock,
   RTC_DCHECK(clock_);
   RTC_DCHECK(nack_sender_);
   RTC_DCHECK(keyframe_request_sender_);
+  static_assert(kSeqNumWindowSize > kMaxPacketAge,
+                "Sequence number window too small.");
 }
 
 int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
@@ -78,11 +86,11 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (nack_list_.contains(seq_num)) {
+      nacks_sent_for_packet = GetNackInfo(seq_num).retries;
+      nack_list_.erase(seq_num);
+      unsent_nack_list_.erase(seq_num);
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -91,15 +99,13 @@ int NackModule::OnReceivedPacket(uint16_t seq_num, bool is_keyframe) {
   AddPacketsToNack(newest_seq_num_ + 1, seq_num);
   newest_seq_num_ = seq_num;
 
-  // Keep track of new keyframes.
+  // Remove old keyframes so we don't accumulate keyframes.
+  keyframe_list_.EraseBefore(seq_num - kMaxPacketAge);
+
+  // And keep track of new ones.
   if (is_keyframe)
     keyframe_list_.insert(seq_num);
 
-  // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
-
   // Are there any nacks that are waiting for this seq_num.
   std::vector<uint16_t> nack_batch = GetNackBatch(kSeqNumOnly);
   if (!nack_batch.empty())
@@ -116,9 +122,9 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
+  nack_list_.EraseBefore(seq_num);
+  unsent_nack_list_.EraseBefore(seq_num);
+  keyframe_list_.EraseBefore(seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
@@ -129,6 +135,7 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
+  unsent_nack_list_.clear();
   keyframe_list_.clear();
 }
 
@@ -165,19 +172,20 @@ void NackModule::Process() {
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
+    const uint16_t keyframe_seq_num = keyframe_list_.oldest();
 
-    if (it != nack_list_.begin()) {
+    if (!nack_list_.empty() && AheadOf(keyframe_seq_num, nack_list_.oldest())) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      RTC_DCHECK(it != nack_list_.end());
-      nack_list_.erase(nack_list_.begin(), it);
+      RTC_DCHECK(AheadOrAt(nack_list_.newest(), keyframe_seq_num));
+      nack_list_.EraseBefore(keyframe_seq_num);
+      unsent_nack_list_.EraseBefore(keyframe_seq_num);
       return true;
     }
 
     // If this keyframe is so old it does not remove any packets from the list,
     // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+    keyframe_list_.erase(keyframe_seq_num);
   }
   return false;
 }
@@ -185,8 +193,8 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
                                   uint16_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  nack_list_.EraseBefore(seq_num_end - kMaxPacketAge);
+  unsent_nack_list_.EraseBefore(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -199,6 +207,7 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
 
     if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
       nack_list_.clear();
+      unsent_nack_list_.clear();
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -206,11 +215,14 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
+  const int wait_number_of_packets = WaitNumberOfPackets(0.5);
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5));
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(!nack_list_.contains(seq_num));
+    GetNackInfo(seq_num) =
+        NackInfo(seq_num, seq_num + wait_number_of_packets);
   }
+  nack_list_.InsertRange(seq_num_start, seq_num_end);
+  unsent_nack_list_.InsertRange(seq_num_start, seq_num_end);
 }
 
 std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
@@ -218,41 +230,34 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    if (consider_seq_num && it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num)) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                            << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
-    }
-
-    if (consider_timestamp && it->second.sent_at_time + rtt_ms_ <= now_ms) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+  // Only packets that have never been nacked can be nacked based on sequence
+  // number alone. Erasing the sequence number an iterator of a SeqNumBitmap
+  // points to does not invalidate the iterator.
+  const video_coding::SeqNumBitmap& candidates =
+      consider_timestamp ? nack_list_ : unsent_nack_list_;
+  for (uint16_t seq_num : candidates) {
+    NackInfo& nack_info = GetNackInfo(seq_num);
+    if ((consider_seq_num && nack_info.sent_at_time == -1 &&
+         AheadOrAt(newest_seq_num_, nack_info.send_at_seq_num)) ||
+        (consider_timestamp && nack_info.sent_at_time + rtt_ms_ <= now_ms)) {
+      nack_batch.emplace_back(nack_info.seq_num);
+      ++nack_info.retries;
+      nack_info.sent_at_time = now_ms;
+      unsent_nack_list_.erase(seq_num);
+      if (nack_info.retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << nack_info.seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        nack_list_.erase(seq_num);
       }
-      continue;
     }
-    ++it;
   }
   return nack_batch;
 }
 
+NackModule::NackInfo& NackModule::GetNackInfo(uint16_t seq_num) {
+  return nack_infos_[seq_num % kSeqNumWindowSize];
+}
+
 void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
   RTC_DCHECK(AheadOf(newest_seq_num_, seq_num));
   uint16_t diff = ReverseDiff(newest_seq_num_, seq_num);
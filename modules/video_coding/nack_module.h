@@ -11,14 +11,13 @@
 #ifndef MODULES_VIDEO_CODING_NACK_MODULE_H_
 #define MODULES_VIDEO_CODING_NACK_MODULE_H_
 
-#include <map>
 #include <vector>
-#include <set>
 
 #include "modules/include/module.h"
 #include "modules/video_coding/histogram.h"
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/packet.h"
+#include "modules/video_coding/seq_num_bitmap.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -54,10 +53,10 @@ class NackModule : public Module {
     NackInfo();
     NackInfo(uint16_t seq_num, uint16_t send_at_seq_num);
 
-    uint16_t seq_num;
-    uint16_t send_at_seq_num;
     int64_t sent_at_time;
     int retries;
+    uint16_t seq_num;
+    uint16_t send_at_seq_num;
   };
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -68,6 +67,8 @@ class NackModule : public Module {
   std::vector<uint16_t> GetNackBatch(NackFilterOptions options)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  NackInfo& GetNackInfo(uint16_t seq_num) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Update the reordering distribution.
   void UpdateReorderingStatistics(uint16_t seq_num)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -85,10 +86,13 @@ class NackModule : public Module {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(crit_);
+  // The sequence numbers to nack. The NackInfo of a sequence number in
+  // |nack_list_| is found at |nack_infos_[seq_num % nack_infos_.size()]|.
+  video_coding::SeqNumBitmap nack_list_ RTC_GUARDED_BY(crit_);
+  // The packets in |nack_list_| that have not been nacked yet.
+  video_coding::SeqNumBitmap unsent_nack_list_ RTC_GUARDED_BY(crit_);
+  std::vector<NackInfo> nack_infos_ RTC_GUARDED_BY(crit_);
+  video_coding::SeqNumBitmap keyframe_list_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
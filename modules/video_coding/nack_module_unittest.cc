@@ -9,12 +9,18 @@
  */
 
 #include <cstring>
+#include <deque>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "modules/video_coding/include/video_coding_defines.h"
 #include "modules/video_coding/nack_module.h"
+#include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 class TestNackModule : public ::testing::Test,
@@ -314,4 +320,61 @@ TEST_F(TestNackModule, PacketNackCount) {
   EXPECT_EQ(0, nack_module_.OnReceivedPacket(packet));
 }
 
+// Replays a high bitrate stream with heavy loss, where lost packets are
+// retransmitted one round trip later, and reports the time spent per received
+// packet.
+TEST_F(TestNackModule, DISABLED_LossPatternPerformance) {
+  const int kNumPackets = 200000;
+  const int kPacketsPerFrame = 20;
+  const int kFramesPerKeyframe = 300;
+  const int kPacketIntervalUs = 500;
+  const int kRttMs = 100;
+  const int kRetransmissionDelayPackets = kRttMs * 1000 / kPacketIntervalUs;
+  Random random(0x73a1c9);
+
+  for (float loss_rate : {0.1f, 0.2f}) {
+    NackModule nack_module(clock_.get(), this, this);
+    nack_module.UpdateRtt(kRttMs);
+    // Pairs of (packet index when received, sequence number).
+    std::deque<std::pair<int, uint16_t>> retransmissions;
+    VCMPacket packet;
+    int num_received_packets = 0;
+
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPackets; ++i) {
+      clock_->AdvanceTimeMicroseconds(kPacketIntervalUs);
+      if (nack_module.TimeUntilNextProcess() == 0)
+        nack_module.Process();
+
+      while (!retransmissions.empty() && retransmissions.front().first <= i) {
+        packet.seqNum = retransmissions.front().second;
+        packet.is_first_packet_in_frame = false;
+        nack_module.OnReceivedPacket(packet);
+        ++num_received_packets;
+        retransmissions.pop_front();
+      }
+
+      packet.seqNum = static_cast<uint16_t>(i);
+      packet.is_first_packet_in_frame = i % kPacketsPerFrame == 0;
+      packet.frameType = i % (kPacketsPerFrame * kFramesPerKeyframe) == 0
+                             ? kVideoFrameKey
+                             : kVideoFrameDelta;
+      if (random.Rand<float>() < loss_rate) {
+        retransmissions.emplace_back(i + kRetransmissionDelayPackets,
+                                     packet.seqNum);
+        continue;
+      }
+      nack_module.OnReceivedPacket(packet);
+      ++num_received_packets;
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+    EXPECT_EQ(0, keyframes_requested_);
+    test::PrintResult("nack_module_time_per_packet", "",
+                      std::to_string(static_cast<int>(loss_rate * 100)) +
+                          "_percent_loss",
+                      elapsed_us * 1000.0 / num_received_packets, "ns", false);
+  }
+}
+
 }  // namespace webrtc
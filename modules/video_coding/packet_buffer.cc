@@ -26,6 +26,17 @@
 namespace webrtc {
 namespace video_coding {
 
+namespace {
+// Packets older than this compared to the newest inserted packet are no longer
+// tracked as missing.
+constexpr int kMaxPaddingAge = 1000;
+
+// Must be a power of 2 larger than |kMaxPaddingAge|.
+constexpr size_t kMissingPacketsWindowSize = 1024;
+
+constexpr size_t kMaxTimestampsHistory = 1000;
+}  // namespace
+
 rtc::scoped_refptr<PacketBuffer> PacketBuffer::Create(
     Clock* clock,
     size_t start_buffer_size,
@@ -49,8 +60,13 @@ PacketBuffer::PacketBuffer(Clock* clock,
       sequence_buffer_(start_buffer_size),
       received_frame_callback_(received_frame_callback),
       unique_frames_seen_(0),
+      missing_packets_(kMissingPacketsWindowSize),
       sps_pps_idr_is_h264_keyframe_(
-          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
+          field_trial::IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")),
+      rtp_timestamps_history_index_(0) {
+  static_assert(kMissingPacketsWindowSize > kMaxPaddingAge,
+                "Missing packets window too small.");
+  rtp_timestamps_history_.reserve(kMaxTimestampsHistory);
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
@@ -165,11 +181,9 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  auto clear_to_it = missing_packets_.upper_bound(seq_num);
-  if (clear_to_it != missing_packets_.begin()) {
-    --clear_to_it;
-    missing_packets_.erase(missing_packets_.begin(), clear_to_it);
-  }
+  rtc::Optional<uint16_t> clear_to = missing_packets_.PrevAtOrBefore(seq_num);
+  if (clear_to)
+    missing_packets_.EraseBefore(*clear_to);
 }
 
 void PacketBuffer::Clear() {
@@ -375,8 +389,8 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
 
         // If this is not a keyframe, make sure there are no gaps in the
         // packet sequence numbers up until this point.
-        if (!is_h264_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
+        if (!is_h264_keyframe && !missing_packets_.empty() &&
+            AheadOrAt(start_seq_num, missing_packets_.oldest())) {
           uint16_t stop_index = (index + 1) % size_;
           while (start_index != stop_index) {
             sequence_buffer_[start_index].frame_created = false;
@@ -387,8 +401,7 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         }
       }
 
-      missing_packets_.erase(missing_packets_.begin(),
-                             missing_packets_.upper_bound(seq_num));
+      missing_packets_.EraseBefore(static_cast<uint16_t>(seq_num + 1));
 
       found_frames.emplace_back(
           new RtpFrameObject(this, start_seq_num, seq_num, frame_size,
@@ -475,11 +488,9 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   if (!newest_inserted_seq_num_)
     newest_inserted_seq_num_ = seq_num;
 
-  const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
+    missing_packets_.EraseBefore(old_seq_num);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
@@ -487,26 +498,36 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
       *newest_inserted_seq_num_ = old_seq_num;
 
     ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
-    }
+    missing_packets_.InsertRange(*newest_inserted_seq_num_, seq_num);
+    *newest_inserted_seq_num_ = seq_num;
   } else {
     missing_packets_.erase(seq_num);
   }
 }
 
 void PacketBuffer::OnTimestampReceived(uint32_t rtp_timestamp) {
-  const size_t kMaxTimestampsHistory = 1000;
-  if (rtp_timestamps_history_set_.insert(rtp_timestamp).second) {
-    rtp_timestamps_history_queue_.push(rtp_timestamp);
-    ++unique_frames_seen_;
-    if (rtp_timestamps_history_set_.size() > kMaxTimestampsHistory) {
-      uint32_t discarded_timestamp = rtp_timestamps_history_queue_.front();
-      rtp_timestamps_history_set_.erase(discarded_timestamp);
-      rtp_timestamps_history_queue_.pop();
-    }
+  // Most packets belong to the same frame as the previous packet.
+  if (!rtp_timestamps_history_.empty()) {
+    size_t last_index = rtp_timestamps_history_index_ > 0
+                            ? rtp_timestamps_history_index_ - 1
+                            : rtp_timestamps_history_.size() - 1;
+    if (rtp_timestamps_history_[last_index] == rtp_timestamp)
+      return;
+  }
+
+  if (std::find(rtp_timestamps_history_.begin(), rtp_timestamps_history_.end(),
+                rtp_timestamp) != rtp_timestamps_history_.end()) {
+    return;
+  }
+
+  ++unique_frames_seen_;
+  if (rtp_timestamps_history_.size() < kMaxTimestampsHistory) {
+    rtp_timestamps_history_.push_back(rtp_timestamp);
+  } else {
+    rtp_timestamps_history_[rtp_timestamps_history_index_] = rtp_timestamp;
   }
+  rtp_timestamps_history_index_ =
+      (rtp_timestamps_history_index_ + 1) % kMaxTimestampsHistory;
 }
 
 }  // namespace video_coding
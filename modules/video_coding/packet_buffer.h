@@ -12,13 +12,12 @@
 #define MODULES_VIDEO_CODING_PACKET_BUFFER_H_
 
 #include <memory>
-#include <queue>
-#include <set>
 #include <vector>
 
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/packet.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/seq_num_bitmap.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/scoped_ref_ptr.h"
@@ -166,17 +165,16 @@ class PacketBuffer {
   int unique_frames_seen_ RTC_GUARDED_BY(crit_);
 
   rtc::Optional<uint16_t> newest_inserted_seq_num_ RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_
-      RTC_GUARDED_BY(crit_);
+  SeqNumBitmap missing_packets_ RTC_GUARDED_BY(crit_);
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
   const bool sps_pps_idr_is_h264_keyframe_;
 
-  // Stores several last seen unique timestamps for quick search.
-  std::set<uint32_t> rtp_timestamps_history_set_ RTC_GUARDED_BY(crit_);
-  // Stores the same unique timestamps in the order of insertion.
-  std::queue<uint32_t> rtp_timestamps_history_queue_ RTC_GUARDED_BY(crit_);
+  // Circular buffer of the last seen unique timestamps, searched linearly.
+  std::vector<uint32_t> rtp_timestamps_history_ RTC_GUARDED_BY(crit_);
+  // Where the next unique timestamp is written in |rtp_timestamps_history_|.
+  size_t rtp_timestamps_history_index_ RTC_GUARDED_BY(crit_);
 
   mutable volatile int ref_count_ = 0;
 };
@@ -25,7 +25,12 @@ namespace video_coding {
 RtpFrameReferenceFinder::RtpFrameReferenceFinder(
     OnCompleteFrameCallback* frame_callback)
     : last_picture_id_(-1),
+      // Leave room for padding that is reordered with respect to newer
+      // padding, beyond the |kMaxPaddingAge| sequence numbers that are kept.
+      stashed_padding_(256),
       last_unwrap_(-1),
+      not_yet_received_frames_(128, kPicIdLength),
+      layer_info_tl0_pic_idxs_(128, kTl0PicIdxLength),
       current_ss_idx_(0),
       cleared_to_seq_num_(-1),
       frame_callback_(frame_callback) {}
@@ -111,10 +116,14 @@ RtpFrameReferenceFinder::ManageFrameInternal(RtpFrameObject* frame) {
 
 void RtpFrameReferenceFinder::PaddingReceived(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  auto clean_padding_to =
-      stashed_padding_.lower_bound(seq_num - kMaxPaddingAge);
-  stashed_padding_.erase(stashed_padding_.begin(), clean_padding_to);
-  stashed_padding_.insert(seq_num);
+  stashed_padding_.EraseBefore(seq_num - kMaxPaddingAge);
+  if (stashed_padding_.CanInsert(seq_num)) {
+    stashed_padding_.insert(seq_num);
+  } else if (AheadOf(seq_num, stashed_padding_.newest())) {
+    // The stashed padding is too old to be of any use.
+    stashed_padding_.clear();
+    stashed_padding_.insert(seq_num);
+  }
   UpdateLastPictureIdWithPadding(seq_num);
   RetryStashedFrames();
 }
@@ -145,17 +154,13 @@ void RtpFrameReferenceFinder::UpdateLastPictureIdWithPadding(uint16_t seq_num) {
   // Calculate the next contiuous sequence number and search for it in
   // the padding packets we have stashed.
   uint16_t next_seq_num_with_padding = gop_seq_num_it->second.second + 1;
-  auto padding_seq_num_it =
-      stashed_padding_.lower_bound(next_seq_num_with_padding);
 
   // While there still are padding packets and those padding packets are
   // continuous, then advance the "last-picture-id-with-padding" and remove
   // the stashed padding packet.
-  while (padding_seq_num_it != stashed_padding_.end() &&
-         *padding_seq_num_it == next_seq_num_with_padding) {
+  while (stashed_padding_.erase(next_seq_num_with_padding)) {
     gop_seq_num_it->second.second = next_seq_num_with_padding;
     ++next_seq_num_with_padding;
-    padding_seq_num_it = stashed_padding_.erase(padding_seq_num_it);
   }
 
   // In the case where the stream has been continuous without any new keyframes
@@ -268,51 +273,54 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   if (last_picture_id_ == -1)
     last_picture_id_ = frame->id.picture_id;
 
+  // Clean up info about not yet received frames that are too old.
+  uint16_t old_picture_id =
+      Subtract<kPicIdLength>(frame->id.picture_id, kMaxNotYetReceivedFrames);
+  not_yet_received_frames_.EraseBefore(old_picture_id);
+
   // Find if there has been a gap in fully received frames and save the picture
-  // id of those frames in |not_yet_received_frames_|.
+  // id of those frames in |not_yet_received_frames_|. Frames older than
+  // |old_picture_id| would be cleaned up right away, so skip them.
   if (AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id, last_picture_id_)) {
-    do {
-      last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
-      not_yet_received_frames_.insert(last_picture_id_);
-    } while (last_picture_id_ != frame->id.picture_id);
+    uint16_t picture_id = Add<kPicIdLength>(last_picture_id_, 1);
+    if (AheadOf<uint16_t, kPicIdLength>(old_picture_id, picture_id))
+      picture_id = old_picture_id;
+    while (true) {
+      if (not_yet_received_frames_.CanInsert(picture_id))
+        not_yet_received_frames_.insert(picture_id);
+      if (picture_id == frame->id.picture_id)
+        break;
+      picture_id = Add<kPicIdLength>(picture_id, 1);
+    }
+    last_picture_id_ = frame->id.picture_id;
   }
 
   // Clean up info for base layers that are too old.
   uint8_t old_tl0_pic_idx = codec_header.tl0PicIdx - kMaxLayerInfo;
-  auto clean_layer_info_to = layer_info_.lower_bound(old_tl0_pic_idx);
-  layer_info_.erase(layer_info_.begin(), clean_layer_info_to);
-
-  // Clean up info about not yet received frames that are too old.
-  uint16_t old_picture_id =
-      Subtract<kPicIdLength>(frame->id.picture_id, kMaxNotYetReceivedFrames);
-  auto clean_frames_to = not_yet_received_frames_.lower_bound(old_picture_id);
-  not_yet_received_frames_.erase(not_yet_received_frames_.begin(),
-                                 clean_frames_to);
+  layer_info_tl0_pic_idxs_.EraseBefore(old_tl0_pic_idx);
 
   if (frame->frame_type() == kVideoFrameKey) {
     frame->num_references = 0;
-    layer_info_[codec_header.tl0PicIdx].fill(-1);
+    AddLayerInfoVp8(codec_header.tl0PicIdx, LayerInfo())->fill(-1);
     UpdateLayerInfoVp8(frame, codec_header);
     return kHandOff;
   }
 
-  auto layer_info_it = layer_info_.find(codec_header.temporalIdx == 0
-                                            ? codec_header.tl0PicIdx - 1
-                                            : codec_header.tl0PicIdx);
+  LayerInfo* layer_info = GetLayerInfoVp8(codec_header.temporalIdx == 0
+                                              ? codec_header.tl0PicIdx - 1
+                                              : codec_header.tl0PicIdx);
 
   // If we don't have the base layer frame yet, stash this frame.
-  if (layer_info_it == layer_info_.end())
+  if (!layer_info)
     return kStash;
 
   // A non keyframe base layer frame has been received, copy the layer info
   // from the previous base layer frame and set a reference to the previous
   // base layer frame.
   if (codec_header.temporalIdx == 0) {
-    layer_info_it =
-        layer_info_.emplace(codec_header.tl0PicIdx, layer_info_it->second)
-            .first;
+    layer_info = AddLayerInfoVp8(codec_header.tl0PicIdx, *layer_info);
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
     UpdateLayerInfoVp8(frame, codec_header);
     return kHandOff;
   }
@@ -320,7 +328,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   // Layer sync frame, this frame only references its base layer frame.
   if (codec_header.layerSync) {
     frame->num_references = 1;
-    frame->references[0] = layer_info_it->second[0];
+    frame->references[0] = (*layer_info)[0];
 
     UpdateLayerInfoVp8(frame, codec_header);
     return kHandOff;
@@ -331,29 +339,30 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   for (uint8_t layer = 0; layer <= codec_header.temporalIdx; ++layer) {
     // If we have not yet received a previous frame on this temporal layer,
     // stash this frame.
-    if (layer_info_it->second[layer] == -1)
+    if ((*layer_info)[layer] == -1)
       return kStash;
 
     // If the last frame on this layer is ahead of this frame it means that
     // a layer sync frame has been received after this frame for the same
     // base layer frame, drop this frame.
-    if (AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[layer],
+    if (AheadOf<uint16_t, kPicIdLength>((*layer_info)[layer],
                                         frame->id.picture_id)) {
       return kDrop;
     }
 
     // If we have not yet received a frame between this frame and the referenced
     // frame then we have to wait for that frame to be completed first.
-    auto not_received_frame_it =
-        not_yet_received_frames_.upper_bound(layer_info_it->second[layer]);
-    if (not_received_frame_it != not_yet_received_frames_.end() &&
+    rtc::Optional<uint16_t> not_received_frame =
+        not_yet_received_frames_.NextAtOrAfter(
+            Add<kPicIdLength>((*layer_info)[layer], 1));
+    if (not_received_frame &&
         AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
-                                        *not_received_frame_it)) {
+                                        *not_received_frame)) {
       return kStash;
     }
 
     if (!(AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id,
-                                          layer_info_it->second[layer]))) {
+                                          (*layer_info)[layer]))) {
       RTC_LOG(LS_WARNING) << "Frame with picture id " << frame->id.picture_id
                           << " and packet range [" << frame->first_seq_num()
                           << ", " << frame->last_seq_num()
@@ -363,7 +372,7 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
     }
 
     ++frame->num_references;
-    frame->references[layer] = layer_info_it->second[layer];
+    frame->references[layer] = (*layer_info)[layer];
   }
 
   UpdateLayerInfoVp8(frame, codec_header);
@@ -375,27 +384,47 @@ void RtpFrameReferenceFinder::UpdateLayerInfoVp8(
     const RTPVideoHeaderVP8& codec_header) {
   uint8_t tl0_pic_idx = codec_header.tl0PicIdx;
   uint8_t temporal_index = codec_header.temporalIdx;
-  auto layer_info_it = layer_info_.find(tl0_pic_idx);
+  LayerInfo* layer_info = GetLayerInfoVp8(tl0_pic_idx);
 
   // Update this layer info and newer.
-  while (layer_info_it != layer_info_.end()) {
-    if (layer_info_it->second[temporal_index] != -1 &&
-        AheadOf<uint16_t, kPicIdLength>(layer_info_it->second[temporal_index],
+  while (layer_info) {
+    if ((*layer_info)[temporal_index] != -1 &&
+        AheadOf<uint16_t, kPicIdLength>((*layer_info)[temporal_index],
                                         frame->id.picture_id)) {
       // The frame was not newer, then no subsequent layer info have to be
       // update.
       break;
     }
 
-    layer_info_it->second[codec_header.temporalIdx] = frame->id.picture_id;
+    (*layer_info)[codec_header.temporalIdx] = frame->id.picture_id;
     ++tl0_pic_idx;
-    layer_info_it = layer_info_.find(tl0_pic_idx);
+    layer_info = GetLayerInfoVp8(tl0_pic_idx);
   }
   not_yet_received_frames_.erase(frame->id.picture_id);
 
   UnwrapPictureIds(frame);
 }
 
+RtpFrameReferenceFinder::LayerInfo* RtpFrameReferenceFinder::GetLayerInfoVp8(
+    uint8_t tl0_pic_idx) {
+  if (!layer_info_tl0_pic_idxs_.contains(tl0_pic_idx))
+    return nullptr;
+  return &layer_info_[tl0_pic_idx];
+}
+
+RtpFrameReferenceFinder::LayerInfo* RtpFrameReferenceFinder::AddLayerInfoVp8(
+    uint8_t tl0_pic_idx,
+    const LayerInfo& layer_info) {
+  if (!layer_info_tl0_pic_idxs_.contains(tl0_pic_idx)) {
+    // Layer info that is too far from |tl0_pic_idx| is of no use anymore.
+    if (!layer_info_tl0_pic_idxs_.CanInsert(tl0_pic_idx))
+      layer_info_tl0_pic_idxs_.clear();
+    layer_info_tl0_pic_idxs_.insert(tl0_pic_idx);
+    layer_info_[tl0_pic_idx] = layer_info;
+  }
+  return &layer_info_[tl0_pic_idx];
+}
+
 RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
     RtpFrameObject* frame) {
   rtc::Optional<RTPVideoTypeHeader> rtp_codec_header = frame->GetCodecHeader();
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "modules/include/module_common_types.h"
+#include "modules/video_coding/seq_num_bitmap.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -64,9 +65,12 @@ class RtpFrameReferenceFinder {
   static const int kMaxNotYetReceivedFrames = 100;
   static const int kMaxGofSaved = 50;
   static const int kMaxPaddingAge = 100;
+  static const int kTl0PicIdxLength = 1 << 8;
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
+  using LayerInfo = std::array<int16_t, kMaxTemporalLayers>;
+
   struct GofInfo {
     GofInfo(GofInfoVP9* gof, uint16_t last_picture_id)
         : gof(gof), last_picture_id(last_picture_id) {}
@@ -103,6 +107,16 @@ class RtpFrameReferenceFinder {
                           const RTPVideoHeaderVP8& codec_header)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the layer info for |tl0_pic_idx|, or nullptr if there is none.
+  LayerInfo* GetLayerInfoVp8(uint8_t tl0_pic_idx)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Adds layer info for |tl0_pic_idx|, initialized to |layer_info|, unless
+  // there already is layer info for |tl0_pic_idx|. Returns the layer info for
+  // |tl0_pic_idx|.
+  LayerInfo* AddLayerInfoVp8(uint8_t tl0_pic_idx, const LayerInfo& layer_info)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Find references for Vp9 frames
   FrameDecision ManageFrameVp9(RtpFrameObject* frame)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -163,8 +177,7 @@ class RtpFrameReferenceFinder {
 
   // Padding packets that have been received but that are not yet continuous
   // with any group of pictures.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> stashed_padding_
-      RTC_GUARDED_BY(crit_);
+  SeqNumBitmap stashed_padding_ RTC_GUARDED_BY(crit_);
 
   // The last unwrapped picture id. Used to unwrap the picture id from a length
   // of |kPicIdLength| to 16 bits.
@@ -172,8 +185,7 @@ class RtpFrameReferenceFinder {
 
   // Frames earlier than the last received frame that have not yet been
   // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
-      not_yet_received_frames_ RTC_GUARDED_BY(crit_);
+  SeqNumBitmap not_yet_received_frames_ RTC_GUARDED_BY(crit_);
 
   // Frames that have been fully received but didn't have all the information
   // needed to determine their references.
@@ -181,11 +193,10 @@ class RtpFrameReferenceFinder {
       RTC_GUARDED_BY(crit_);
 
   // Holds the information about the last completed frame for a given temporal
-  // layer given a Tl0 picture index.
-  std::map<uint8_t,
-           std::array<int16_t, kMaxTemporalLayers>,
-           DescendingSeqNumComp<uint8_t>>
-      layer_info_ RTC_GUARDED_BY(crit_);
+  // layer given a Tl0 picture index. Only the entries whose Tl0 picture index
+  // is in |layer_info_tl0_pic_idxs_| are valid.
+  std::array<LayerInfo, kTl0PicIdxLength> layer_info_ RTC_GUARDED_BY(crit_);
+  SeqNumBitmap layer_info_tl0_pic_idxs_ RTC_GUARDED_BY(crit_);
 
   // Where the current scalability structure is in the
   // |scalability_structures_| array.
@@ -0,0 +1,300 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitmap.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace video_coding {
+
+namespace {
+constexpr size_t kBitsPerWord = 64;
+
+int CountLeadingZeros(uint64_t x) {
+  RTC_DCHECK_NE(x, 0);
+#if defined(__GNUC__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  for (; !(x >> 63); x <<= 1)
+    ++n;
+  return n;
+#endif
+}
+
+size_t PopCount(uint64_t x) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(x);
+#else
+  size_t n = 0;
+  for (; x; x &= x - 1)
+    ++n;
+  return n;
+#endif
+}
+
+// Returns a mask of |count| bits starting at |bit|.
+uint64_t BitMask(size_t bit, size_t count) {
+  RTC_DCHECK_LE(bit + count, kBitsPerWord);
+  const uint64_t mask =
+      count == kBitsPerWord ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+  return mask << bit;
+}
+}  // namespace
+
+SeqNumBitmap::const_iterator::const_iterator(const SeqNumBitmap* bitmap,
+                                             uint16_t seq_num,
+                                             bool end)
+    : bitmap_(bitmap), seq_num_(seq_num), end_(end) {
+  if (!end_)
+    remaining_bits_ = bitmap_->BitsFrom(seq_num_) & ~uint64_t{1};
+}
+
+SeqNumBitmap::const_iterator&
+SeqNumBitmap::const_iterator::AdvanceToNextWord() {
+  RTC_DCHECK(!end_);
+  RTC_DCHECK_EQ(remaining_bits_, 0);
+  rtc::Optional<uint16_t> next =
+      bitmap_->NextAtOrAfter(bitmap_->Add(seq_num_, 1));
+  if (next) {
+    seq_num_ = *next;
+    remaining_bits_ = bitmap_->BitsFrom(seq_num_) & ~uint64_t{1};
+  } else {
+    end_ = true;
+  }
+  return *this;
+}
+
+SeqNumBitmap::SeqNumBitmap(size_t window_size)
+    : SeqNumBitmap(window_size, 1 << 16) {}
+
+SeqNumBitmap::SeqNumBitmap(size_t window_size, size_t modulus)
+    : window_size_(window_size),
+      mask_(modulus - 1),
+      bits_(window_size / kBitsPerWord, 0) {
+  RTC_DCHECK_EQ(window_size & (window_size - 1), 0);
+  RTC_DCHECK_EQ(modulus & (modulus - 1), 0);
+  RTC_DCHECK_GE(window_size, kBitsPerWord);
+  RTC_DCHECK_LE(modulus, 1 << 16);
+  RTC_DCHECK_LE(window_size, modulus / 2);
+}
+
+SeqNumBitmap::~SeqNumBitmap() = default;
+
+SeqNumBitmap::const_iterator SeqNumBitmap::begin() const {
+  if (empty())
+    return end();
+  return const_iterator(this, oldest_, false);
+}
+
+uint16_t SeqNumBitmap::oldest() const {
+  RTC_DCHECK(!empty());
+  return oldest_;
+}
+
+uint16_t SeqNumBitmap::newest() const {
+  RTC_DCHECK(!empty());
+  return newest_;
+}
+
+bool SeqNumBitmap::contains(uint16_t seq_num) const {
+  if (empty() ||
+      Diff(oldest_, seq_num) > Diff(oldest_, newest_)) {
+    return false;
+  }
+  const size_t index = seq_num & (window_size_ - 1);
+  return (bits_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+bool SeqNumBitmap::CanInsert(uint16_t seq_num) const {
+  if (empty() ||
+      Diff(oldest_, seq_num) <= Diff(oldest_, newest_)) {
+    return true;
+  }
+  if (IsAheadOf(seq_num, newest_))
+    return Diff(oldest_, seq_num) < window_size_;
+  return Diff(seq_num, newest_) < window_size_;
+}
+
+bool SeqNumBitmap::insert(uint16_t seq_num) {
+  RTC_DCHECK_LE(seq_num, mask_);
+  RTC_DCHECK(CanInsert(seq_num));
+  if (empty()) {
+    oldest_ = seq_num;
+    newest_ = seq_num;
+  } else if (IsAheadOf(seq_num, newest_)) {
+    newest_ = seq_num;
+  } else if (IsAheadOf(oldest_, seq_num)) {
+    oldest_ = seq_num;
+  }
+
+  if (SetBits(seq_num, 1) == 0)
+    return false;
+  ++size_;
+  return true;
+}
+
+void SeqNumBitmap::InsertRange(uint16_t begin, uint16_t end) {
+  const size_t count = Diff(begin, end);
+  if (count == 0)
+    return;
+  RTC_DCHECK_LE(begin, mask_);
+  RTC_DCHECK(empty() || IsAheadOf(begin, newest_));
+  RTC_DCHECK(CanInsert(Subtract(end, 1)));
+
+  if (empty())
+    oldest_ = begin;
+  newest_ = Subtract(end, 1);
+  size_ += SetBits(begin, count);
+}
+
+bool SeqNumBitmap::erase(uint16_t seq_num) {
+  if (!contains(seq_num))
+    return false;
+
+  ClearBits(seq_num, 1);
+  --size_;
+  if (empty())
+    return true;
+
+  if (seq_num == oldest_) {
+    const uint16_t next = Add(oldest_, 1);
+    oldest_ = Add(next, FindSetBitForward(next, Diff(next, newest_) + 1));
+  } else if (seq_num == newest_) {
+    const uint16_t prev = Subtract(newest_, 1);
+    newest_ =
+        Subtract(prev, FindSetBitBackward(prev, Diff(oldest_, prev) + 1));
+  }
+  return true;
+}
+
+void SeqNumBitmap::EraseBefore(uint16_t seq_num) {
+  RTC_DCHECK_LE(seq_num, mask_);
+  if (empty() || !IsAheadOf(seq_num, oldest_))
+    return;
+
+  if (IsAheadOf(seq_num, newest_)) {
+    clear();
+    return;
+  }
+
+  size_ -= ClearBits(oldest_, Diff(oldest_, seq_num));
+  RTC_DCHECK(!empty());
+  oldest_ =
+      Add(seq_num, FindSetBitForward(seq_num, Diff(seq_num, newest_) + 1));
+}
+
+void SeqNumBitmap::clear() {
+  if (!empty())
+    ClearBits(oldest_, Diff(oldest_, newest_) + 1);
+  size_ = 0;
+}
+
+rtc::Optional<uint16_t> SeqNumBitmap::NextAtOrAfter(uint16_t seq_num) const {
+  if (empty() || IsAheadOf(seq_num, newest_))
+    return rtc::nullopt;
+
+  const uint16_t start = IsAheadOf(oldest_, seq_num) ? oldest_ : seq_num;
+  const size_t count = Diff(start, newest_) + 1;
+  const size_t distance = FindSetBitForward(start, count);
+  RTC_DCHECK_LT(distance, count);
+  return Add(start, distance);
+}
+
+rtc::Optional<uint16_t> SeqNumBitmap::PrevAtOrBefore(uint16_t seq_num) const {
+  if (empty() || IsAheadOf(oldest_, seq_num))
+    return rtc::nullopt;
+
+  const uint16_t start = IsAheadOf(seq_num, newest_) ? newest_ : seq_num;
+  const size_t count = Diff(oldest_, start) + 1;
+  const size_t distance = FindSetBitBackward(start, count);
+  RTC_DCHECK_LT(distance, count);
+  return Subtract(start, distance);
+}
+
+size_t SeqNumBitmap::SetBits(uint16_t seq_num, size_t count) {
+  RTC_DCHECK_LE(count, window_size_);
+  size_t num_changed = 0;
+  size_t index = seq_num & (window_size_ - 1);
+  while (count > 0) {
+    const size_t bit = index % kBitsPerWord;
+    const size_t num_bits = std::min(kBitsPerWord - bit, count);
+    const uint64_t mask = BitMask(bit, num_bits);
+    uint64_t& word = bits_[index / kBitsPerWord];
+    num_changed += PopCount(mask & ~word);
+    word |= mask;
+    index = (index + num_bits) & (window_size_ - 1);
+    count -= num_bits;
+  }
+  return num_changed;
+}
+
+size_t SeqNumBitmap::ClearBits(uint16_t seq_num, size_t count) {
+  RTC_DCHECK_LE(count, window_size_);
+  size_t num_changed = 0;
+  size_t index = seq_num & (window_size_ - 1);
+  while (count > 0) {
+    const size_t bit = index % kBitsPerWord;
+    const size_t num_bits = std::min(kBitsPerWord - bit, count);
+    const uint64_t mask = BitMask(bit, num_bits);
+    uint64_t& word = bits_[index / kBitsPerWord];
+    num_changed += PopCount(mask & word);
+    word &= ~mask;
+    index = (index + num_bits) & (window_size_ - 1);
+    count -= num_bits;
+  }
+  return num_changed;
+}
+
+uint64_t SeqNumBitmap::BitsFrom(uint16_t seq_num) const {
+  RTC_DCHECK(contains(seq_num));
+  const size_t index = seq_num & (window_size_ - 1);
+  const size_t bit = index % kBitsPerWord;
+  const size_t num_bits =
+      std::min<size_t>(kBitsPerWord - bit, Diff(seq_num, newest_) + 1);
+  return (bits_[index / kBitsPerWord] & BitMask(bit, num_bits)) >> bit;
+}
+
+size_t SeqNumBitmap::FindSetBitForward(uint16_t seq_num, size_t count) const {
+  size_t distance = 0;
+  size_t index = seq_num & (window_size_ - 1);
+  while (distance < count) {
+    const size_t bit = index % kBitsPerWord;
+    const size_t num_bits = std::min(kBitsPerWord - bit, count - distance);
+    const uint64_t word = bits_[index / kBitsPerWord] & BitMask(bit, num_bits);
+    if (word != 0)
+      return distance + CountTrailingZeros(word) - bit;
+    distance += num_bits;
+    index = (index + num_bits) & (window_size_ - 1);
+  }
+  return count;
+}
+
+size_t SeqNumBitmap::FindSetBitBackward(uint16_t seq_num, size_t count) const {
+  size_t distance = 0;
+  size_t index = seq_num & (window_size_ - 1);
+  while (distance < count) {
+    const size_t bit = index % kBitsPerWord;
+    const size_t num_bits = std::min(bit + 1, count - distance);
+    const uint64_t word =
+        bits_[index / kBitsPerWord] & BitMask(bit + 1 - num_bits, num_bits);
+    if (word != 0)
+      return distance + bit - (kBitsPerWord - 1 - CountLeadingZeros(word));
+    distance += num_bits;
+    index = (index - num_bits) & (window_size_ - 1);
+  }
+  return count;
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
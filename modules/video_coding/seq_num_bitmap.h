@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
+#define MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "api/optional.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// A set of sequence numbers, ordered in the sense of AheadOf(), stored as a
+// bitmap over a window of |window_size| sequence numbers. All sequence numbers
+// in the set must fit within the window, i.e. newest() - oldest() must be
+// smaller than |window_size|.
+//
+// Inserting, erasing and looking up a sequence number is O(1). Erasing
+// prefixes and searching for the next sequence number in the set are done a
+// machine word at a time, and never allocate.
+class SeqNumBitmap {
+ public:
+  // Iterates over the set from the oldest to the newest sequence number.
+  // Erasing the sequence number an iterator points to does not invalidate it.
+  class const_iterator {
+   public:
+    uint16_t operator*() const { return seq_num_; }
+    const_iterator& operator++() {
+      // Most of the time the next sequence number is in the same word, in
+      // which case there is no need to look at the bitmap again.
+      if (remaining_bits_ == 0)
+        return AdvanceToNextWord();
+      const int distance = CountTrailingZeros(remaining_bits_);
+      seq_num_ = bitmap_->Add(seq_num_, distance);
+      remaining_bits_ = (remaining_bits_ & (remaining_bits_ - 1)) >> distance;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return end_ == other.end_ && (end_ || seq_num_ == other.seq_num_);
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class SeqNumBitmap;
+    const_iterator(const SeqNumBitmap* bitmap, uint16_t seq_num, bool end);
+    const_iterator& AdvanceToNextWord();
+
+    const SeqNumBitmap* bitmap_;
+    uint16_t seq_num_;
+    bool end_;
+    // The set bits of the word |seq_num_| is in that are newer than |seq_num_|
+    // and not newer than newest(), shifted so that bit 0 is |seq_num_|.
+    uint64_t remaining_bits_ = 0;
+  };
+
+  // |window_size| must be a power of 2 and at least 64. Sequence numbers wrap
+  // at |modulus|, which must be a power of 2 of at most 2^16 and at least
+  // twice |window_size|, like the M parameter of AheadOf<uint16_t, M>().
+  explicit SeqNumBitmap(size_t window_size);
+  SeqNumBitmap(size_t window_size, size_t modulus);
+  ~SeqNumBitmap();
+
+  const_iterator begin() const;
+  const_iterator end() const { return const_iterator(this, 0, true); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t window_size() const { return window_size_; }
+
+  // The oldest and the newest sequence number in the set. The set must not
+  // be empty.
+  uint16_t oldest() const;
+  uint16_t newest() const;
+
+  bool contains(uint16_t seq_num) const;
+
+  // Returns true if |seq_num| can be inserted while keeping all sequence
+  // numbers within the window.
+  bool CanInsert(uint16_t seq_num) const;
+
+  // Inserts |seq_num|, which must satisfy CanInsert(). Returns false if it was
+  // already in the set.
+  bool insert(uint16_t seq_num);
+
+  // Inserts all sequence numbers from |begin| up to, but not including, |end|.
+  // The range must be newer than newest() and fit within the window.
+  void InsertRange(uint16_t begin, uint16_t end);
+
+  // Returns false if |seq_num| was not in the set.
+  bool erase(uint16_t seq_num);
+
+  // Erases all sequence numbers older than |seq_num|.
+  void EraseBefore(uint16_t seq_num);
+
+  void clear();
+
+  // Returns the oldest sequence number in the set that is |seq_num| or newer.
+  rtc::Optional<uint16_t> NextAtOrAfter(uint16_t seq_num) const;
+
+  // Returns the newest sequence number in the set that is |seq_num| or older.
+  rtc::Optional<uint16_t> PrevAtOrBefore(uint16_t seq_num) const;
+
+ private:
+  // Arithmetic modulo |mask_| + 1.
+  uint16_t Add(uint16_t a, size_t b) const {
+    return static_cast<uint16_t>((a + b) & mask_);
+  }
+  uint16_t Subtract(uint16_t a, size_t b) const {
+    return static_cast<uint16_t>((a - b) & mask_);
+  }
+  // Same as ForwardDiff<uint16_t, M>(a, b).
+  size_t Diff(uint16_t a, uint16_t b) const { return (b - a) & mask_; }
+  // Same as AheadOf<uint16_t, M>(a, b).
+  bool IsAheadOf(uint16_t a, uint16_t b) const {
+    const size_t diff = Diff(b, a);
+    const size_t half = (mask_ >> 1) + 1;
+    return diff == half ? b < a : diff != 0 && diff < half;
+  }
+
+  // |x| must not be 0.
+  static int CountTrailingZeros(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    for (; !(x & 1); x >>= 1)
+      ++n;
+    return n;
+#endif
+  }
+
+  // Sets or clears |count| bits starting at |seq_num|. Returns the number of
+  // bits that changed.
+  size_t SetBits(uint16_t seq_num, size_t count);
+  size_t ClearBits(uint16_t seq_num, size_t count);
+
+  // Returns the bits of the word |seq_num| is in, from |seq_num| up to the end
+  // of the word or to newest(), whichever comes first. Bit 0 is |seq_num|.
+  uint64_t BitsFrom(uint16_t seq_num) const;
+
+  // Returns the distance from |seq_num| to the first set bit within |count|
+  // bits at or after |seq_num|, or |count| if there is none.
+  size_t FindSetBitForward(uint16_t seq_num, size_t count) const;
+  // Returns the distance from |seq_num| to the first set bit within |count|
+  // bits at or before |seq_num|, or |count| if there is none.
+  size_t FindSetBitBackward(uint16_t seq_num, size_t count) const;
+
+  const size_t window_size_;
+  const size_t mask_;
+  std::vector<uint64_t> bits_;
+  uint16_t oldest_ = 0;
+  uint16_t newest_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
@@ -0,0 +1,195 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitmap.h"
+
+#include <set>
+#include <vector>
+
+#include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr int kWindowSize = 1024;
+
+std::vector<uint16_t> ToVector(const SeqNumBitmap& bitmap) {
+  std::vector<uint16_t> seq_nums;
+  for (uint16_t seq_num : bitmap)
+    seq_nums.push_back(seq_num);
+  return seq_nums;
+}
+
+}  // namespace
+
+TEST(SeqNumBitmapTest, Empty) {
+  SeqNumBitmap bitmap(kWindowSize);
+  EXPECT_TRUE(bitmap.empty());
+  EXPECT_EQ(0u, bitmap.size());
+  EXPECT_TRUE(bitmap.begin() == bitmap.end());
+  EXPECT_FALSE(bitmap.contains(0));
+  EXPECT_FALSE(bitmap.NextAtOrAfter(0));
+  EXPECT_FALSE(bitmap.PrevAtOrBefore(0));
+  EXPECT_TRUE(bitmap.CanInsert(12345));
+}
+
+TEST(SeqNumBitmapTest, InsertAndErase) {
+  SeqNumBitmap bitmap(kWindowSize);
+  EXPECT_TRUE(bitmap.insert(10));
+  EXPECT_TRUE(bitmap.insert(5));
+  EXPECT_TRUE(bitmap.insert(20));
+  EXPECT_FALSE(bitmap.insert(10));
+  EXPECT_EQ(3u, bitmap.size());
+  EXPECT_EQ(5, bitmap.oldest());
+  EXPECT_EQ(20, bitmap.newest());
+  EXPECT_EQ(std::vector<uint16_t>({5, 10, 20}), ToVector(bitmap));
+
+  EXPECT_TRUE(bitmap.erase(5));
+  EXPECT_FALSE(bitmap.erase(5));
+  EXPECT_EQ(10, bitmap.oldest());
+  EXPECT_TRUE(bitmap.erase(20));
+  EXPECT_EQ(10, bitmap.newest());
+  EXPECT_TRUE(bitmap.erase(10));
+  EXPECT_TRUE(bitmap.empty());
+}
+
+TEST(SeqNumBitmapTest, Wrapping) {
+  SeqNumBitmap bitmap(kWindowSize);
+  bitmap.InsertRange(0xfffe, 2);
+  EXPECT_EQ(4u, bitmap.size());
+  EXPECT_EQ(0xfffe, bitmap.oldest());
+  EXPECT_EQ(1, bitmap.newest());
+  EXPECT_EQ(std::vector<uint16_t>({0xfffe, 0xffff, 0, 1}), ToVector(bitmap));
+
+  bitmap.EraseBefore(0);
+  EXPECT_EQ(std::vector<uint16_t>({0, 1}), ToVector(bitmap));
+}
+
+TEST(SeqNumBitmapTest, Window) {
+  SeqNumBitmap bitmap(kWindowSize);
+  bitmap.insert(100);
+  EXPECT_TRUE(bitmap.CanInsert(100 + kWindowSize - 1));
+  EXPECT_FALSE(bitmap.CanInsert(100 + kWindowSize));
+  EXPECT_TRUE(bitmap.CanInsert(101 - kWindowSize));
+  EXPECT_FALSE(bitmap.CanInsert(100 - kWindowSize));
+
+  // A sequence number that maps to the same bit is not in the set.
+  EXPECT_FALSE(bitmap.contains(100 + kWindowSize));
+}
+
+TEST(SeqNumBitmapTest, EraseBefore) {
+  SeqNumBitmap bitmap(kWindowSize);
+  bitmap.insert(10);
+  bitmap.insert(200);
+  bitmap.insert(300);
+
+  bitmap.EraseBefore(10);
+  EXPECT_EQ(3u, bitmap.size());
+  bitmap.EraseBefore(200);
+  EXPECT_EQ(std::vector<uint16_t>({200, 300}), ToVector(bitmap));
+  bitmap.EraseBefore(250);
+  EXPECT_EQ(std::vector<uint16_t>({300}), ToVector(bitmap));
+  bitmap.EraseBefore(301);
+  EXPECT_TRUE(bitmap.empty());
+}
+
+TEST(SeqNumBitmapTest, NextAndPrev) {
+  SeqNumBitmap bitmap(kWindowSize);
+  bitmap.insert(100);
+  bitmap.insert(500);
+
+  EXPECT_EQ(100, *bitmap.NextAtOrAfter(50));
+  EXPECT_EQ(100, *bitmap.NextAtOrAfter(100));
+  EXPECT_EQ(500, *bitmap.NextAtOrAfter(101));
+  EXPECT_FALSE(bitmap.NextAtOrAfter(501));
+
+  EXPECT_FALSE(bitmap.PrevAtOrBefore(99));
+  EXPECT_EQ(100, *bitmap.PrevAtOrBefore(499));
+  EXPECT_EQ(500, *bitmap.PrevAtOrBefore(500));
+  EXPECT_EQ(500, *bitmap.PrevAtOrBefore(600));
+}
+
+TEST(SeqNumBitmapTest, EraseWhileIterating) {
+  SeqNumBitmap bitmap(kWindowSize);
+  bitmap.InsertRange(0, 10);
+  for (uint16_t seq_num : bitmap) {
+    if (seq_num % 2 == 0)
+      bitmap.erase(seq_num);
+  }
+  EXPECT_EQ(std::vector<uint16_t>({1, 3, 5, 7, 9}), ToVector(bitmap));
+}
+
+TEST(SeqNumBitmapTest, WrappingWithModulus) {
+  constexpr size_t kModulus = 1 << 15;
+  SeqNumBitmap bitmap(kWindowSize, kModulus);
+  bitmap.InsertRange(kModulus - 2, 2);
+  EXPECT_EQ(4u, bitmap.size());
+  EXPECT_EQ(kModulus - 2, bitmap.oldest());
+  EXPECT_EQ(1, bitmap.newest());
+  EXPECT_EQ(std::vector<uint16_t>({kModulus - 2, kModulus - 1, 0, 1}),
+            ToVector(bitmap));
+  EXPECT_EQ(0, *bitmap.NextAtOrAfter(0));
+  EXPECT_EQ(kModulus - 1, *bitmap.PrevAtOrBefore(kModulus - 1));
+  EXPECT_TRUE(bitmap.CanInsert(kModulus - kWindowSize + 2));
+  EXPECT_FALSE(bitmap.CanInsert(kModulus - kWindowSize + 1));
+
+  bitmap.EraseBefore(0);
+  EXPECT_EQ(std::vector<uint16_t>({0, 1}), ToVector(bitmap));
+}
+
+// Performs random operations on a SeqNumBitmap and on a std::set and verifies
+// that they behave the same.
+template <uint16_t M>
+void RunMatchesStdSetTest() {
+  const size_t modulus = M == 0 ? 1 << 16 : M;
+  SeqNumBitmap bitmap(kWindowSize, modulus);
+  std::set<uint16_t, DescendingSeqNumComp<uint16_t, M>> reference;
+  Random random(0x5a2f31);
+  uint16_t base = random.Rand<uint16_t>() % modulus;
+
+  for (int i = 0; i < 100000; ++i) {
+    const uint16_t seq_num = (base + random.Rand(0, kWindowSize - 1)) % modulus;
+    switch (random.Rand(0, 3)) {
+      case 0:
+        if (bitmap.CanInsert(seq_num)) {
+          EXPECT_EQ(reference.insert(seq_num).second, bitmap.insert(seq_num));
+        }
+        break;
+      case 1:
+        EXPECT_EQ(reference.erase(seq_num) > 0, bitmap.erase(seq_num));
+        break;
+      case 2:
+        bitmap.EraseBefore(seq_num);
+        reference.erase(reference.begin(), reference.lower_bound(seq_num));
+        base = (base + kWindowSize / 8) % modulus;
+        break;
+      case 3:
+        EXPECT_EQ(reference.count(seq_num) > 0, bitmap.contains(seq_num));
+        break;
+    }
+    ASSERT_EQ(reference.size(), bitmap.size());
+  }
+  EXPECT_EQ(std::vector<uint16_t>(reference.begin(), reference.end()),
+            ToVector(bitmap));
+}
+
+TEST(SeqNumBitmapTest, MatchesStdSet) {
+  RunMatchesStdSetTest<0>();
+}
+
+TEST(SeqNumBitmapTest, MatchesStdSetWithModulus) {
+  RunMatchesStdSetTest<1 << 15>();
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -9,17 +9,21 @@
  */
 
 #include <cstring>
+#include <deque>
 #include <map>
 #include <set>
+#include <string>
 #include <utility>
 
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "rtc_base/random.h"
+#include "rtc_base/timeutils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace video_coding {
@@ -790,6 +794,64 @@ TEST_F(TestPacketBuffer, TooManyNalusInPacket) {
   EXPECT_EQ(0UL, frames_from_callback_.size());
 }
 
+// Replays a high bitrate stream with heavy loss, where lost packets are
+// retransmitted one round trip later, and reports the time spent per inserted
+// packet.
+TEST_F(TestPacketBuffer, DISABLED_LossPatternPerformance) {
+  class FrameCounter : public OnReceivedFrameCallback {
+   public:
+    void OnReceivedFrame(std::unique_ptr<RtpFrameObject> frame) override {
+      ++num_frames;
+    }
+    int num_frames = 0;
+  };
+
+  const int kNumPackets = 200000;
+  const int kPacketsPerFrame = 20;
+  const int kRetransmissionDelayPackets = 100;
+
+  for (float loss_rate : {0.1f, 0.2f}) {
+    FrameCounter frame_counter;
+    rtc::scoped_refptr<PacketBuffer> packet_buffer(
+        PacketBuffer::Create(clock_.get(), 512, 2048, &frame_counter));
+    // Lost packets, and the packet index at which they are retransmitted.
+    std::deque<std::pair<int, VCMPacket>> retransmissions;
+    VCMPacket packet;
+    packet.codec = kVideoCodecGeneric;
+    int num_inserted_packets = 0;
+
+    const int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumPackets; ++i) {
+      while (!retransmissions.empty() && retransmissions.front().first <= i) {
+        EXPECT_TRUE(packet_buffer->InsertPacket(
+            &retransmissions.front().second));
+        ++num_inserted_packets;
+        retransmissions.pop_front();
+      }
+
+      packet.seqNum = static_cast<uint16_t>(i);
+      packet.timestamp = static_cast<uint32_t>(i / kPacketsPerFrame * 3000);
+      packet.frameType =
+          i < kPacketsPerFrame ? kVideoFrameKey : kVideoFrameDelta;
+      packet.is_first_packet_in_frame = i % kPacketsPerFrame == 0;
+      packet.markerBit = i % kPacketsPerFrame == kPacketsPerFrame - 1;
+      if (rand_.Rand<float>() < loss_rate) {
+        retransmissions.emplace_back(i + kRetransmissionDelayPackets, packet);
+        continue;
+      }
+      EXPECT_TRUE(packet_buffer->InsertPacket(&packet));
+      ++num_inserted_packets;
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+
+    EXPECT_GT(frame_counter.num_frames, 0);
+    test::PrintResult("packet_buffer_time_per_packet", "",
+                      std::to_string(static_cast<int>(loss_rate * 100)) +
+                          "_percent_loss",
+                      elapsed_us * 1000.0 / num_inserted_packets, "ns", false);
+  }
+}
+
 TEST_P(TestPacketBufferH264Parameterized, OneFrameFillBuffer) {
   InsertH264(0, kKeyFrame, kFirst, kNotLast, 1000);
   for (int i = 1; i < kStartSize - 1; ++i)
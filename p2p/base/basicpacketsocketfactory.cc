@@ -60,7 +60,10 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateUdpSocket(
     delete socket;
     return NULL;
   }
-  return new AsyncUDPSocket(socket);
+  AsyncUDPSocket* udp_socket = new AsyncUDPSocket(socket);
+  if (udp_read_batch_size_ > 1)
+    udp_socket->EnableBatchedReads(udp_read_batch_size_);
+  return udp_socket;
 }
 
 AsyncPacketSocket* BasicPacketSocketFactory::CreateServerTcpSocket(
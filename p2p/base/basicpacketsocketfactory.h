@@ -49,6 +49,10 @@ class BasicPacketSocketFactory : public PacketSocketFactory {
 
   AsyncResolverInterface* CreateAsyncResolver() override;
 
+  // Lets UDP sockets created by this factory drain up to |size| packets per
+  // read event. See AsyncPacketSocket::EnableBatchedReads().
+  void set_udp_read_batch_size(size_t size) { udp_read_batch_size_ = size; }
+
  private:
   int BindSocket(AsyncSocket* socket,
                  const SocketAddress& local_address,
@@ -59,6 +63,7 @@ class BasicPacketSocketFactory : public PacketSocketFactory {
 
   Thread* thread_;
   SocketFactory* socket_factory_;
+  size_t udp_read_batch_size_ = 1;
 };
 
 }  // namespace rtc
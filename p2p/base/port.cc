@@ -61,6 +61,30 @@ inline bool TooLongWithoutResponse(
   return now > (first.sent_time + maximum_time);
 }
 
+// Returns null unless |data| is a complete and correct STUN message.
+std::unique_ptr<cricket::IceMessage> ReadIceMessage(const char* data,
+                                                    size_t size) {
+  std::unique_ptr<cricket::IceMessage> msg(new cricket::IceMessage());
+  rtc::ByteBufferReader buf(data, size);
+  if (!msg->Read(&buf) || (buf.Length() > 0))
+    return nullptr;
+  return msg;
+}
+
+// Splits a USERNAME of the form "LFRAG:RFRAG".
+bool SplitStunUsername(const std::string& username,
+                       std::string* local_ufrag,
+                       std::string* remote_ufrag) {
+  size_t colon_pos = username.find(":");
+  if (colon_pos == std::string::npos) {
+    return false;
+  }
+
+  *local_ufrag = username.substr(0, colon_pos);
+  *remote_ufrag = username.substr(colon_pos + 1, username.size());
+  return true;
+}
+
 // Helper methods for converting string values of log description fields to
 // enum.
 webrtc::IceCandidateType GetCandidateTypeByString(const std::string& type) {
@@ -527,101 +551,114 @@ bool Port::GetStunMessage(const char* data,
                           const rtc::SocketAddress& addr,
                           std::unique_ptr<IceMessage>* out_msg,
                           std::string* out_username) {
-  // NOTE: This could clearly be optimized to avoid allocating any memory.
-  //       However, at the data rates we'll be looking at on the client side,
-  //       this probably isn't worth worrying about.
   RTC_DCHECK(out_msg != NULL);
   RTC_DCHECK(out_username != NULL);
   out_username->clear();
 
-  // Don't bother parsing the packet if we can tell it's not STUN.
-  // In ICE mode, all STUN packets will have a valid fingerprint.
-  if (!StunMessage::ValidateFingerprint(data, size)) {
+  // Don't bother parsing the packet if we can tell it's not STUN. In ICE
+  // mode, all STUN packets will have a valid fingerprint. The checks below are
+  // done on |view| as well; the packet is only parsed into an IceMessage to be
+  // handed out or answered with an error.
+  StunMessageView view;
+  if (!view.Parse(data, size) || !view.ValidateFingerprint()) {
     return false;
   }
 
-  // Parse the request message.  If the packet is not a complete and correct
-  // STUN message, then ignore it.
-  std::unique_ptr<IceMessage> stun_msg(new IceMessage());
-  rtc::ByteBufferReader buf(data, size);
-  if (!stun_msg->Read(&buf) || (buf.Length() > 0)) {
-    return false;
-  }
-
-  if (stun_msg->type() == STUN_BINDING_REQUEST) {
+  std::string remote_ufrag;
+  if (view.type() == STUN_BINDING_REQUEST) {
     // Check for the presence of USERNAME and MESSAGE-INTEGRITY (if ICE) first.
     // If not present, fail with a 400 Bad Request.
-    if (!stun_msg->GetByteString(STUN_ATTR_USERNAME) ||
-        !stun_msg->GetByteString(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    rtc::ArrayView<const char> username;
+    if (!view.GetAttribute(STUN_ATTR_USERNAME, &username) ||
+        !view.HasAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
       RTC_LOG(LS_ERROR) << ToString()
                         << ": Received STUN request without username/M-I from: "
                         << addr.ToSensitiveString();
-      SendBindingErrorResponse(stun_msg.get(), addr, STUN_ERROR_BAD_REQUEST,
+      std::unique_ptr<IceMessage> request = ReadIceMessage(data, size);
+      if (!request)
+        return false;
+      SendBindingErrorResponse(request.get(), addr, STUN_ERROR_BAD_REQUEST,
                                STUN_ERROR_REASON_BAD_REQUEST);
       return true;
     }
 
     // If the username is bad or unknown, fail with a 401 Unauthorized.
     std::string local_ufrag;
-    std::string remote_ufrag;
-    if (!ParseStunUsername(stun_msg.get(), &local_ufrag, &remote_ufrag) ||
+    if (!SplitStunUsername(std::string(username.data(), username.size()),
+                           &local_ufrag, &remote_ufrag) ||
         local_ufrag != username_fragment()) {
       RTC_LOG(LS_ERROR) << ToString()
                         << ": Received STUN request with bad local username "
                         << local_ufrag << " from " << addr.ToSensitiveString();
-      SendBindingErrorResponse(stun_msg.get(), addr, STUN_ERROR_UNAUTHORIZED,
+      std::unique_ptr<IceMessage> request = ReadIceMessage(data, size);
+      if (!request)
+        return false;
+      SendBindingErrorResponse(request.get(), addr, STUN_ERROR_UNAUTHORIZED,
                                STUN_ERROR_REASON_UNAUTHORIZED);
       return true;
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (!stun_msg->ValidateMessageIntegrity(data, size, password_)) {
+    if (!sha1_) {
+      sha1_.reset(rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+    }
+    if (!view.ValidateMessageIntegrity(password_, sha1_.get())) {
       RTC_LOG(LS_ERROR) << ToString()
                         << ": Received STUN request with bad M-I from "
                         << addr.ToSensitiveString()
                         << ", password_=" << password_;
-      SendBindingErrorResponse(stun_msg.get(), addr, STUN_ERROR_UNAUTHORIZED,
+      std::unique_ptr<IceMessage> request = ReadIceMessage(data, size);
+      if (!request)
+        return false;
+      SendBindingErrorResponse(request.get(), addr, STUN_ERROR_UNAUTHORIZED,
                                STUN_ERROR_REASON_UNAUTHORIZED);
       return true;
     }
-    out_username->assign(remote_ufrag);
-  } else if ((stun_msg->type() == STUN_BINDING_RESPONSE) ||
-             (stun_msg->type() == STUN_BINDING_ERROR_RESPONSE)) {
-    if (stun_msg->type() == STUN_BINDING_ERROR_RESPONSE) {
-      if (const StunErrorCodeAttribute* error_code = stun_msg->GetErrorCode()) {
-        RTC_LOG(LS_ERROR) << ToString()
-                          << ": Received STUN binding error: class="
-                          << error_code->eclass()
-                          << " number=" << error_code->number() << " reason='"
-                          << error_code->reason() << "' from "
-                          << addr.ToSensitiveString();
-        // Return message to allow error-specific processing
-      } else {
-        RTC_LOG(LS_ERROR)
-            << ToString()
-            << ": Received STUN binding error without a error code from "
-            << addr.ToSensitiveString();
-        return true;
-      }
+  } else if ((view.type() == STUN_BINDING_RESPONSE) ||
+             (view.type() == STUN_BINDING_ERROR_RESPONSE)) {
+    if (view.type() == STUN_BINDING_ERROR_RESPONSE &&
+        !view.HasAttribute(STUN_ATTR_ERROR_CODE)) {
+      RTC_LOG(LS_ERROR)
+          << ToString()
+          << ": Received STUN binding error without a error code from "
+          << addr.ToSensitiveString();
+      return true;
     }
     // NOTE: Username should not be used in verifying response messages.
-    out_username->clear();
-  } else if (stun_msg->type() == STUN_BINDING_INDICATION) {
+  } else if (view.type() == STUN_BINDING_INDICATION) {
     RTC_LOG(LS_VERBOSE) << ToString()
                         << ": Received STUN binding indication: from "
                         << addr.ToSensitiveString();
-    out_username->clear();
     // No stun attributes will be verified, if it's stun indication message.
-    // Returning from end of the this method.
   } else {
     RTC_LOG(LS_ERROR) << ToString()
                       << ": Received STUN packet with invalid type ("
-                      << stun_msg->type() << ") from "
+                      << view.type() << ") from "
                       << addr.ToSensitiveString();
     return true;
   }
 
+  // Parse the message to hand it out. If the packet is not a complete and
+  // correct STUN message, then ignore it.
+  std::unique_ptr<IceMessage> stun_msg = ReadIceMessage(data, size);
+  if (!stun_msg) {
+    return false;
+  }
+
+  if (stun_msg->type() == STUN_BINDING_ERROR_RESPONSE) {
+    if (const StunErrorCodeAttribute* error_code = stun_msg->GetErrorCode()) {
+      RTC_LOG(LS_ERROR) << ToString()
+                        << ": Received STUN binding error: class="
+                        << error_code->eclass()
+                        << " number=" << error_code->number() << " reason='"
+                        << error_code->reason() << "' from "
+                        << addr.ToSensitiveString();
+      // Return message to allow error-specific processing
+    }
+  }
+
   // Return the STUN message found.
+  out_username->assign(remote_ufrag);
   *out_msg = std::move(stun_msg);
   return true;
 }
@@ -654,16 +691,8 @@ bool Port::ParseStunUsername(const StunMessage* stun_msg,
   if (username_attr == NULL)
     return false;
 
-  // RFRAG:LFRAG
-  const std::string username = username_attr->GetString();
-  size_t colon_pos = username.find(":");
-  if (colon_pos == std::string::npos) {
-    return false;
-  }
-
-  *local_ufrag = username.substr(0, colon_pos);
-  *remote_ufrag = username.substr(colon_pos + 1, username.size());
-  return true;
+  return SplitStunUsername(username_attr->GetString(), local_ufrag,
+                           remote_ufrag);
 }
 
 bool Port::MaybeIceRoleConflict(
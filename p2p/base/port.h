@@ -32,6 +32,7 @@
 #include "p2p/base/stunrequest.h"
 #include "rtc_base/asyncpacketsocket.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/messagedigest.h"
 #include "rtc_base/nethelper.h"
 #include "rtc_base/network.h"
 #include "rtc_base/proxyinfo.h"
@@ -477,6 +478,8 @@ class Port : public PortInterface, public rtc::MessageHandler,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // Reused to check the MESSAGE-INTEGRITY of incoming binding requests.
+  std::unique_ptr<rtc::MessageDigest> sha1_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
@@ -0,0 +1,182 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ptr_util.h"
+
+namespace cricket {
+
+namespace {
+
+const int kListenBacklog = 128;
+
+}  // namespace
+
+ShardedTurnServer::Shard::Shard() = default;
+ShardedTurnServer::Shard::Shard(Shard&&) = default;
+ShardedTurnServer::Shard::~Shard() = default;
+
+ShardedTurnServer::ShardedTurnServer(size_t num_shards) {
+  shards_.resize(std::max<size_t>(num_shards, 1));
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    Shard& shard = shards_[i];
+    shard.thread = rtc::Thread::CreateWithSocketServer();
+    shard.thread->SetName("turn_shard_" + std::to_string(i), nullptr);
+    shard.thread->Start();
+    shard.server = rtc::MakeUnique<TurnServer>(shard.thread.get());
+  }
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  // The sockets and timers of a server belong to its thread.
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&shard] { shard.server = nullptr; });
+  }
+}
+
+void ShardedTurnServer::set_realm(const std::string& realm) {
+  InvokeOnShards([&realm](TurnServer* server) { server->set_realm(realm); });
+}
+
+void ShardedTurnServer::set_software(const std::string& software) {
+  InvokeOnShards(
+      [&software](TurnServer* server) { server->set_software(software); });
+}
+
+void ShardedTurnServer::set_auth_hook(TurnAuthInterface* auth_hook) {
+  InvokeOnShards(
+      [auth_hook](TurnServer* server) { server->set_auth_hook(auth_hook); });
+}
+
+void ShardedTurnServer::set_enable_permission_checks(bool enable) {
+  InvokeOnShards([enable](TurnServer* server) {
+    server->set_enable_permission_checks(enable);
+  });
+}
+
+void ShardedTurnServer::set_reject_private_addresses(bool filter) {
+  InvokeOnShards([filter](TurnServer* server) {
+    server->set_reject_private_addresses(filter);
+  });
+}
+
+rtc::SocketAddress ShardedTurnServer::AddInternalSocket(
+    const rtc::SocketAddress& address,
+    ProtocolType proto) {
+  RTC_DCHECK(proto == PROTO_UDP || proto == PROTO_TCP);
+  rtc::SocketAddress bound_address;
+  num_listening_shards_ = 0;
+  for (Shard& shard : shards_) {
+    // The first shard resolves port 0; the others bind the same port.
+    const rtc::SocketAddress shard_address =
+        num_listening_shards_ == 0 ? address : bound_address;
+    bool added = shard.thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return AddInternalSocketOnShard(&shard, shard_address, proto, true,
+                                      &bound_address);
+    });
+    if (!added) {
+      break;
+    }
+    ++num_listening_shards_;
+  }
+
+  if (num_listening_shards_ == 0) {
+    // Without SO_REUSEPORT the address can't be shared, so only the first
+    // shard listens.
+    Shard& shard = shards_[0];
+    bool added = shard.thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return AddInternalSocketOnShard(&shard, address, proto, false,
+                                      &bound_address);
+    });
+    if (!added) {
+      RTC_LOG(LS_ERROR) << "Failed to listen on " << address.ToString();
+      return rtc::SocketAddress();
+    }
+    num_listening_shards_ = 1;
+  }
+
+  if (num_listening_shards_ < shards_.size()) {
+    RTC_LOG(LS_WARNING) << "Only " << num_listening_shards_ << " of "
+                        << shards_.size() << " TURN shards listen on "
+                        << bound_address.ToString();
+  }
+  return bound_address;
+}
+
+void ShardedTurnServer::SetExternalAddress(const rtc::SocketAddress& address) {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&shard, &address] {
+      shard.server->SetExternalSocketFactory(
+          new rtc::BasicPacketSocketFactory(shard.thread.get()), address);
+    });
+  }
+}
+
+size_t ShardedTurnServer::NumAllocations() const {
+  size_t num_allocations = 0;
+  InvokeOnShards([&num_allocations](TurnServer* server) {
+    num_allocations += server->allocations().size();
+  });
+  return num_allocations;
+}
+
+void ShardedTurnServer::InvokeOnShards(
+    const std::function<void(TurnServer*)>& task) const {
+  for (const Shard& shard : shards_) {
+    TurnServer* server = shard.server.get();
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&task, server] { task(server); });
+  }
+}
+
+bool ShardedTurnServer::AddInternalSocketOnShard(
+    Shard* shard,
+    const rtc::SocketAddress& address,
+    ProtocolType proto,
+    bool reuse_port,
+    rtc::SocketAddress* bound_address) {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  std::unique_ptr<rtc::AsyncSocket> socket(
+      shard->thread->socketserver()->CreateAsyncSocket(
+          address.family(), proto == PROTO_UDP ? SOCK_DGRAM : SOCK_STREAM));
+  if (!socket) {
+    return false;
+  }
+  if (reuse_port && socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+    return false;
+  }
+  if (socket->Bind(address) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to bind " << address.ToString()
+                        << ", err=" << socket->GetError();
+    return false;
+  }
+  if (proto == PROTO_TCP && socket->Listen(kListenBacklog) != 0) {
+    return false;
+  }
+  *bound_address = socket->GetLocalAddress();
+  if (proto == PROTO_UDP) {
+    shard->server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                                     proto);
+  } else {
+    shard->server->AddInternalServerSocket(socket.release(), proto);
+  }
+  return true;
+}
+
+}  // namespace cricket
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDEDTURNSERVER_H_
+#define P2P_BASE_SHARDEDTURNSERVER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/turnserver.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/socketaddress.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// A TurnServer spread over several worker threads, for relays that need more
+// than one core. Each shard is a complete TurnServer on its own thread, with
+// its own internal sockets bound to the shared server address through
+// SO_REUSEPORT. The kernel hashes the 5-tuple of every client packet or TCP
+// connection onto one of those sockets, so an allocation is always served by
+// the same shard and the shards share no state.
+//
+// Where SO_REUSEPORT isn't available, only the first shard listens.
+class ShardedTurnServer {
+ public:
+  explicit ShardedTurnServer(size_t num_shards);
+  ~ShardedTurnServer();
+
+  size_t num_shards() const { return shards_.size(); }
+  rtc::Thread* thread(size_t shard) const {
+    return shards_[shard].thread.get();
+  }
+  // Must only be used on thread(shard).
+  TurnServer* server(size_t shard) const { return shards_[shard].server.get(); }
+
+  // These configure every shard. The hooks are called on the shard threads,
+  // possibly concurrently, so they must be thread safe.
+  void set_realm(const std::string& realm);
+  void set_software(const std::string& software);
+  void set_auth_hook(TurnAuthInterface* auth_hook);
+  void set_enable_permission_checks(bool enable);
+  void set_reject_private_addresses(bool filter);
+
+  // Starts listening for UDP packets or TCP connections on |address| in every
+  // shard. With port 0, all shards share the port picked for the first one.
+  // Returns the address listened on, or a nil address if even the first shard
+  // failed to bind it.
+  rtc::SocketAddress AddInternalSocket(const rtc::SocketAddress& address,
+                                       ProtocolType proto);
+  // Relayed addresses are allocated on |address|, by each shard separately.
+  void SetExternalAddress(const rtc::SocketAddress& address);
+
+  // The number of shards that listen on the last internal socket added.
+  size_t num_listening_shards() const { return num_listening_shards_; }
+  // Blocks on every shard thread.
+  size_t NumAllocations() const;
+
+ private:
+  struct Shard {
+    Shard();
+    Shard(Shard&&);
+    ~Shard();
+
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  // Runs |task| on every shard thread in turn, and waits for it.
+  void InvokeOnShards(const std::function<void(TurnServer*)>& task) const;
+  // Binds a socket for |proto| to |address| on the shard's thread and hands it
+  // to the shard's server.
+  static bool AddInternalSocketOnShard(Shard* shard,
+                                       const rtc::SocketAddress& address,
+                                       ProtocolType proto,
+                                       bool reuse_port,
+                                       rtc::SocketAddress* bound_address);
+
+  std::vector<Shard> shards_;
+  size_t num_listening_shards_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ShardedTurnServer);
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDEDTURNSERVER_H_
@@ -0,0 +1,361 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/shardedturnserver.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/asyncudpsocket.h"
+#include "rtc_base/bytebuffer.h"
+#include "rtc_base/byteorder.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physicalsocketserver.h"
+#include "rtc_base/ptr_util.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/timeutils.h"
+
+namespace cricket {
+namespace {
+
+const char kRealm[] = "example.org";
+const char kUsername[] = "sharded";
+const int kChannelId = 0x4000;
+const size_t kChannelHeaderSize = 4;
+const int kTimeoutMs = 5000;
+
+const rtc::SocketAddress kLoopbackAddress("127.0.0.1", 0);
+
+// Succeeds if the password is the same as the username, like TestTurnServer.
+class TestAuth : public TurnAuthInterface {
+ public:
+  bool GetKey(const std::string& username,
+              const std::string& realm,
+              std::string* key) override {
+    return ComputeStunCredentialHash(username, realm, username, key);
+  }
+};
+
+// A minimal TURN client over UDP, which can allocate, bind a channel and send
+// ChannelData.
+class TurnTestClient : public sigslot::has_slots<> {
+ public:
+  TurnTestClient(rtc::SocketServer* ss, const rtc::SocketAddress& server)
+      : socket_(rtc::AsyncUDPSocket::Create(ss, kLoopbackAddress)),
+        server_(server) {
+    socket_->SignalReadPacket.connect(this, &TurnTestClient::OnReadPacket);
+  }
+
+  rtc::SocketAddress address() const {
+    return socket_->GetLocalAddress();
+  }
+
+  bool Allocate() {
+    // The first request is rejected, and tells the realm and nonce.
+    std::unique_ptr<TurnMessage> response =
+        SendRequest(CreateRequest(STUN_ALLOCATE_REQUEST).get());
+    if (!response || response->type() != STUN_ALLOCATE_ERROR_RESPONSE ||
+        !response->GetByteString(STUN_ATTR_REALM) ||
+        !response->GetByteString(STUN_ATTR_NONCE)) {
+      return false;
+    }
+    realm_ = response->GetByteString(STUN_ATTR_REALM)->GetString();
+    nonce_ = response->GetByteString(STUN_ATTR_NONCE)->GetString();
+    ComputeStunCredentialHash(kUsername, realm_, kUsername, &key_);
+
+    std::unique_ptr<TurnMessage> request = CreateRequest(STUN_ALLOCATE_REQUEST);
+    Authenticate(request.get());
+    response = SendRequest(request.get());
+    return response && response->type() == STUN_ALLOCATE_RESPONSE;
+  }
+
+  bool BindChannel(int channel_id, const rtc::SocketAddress& peer) {
+    std::unique_ptr<TurnMessage> request =
+        CreateRequest(TURN_CHANNEL_BIND_REQUEST);
+    request->AddAttribute(rtc::MakeUnique<StunUInt32Attribute>(
+        STUN_ATTR_CHANNEL_NUMBER, channel_id << 16));
+    request->AddAttribute(rtc::MakeUnique<StunXorAddressAttribute>(
+        STUN_ATTR_XOR_PEER_ADDRESS, peer));
+    Authenticate(request.get());
+    std::unique_ptr<TurnMessage> response = SendRequest(request.get());
+    return response && response->type() == TURN_CHANNEL_BIND_RESPONSE;
+  }
+
+  // Sends |payload| on |channel_id|, followed by |padding| zero bytes that
+  // aren't counted in the ChannelData length.
+  void SendChannelData(int channel_id,
+                       const std::string& payload,
+                       size_t padding = 0) {
+    std::string packet(kChannelHeaderSize + payload.size() + padding, '\0');
+    rtc::SetBE16(&packet[0], static_cast<uint16_t>(channel_id));
+    rtc::SetBE16(&packet[2], static_cast<uint16_t>(payload.size()));
+    packet.replace(kChannelHeaderSize, payload.size(), payload);
+    Send(packet.data(), packet.size());
+  }
+
+  void Send(const void* data, size_t size) {
+    rtc::PacketOptions options;
+    socket_->SendTo(data, size, server_, options);
+  }
+
+ private:
+  std::unique_ptr<TurnMessage> CreateRequest(int type) {
+    auto request = rtc::MakeUnique<TurnMessage>();
+    request->SetType(type);
+    request->SetTransactionID(
+        rtc::CreateRandomString(kStunTransactionIdLength));
+    if (type == STUN_ALLOCATE_REQUEST) {
+      request->AddAttribute(rtc::MakeUnique<StunUInt32Attribute>(
+          STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+    }
+    return request;
+  }
+
+  void Authenticate(TurnMessage* request) {
+    request->AddAttribute(rtc::MakeUnique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, kUsername));
+    request->AddAttribute(
+        rtc::MakeUnique<StunByteStringAttribute>(STUN_ATTR_REALM, realm_));
+    request->AddAttribute(
+        rtc::MakeUnique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce_));
+    request->AddMessageIntegrity(key_);
+  }
+
+  // Returns the response to |request|, or null on timeout.
+  std::unique_ptr<TurnMessage> SendRequest(const TurnMessage* request) {
+    rtc::ByteBufferWriter buf;
+    request->Write(&buf);
+    transaction_id_ = request->transaction_id();
+    response_ = nullptr;
+    Send(buf.Data(), buf.Length());
+    WAIT(response_ != nullptr, kTimeoutMs);
+    return std::move(response_);
+  }
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& addr,
+                    const rtc::PacketTime& packet_time) {
+    std::unique_ptr<TurnMessage> response(new TurnMessage());
+    rtc::ByteBufferReader buf(data, size);
+    if (response->Read(&buf) &&
+        response->transaction_id() == transaction_id_) {
+      response_ = std::move(response);
+    }
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  const rtc::SocketAddress server_;
+  std::string realm_;
+  std::string nonce_;
+  std::string key_;
+  std::string transaction_id_;
+  std::unique_ptr<TurnMessage> response_;
+};
+
+// The peer that relayed packets are sent to.
+class TestPeer : public sigslot::has_slots<> {
+ public:
+  explicit TestPeer(rtc::SocketServer* ss)
+      : socket_(rtc::AsyncUDPSocket::Create(ss, kLoopbackAddress)) {
+    socket_->SignalReadPacket.connect(this, &TestPeer::OnReadPacket);
+  }
+
+  rtc::SocketAddress address() const {
+    return socket_->GetLocalAddress();
+  }
+  const std::vector<std::string>& packets() const { return packets_; }
+  int num_packets() const { return num_packets_; }
+
+  // If set, called for every packet instead of storing it.
+  void set_on_packet(std::function<void()> on_packet) {
+    on_packet_ = std::move(on_packet);
+  }
+
+ private:
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& addr,
+                    const rtc::PacketTime& packet_time) {
+    ++num_packets_;
+    if (on_packet_) {
+      on_packet_();
+    } else {
+      packets_.emplace_back(data, size);
+    }
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> socket_;
+  std::vector<std::string> packets_;
+  int num_packets_ = 0;
+  std::function<void()> on_packet_;
+};
+
+}  // namespace
+
+class ShardedTurnServerTest : public testing::Test {
+ public:
+  ShardedTurnServerTest() : thread_(&ss_) {}
+
+  void StartServer(size_t num_shards) {
+    server_ = rtc::MakeUnique<ShardedTurnServer>(num_shards);
+    server_->set_realm(kRealm);
+    server_->set_auth_hook(&auth_);
+    server_->SetExternalAddress(kLoopbackAddress);
+    server_address_ = server_->AddInternalSocket(kLoopbackAddress, PROTO_UDP);
+    ASSERT_FALSE(server_address_.IsNil());
+  }
+
+  // Creates a client with a channel bound to |peer|.
+  std::unique_ptr<TurnTestClient> CreateClient(const TestPeer& peer) {
+    auto client = rtc::MakeUnique<TurnTestClient>(&ss_, server_address_);
+    EXPECT_TRUE(client->Allocate());
+    EXPECT_TRUE(client->BindChannel(kChannelId, peer.address()));
+    return client;
+  }
+
+  size_t NumAllocations(size_t shard) {
+    return server_->thread(shard)->Invoke<size_t>(RTC_FROM_HERE, [&] {
+      return server_->server(shard)->allocations().size();
+    });
+  }
+
+  // CPU time used by all shard threads so far.
+  int64_t RelayCpuTimeNanos() {
+    int64_t cpu_time_ns = 0;
+    for (size_t i = 0; i < server_->num_shards(); ++i) {
+      cpu_time_ns += server_->thread(i)->Invoke<int64_t>(
+          RTC_FROM_HERE, [] { return rtc::GetThreadCpuTimeNanos(); });
+    }
+    return cpu_time_ns;
+  }
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  TestAuth auth_;
+  std::unique_ptr<ShardedTurnServer> server_;
+  rtc::SocketAddress server_address_;
+};
+
+TEST_F(ShardedTurnServerTest, RelaysFromEveryShard) {
+  const size_t kNumShards = 4;
+  const int kNumClients = 16;
+  StartServer(kNumShards);
+  TestPeer peer(&ss_);
+  std::vector<std::unique_ptr<TurnTestClient>> clients;
+  for (int i = 0; i < kNumClients; ++i) {
+    clients.push_back(CreateClient(peer));
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumClients), server_->NumAllocations());
+
+  for (int i = 0; i < kNumClients; ++i) {
+    clients[i]->SendChannelData(kChannelId, std::to_string(i));
+  }
+  EXPECT_EQ_WAIT(kNumClients, peer.num_packets(), kTimeoutMs);
+
+  if (server_->num_listening_shards() < kNumShards) {
+    RTC_LOG(LS_INFO) << "No SO_REUSEPORT... skipping shard checks";
+    return;
+  }
+  // The kernel hashes the clients over the shards; it is practically
+  // impossible for all 16 of them to land on the same one.
+  size_t num_used_shards = 0;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    if (NumAllocations(i) > 0) {
+      ++num_used_shards;
+    }
+  }
+  EXPECT_GT(num_used_shards, 1u);
+}
+
+TEST_F(ShardedTurnServerTest, DoesNotRelayChannelDataPadding) {
+  StartServer(1);
+  TestPeer peer(&ss_);
+  std::unique_ptr<TurnTestClient> client = CreateClient(peer);
+  client->SendChannelData(kChannelId, "hello", 3);
+  ASSERT_EQ_WAIT(1, peer.num_packets(), kTimeoutMs);
+  EXPECT_EQ("hello", peer.packets()[0]);
+}
+
+TEST_F(ShardedTurnServerTest, DropsTruncatedChannelData) {
+  StartServer(1);
+  TestPeer peer(&ss_);
+  std::unique_ptr<TurnTestClient> client = CreateClient(peer);
+  // The header claims more payload than the packet carries.
+  char truncated[kChannelHeaderSize + 10] = {0};
+  rtc::SetBE16(truncated, kChannelId);
+  rtc::SetBE16(truncated + 2, 100);
+  client->Send(truncated, sizeof(truncated));
+  client->SendChannelData(kChannelId, "valid");
+  ASSERT_EQ_WAIT(1, peer.num_packets(), kTimeoutMs);
+  EXPECT_EQ("valid", peer.packets()[0]);
+}
+
+// Reports how many ChannelData packets per second the relay forwards, in
+// total and per core of relay CPU time, for 1 to 4 shards. Clients keep a
+// fixed number of packets in flight and send a new one for each packet the
+// peer receives. Disabled by default; run manually.
+TEST_F(ShardedTurnServerTest, DISABLED_RelayedPacketsPerSecondPerCore) {
+  const int kNumClients = 64;
+  const int kPacketsInFlight = 256;
+  const int64_t kDurationMs = 3000;
+  const std::string kPayload(200, 'x');
+
+  for (size_t num_shards : {1, 2, 4}) {
+    StartServer(num_shards);
+    TestPeer peer(&ss_);
+    std::vector<std::unique_ptr<TurnTestClient>> clients;
+    for (int i = 0; i < kNumClients; ++i) {
+      clients.push_back(CreateClient(peer));
+    }
+
+    size_t next_client = 0;
+    auto send_next = [&] {
+      clients[next_client++ % clients.size()]->SendChannelData(kChannelId,
+                                                               kPayload);
+    };
+    peer.set_on_packet(send_next);
+    const int num_packets_before = peer.num_packets();
+    const int64_t cpu_start_ns = RelayCpuTimeNanos();
+    const int64_t start_ms = rtc::TimeMillis();
+    for (int i = 0; i < kPacketsInFlight; ++i) {
+      send_next();
+    }
+    while (rtc::TimeMillis() - start_ms < kDurationMs) {
+      thread_.ProcessMessages(10);
+    }
+    const int64_t elapsed_ms = rtc::TimeMillis() - start_ms;
+    const int64_t cpu_ns = RelayCpuTimeNanos() - cpu_start_ns;
+    const int relayed = peer.num_packets() - num_packets_before;
+    peer.set_on_packet(nullptr);
+
+    printf("%zu shards (%zu listening): %.0f packets/s, %.0f packets/s per "
+           "core\n",
+           num_shards, server_->num_listening_shards(),
+           relayed * 1000.0 / elapsed_ms,
+           relayed * 1e9 / std::max<int64_t>(cpu_ns, 1));
+    clients.clear();
+    server_ = nullptr;
+  }
+}
+
+}  // namespace cricket
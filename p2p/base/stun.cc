@@ -159,6 +159,40 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
       GetAttribute(STUN_ATTR_UNKNOWN_ATTRIBUTES));
 }
 
+// Checks the MESSAGE-INTEGRITY attribute at |mi_pos|, which must be complete.
+// The HMAC covers the message up to that attribute, with the length in the
+// header adjusted as if the message ended right after it. Only the header is
+// copied to adjust it.
+static bool ValidateMessageIntegrityAt(const char* data,
+                                       size_t mi_pos,
+                                       const std::string& password,
+                                       rtc::MessageDigest* sha1) {
+  char header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
+  //      0                   1                   2                   3
+  //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  //     |0 0|     STUN Message Type     |         Message Length        |
+  //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+  rtc::SetBE16(header + 2,
+               static_cast<uint16_t>(mi_pos - kStunHeaderSize +
+                                     kStunAttributeHeaderSize +
+                                     kStunMessageIntegritySize));
+
+  char hmac[kStunMessageIntegritySize];
+  size_t ret = rtc::ComputeHmac(sha1, password.c_str(), password.size(),
+                                header, sizeof(header),
+                                data + kStunHeaderSize,
+                                mi_pos - kStunHeaderSize, hmac, sizeof(hmac));
+  RTC_DCHECK(ret == sizeof(hmac));
+  if (ret != sizeof(hmac))
+    return false;
+
+  // Comparing the calculated HMAC with the one present in the message.
+  return memcmp(data + mi_pos + kStunAttributeHeaderSize, hmac,
+                sizeof(hmac)) == 0;
+}
+
 // Verifies a STUN message has a valid MESSAGE-INTEGRITY attribute, using the
 // procedure outlined in RFC 5389, section 15.4.
 bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
@@ -205,39 +239,10 @@ bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
-  size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
-  if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
-    // Stun message has other attributes after message integrity.
-    // Adjust the length parameter in stun message to calculate HMAC.
-    size_t extra_offset = size -
-        (mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize);
-    size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
-
-    // Writing new length of the STUN message @ Message Length in temp buffer.
-    //      0                   1                   2                   3
-    //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    //     |0 0|     STUN Message Type     |         Message Length        |
-    //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
-  }
-
-  char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1,
-                                      password.c_str(), password.size(),
-                                      temp_data.get(), mi_pos,
-                                      hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac))
-    return false;
-
-  // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize,
-                hmac,
-                sizeof(hmac)) == 0;
+  std::unique_ptr<rtc::MessageDigest> sha1(
+      rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+  return sha1 &&
+         ValidateMessageIntegrityAt(data, current_pos, password, sha1.get());
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
@@ -466,6 +471,171 @@ bool StunMessage::IsValidTransactionId(const std::string& transaction_id) {
       transaction_id.size() == kStunLegacyTransactionIdLength;
 }
 
+// StunMessageView
+
+StunMessageView::StunMessageView() : data_(nullptr), size_(0), type_(0) {}
+
+bool StunMessageView::Parse(const char* data, size_t size) {
+  data_ = nullptr;
+  size_ = 0;
+  type_ = 0;
+  if (size < kStunHeaderSize) {
+    return false;
+  }
+  uint16_t type = rtc::GetBE16(data);
+  if (type & 0x8000) {
+    // RTP and RTCP set the MSB of first byte, see StunMessage::Read().
+    return false;
+  }
+  if (rtc::GetBE16(data + 2) != size - kStunHeaderSize) {
+    return false;
+  }
+  // The attributes, including their padding, must fill the message exactly.
+  size_t pos = kStunHeaderSize;
+  while (pos < size) {
+    if (size - pos < kStunAttributeHeaderSize) {
+      return false;
+    }
+    size_t padded_length = (rtc::GetBE16(data + pos + 2) + 3u) & ~size_t{3};
+    pos += kStunAttributeHeaderSize;
+    if (size - pos < padded_length) {
+      return false;
+    }
+    pos += padded_length;
+  }
+  data_ = data;
+  size_ = size;
+  type_ = type;
+  return true;
+}
+
+bool StunMessageView::IsLegacy() const {
+  RTC_DCHECK(data_);
+  return rtc::GetBE32(data_ + kStunTransactionIdOffset -
+                      kStunMagicCookieLength) != kStunMagicCookie;
+}
+
+rtc::ArrayView<const char> StunMessageView::transaction_id() const {
+  if (IsLegacy()) {
+    return rtc::ArrayView<const char>(
+        data_ + kStunTransactionIdOffset - kStunMagicCookieLength,
+        kStunLegacyTransactionIdLength);
+  }
+  return rtc::ArrayView<const char>(data_ + kStunTransactionIdOffset,
+                                    kStunTransactionIdLength);
+}
+
+bool StunMessageView::GetAttribute(int type,
+                                   rtc::ArrayView<const char>* value) const {
+  size_t pos = FindAttribute(type);
+  if (pos == 0) {
+    return false;
+  }
+  *value = rtc::ArrayView<const char>(data_ + pos + kStunAttributeHeaderSize,
+                                      rtc::GetBE16(data_ + pos + 2));
+  return true;
+}
+
+bool StunMessageView::HasAttribute(int type) const {
+  return FindAttribute(type) != 0;
+}
+
+bool StunMessageView::GetUInt32(int type, uint32_t* value) const {
+  rtc::ArrayView<const char> attr;
+  if (!GetAttribute(type, &attr) || attr.size() != StunUInt32Attribute::SIZE) {
+    return false;
+  }
+  *value = rtc::GetBE32(attr.data());
+  return true;
+}
+
+bool StunMessageView::GetAddress(int type, rtc::SocketAddress* address) const {
+  rtc::ArrayView<const char> attr;
+  if (!GetAttribute(type, &attr) || attr.size() < 4) {
+    return false;
+  }
+  uint8_t stun_family = static_cast<uint8_t>(attr[1]);
+  uint16_t port = rtc::GetBE16(attr.data() + 2);
+  if (stun_family == STUN_ADDRESS_IPV4 &&
+      attr.size() == StunAddressAttribute::SIZE_IP4) {
+    in_addr v4addr;
+    memcpy(&v4addr, attr.data() + 4, sizeof(v4addr));
+    *address = rtc::SocketAddress(rtc::IPAddress(v4addr), port);
+    return true;
+  }
+  if (stun_family == STUN_ADDRESS_IPV6 &&
+      attr.size() == StunAddressAttribute::SIZE_IP6) {
+    in6_addr v6addr;
+    memcpy(&v6addr, attr.data() + 4, sizeof(v6addr));
+    *address = rtc::SocketAddress(rtc::IPAddress(v6addr), port);
+    return true;
+  }
+  return false;
+}
+
+bool StunMessageView::GetXorAddress(int type,
+                                    rtc::SocketAddress* address) const {
+  rtc::SocketAddress xored;
+  if (!GetAddress(type, &xored)) {
+    return false;
+  }
+  rtc::IPAddress ip = xored.ipaddr();
+  if (ip.family() == AF_INET) {
+    in_addr v4addr = ip.ipv4_address();
+    v4addr.s_addr ^= rtc::HostToNetwork32(kStunMagicCookie);
+    ip = rtc::IPAddress(v4addr);
+  } else {
+    // IPv6 addresses are XORed with the magic cookie and the transaction ID,
+    // which follow each other in the header.
+    if (IsLegacy()) {
+      return false;
+    }
+    in6_addr v6addr = ip.ipv6_address();
+    const char* mask =
+        data_ + kStunTransactionIdOffset - kStunMagicCookieLength;
+    for (size_t i = 0; i < sizeof(v6addr.s6_addr); ++i) {
+      v6addr.s6_addr[i] ^= static_cast<uint8_t>(mask[i]);
+    }
+    ip = rtc::IPAddress(v6addr);
+  }
+  *address = rtc::SocketAddress(ip, xored.port() ^ (kStunMagicCookie >> 16));
+  return true;
+}
+
+bool StunMessageView::ValidateMessageIntegrity(
+    const std::string& password) const {
+  std::unique_ptr<rtc::MessageDigest> sha1(
+      rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+  return sha1 && ValidateMessageIntegrity(password, sha1.get());
+}
+
+bool StunMessageView::ValidateMessageIntegrity(const std::string& password,
+                                               rtc::MessageDigest* sha1) const {
+  if (!sha1) {
+    return ValidateMessageIntegrity(password);
+  }
+  size_t mi_pos = FindAttribute(STUN_ATTR_MESSAGE_INTEGRITY);
+  return mi_pos != 0 &&
+         rtc::GetBE16(data_ + mi_pos + 2) == kStunMessageIntegritySize &&
+         ValidateMessageIntegrityAt(data_, mi_pos, password, sha1);
+}
+
+bool StunMessageView::ValidateFingerprint() const {
+  return data_ && StunMessage::ValidateFingerprint(data_, size_);
+}
+
+size_t StunMessageView::FindAttribute(int type) const {
+  size_t pos = kStunHeaderSize;
+  while (pos < size_) {
+    if (rtc::GetBE16(data_ + pos) == type) {
+      return pos;
+    }
+    pos += kStunAttributeHeaderSize +
+           ((rtc::GetBE16(data_ + pos + 2) + 3u) & ~size_t{3});
+  }
+  return 0;
+}
+
 // StunAttribute
 
 StunAttribute::StunAttribute(uint16_t type, uint16_t length)
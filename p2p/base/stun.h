@@ -18,9 +18,14 @@
 #include <string>
 #include <vector>
 
+#include "api/array_view.h"
 #include "rtc_base/bytebuffer.h"
 #include "rtc_base/socketaddress.h"
 
+namespace rtc {
+class MessageDigest;
+}  // namespace rtc
+
 namespace cricket {
 
 // These are the types of STUN messages defined in RFC 5389.
@@ -169,7 +174,8 @@ class StunMessage {
 
   // Validates that a raw STUN message has a correct MESSAGE-INTEGRITY value.
   // This can't currently be done on a StunMessage, since it is affected by
-  // padding data (which we discard when reading a StunMessage).
+  // padding data (which we discard when reading a StunMessage). See also
+  // StunMessageView.
   static bool ValidateMessageIntegrity(const char* data, size_t size,
                                        const std::string& password);
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
@@ -213,6 +219,51 @@ class StunMessage {
   uint32_t stun_magic_cookie_;
 };
 
+// A read-only view of a raw STUN message, for the receive path. Parse() checks
+// the header and the attribute framing in place, and the getters read the
+// attribute values straight out of the buffer, so nothing is allocated or
+// copied. The buffer must outlive the view.
+class StunMessageView {
+ public:
+  StunMessageView();
+
+  // Returns false, and leaves the view empty, unless |data| is exactly one
+  // STUN message whose attributes fill it.
+  bool Parse(const char* data, size_t size);
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+  int type() const { return type_; }
+  // See StunMessage::IsLegacy().
+  bool IsLegacy() const;
+  // 12 bytes long, or 16 bytes for legacy messages.
+  rtc::ArrayView<const char> transaction_id() const;
+
+  // Each getter looks at the first attribute of |type|, and returns false if
+  // there is none or if it is malformed. Values exclude the padding.
+  bool GetAttribute(int type, rtc::ArrayView<const char>* value) const;
+  bool HasAttribute(int type) const;
+  bool GetUInt32(int type, uint32_t* value) const;
+  bool GetAddress(int type, rtc::SocketAddress* address) const;
+  // For the XOR-MAPPED-ADDRESS family of attributes.
+  bool GetXorAddress(int type, rtc::SocketAddress* address) const;
+
+  // Like StunMessage::ValidateMessageIntegrity(), without copying the message.
+  // |sha1| is an optional SHA-1 digest to reuse between messages.
+  bool ValidateMessageIntegrity(const std::string& password) const;
+  bool ValidateMessageIntegrity(const std::string& password,
+                                rtc::MessageDigest* sha1) const;
+  bool ValidateFingerprint() const;
+
+ private:
+  // Returns the position of the first attribute of |type|, or 0.
+  size_t FindAttribute(int type) const;
+
+  const char* data_;
+  size_t size_;
+  int type_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -19,6 +20,7 @@
 #include "rtc_base/messagedigest.h"
 #include "rtc_base/ptr_util.h"
 #include "rtc_base/socketaddress.h"
+#include "rtc_base/timeutils.h"
 
 namespace cricket {
 
@@ -1570,4 +1572,205 @@ TEST_F(StunTest, CopyAttribute) {
   }
 }
 
+// Read the RFC5769 sample request in place.
+TEST_F(StunTest, ViewRfc5769RequestMessage) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                         sizeof(kRfc5769SampleRequest)));
+  EXPECT_EQ(STUN_BINDING_REQUEST, view.type());
+  EXPECT_FALSE(view.IsLegacy());
+  ASSERT_EQ(kStunTransactionIdLength, view.transaction_id().size());
+  EXPECT_EQ(0, memcmp(view.transaction_id().data(),
+                      kRfc5769SampleMsgTransactionId,
+                      kStunTransactionIdLength));
+
+  rtc::ArrayView<const char> value;
+  ASSERT_TRUE(view.GetAttribute(STUN_ATTR_SOFTWARE, &value));
+  EXPECT_EQ(kRfc5769SampleMsgClientSoftware,
+            std::string(value.data(), value.size()));
+  ASSERT_TRUE(view.GetAttribute(STUN_ATTR_USERNAME, &value));
+  EXPECT_EQ(kRfc5769SampleMsgUsername,
+            std::string(value.data(), value.size()));
+  EXPECT_TRUE(view.HasAttribute(STUN_ATTR_MESSAGE_INTEGRITY));
+  EXPECT_FALSE(view.HasAttribute(STUN_ATTR_XOR_MAPPED_ADDRESS));
+
+  uint32_t fingerprint = 0;
+  ASSERT_TRUE(view.GetUInt32(STUN_ATTR_FINGERPRINT, &fingerprint));
+  EXPECT_EQ(0xe57a3bcf, fingerprint);
+  // USERNAME isn't a 32-bit value.
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_USERNAME, &fingerprint));
+
+  EXPECT_TRUE(view.ValidateFingerprint());
+  EXPECT_TRUE(view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword));
+  EXPECT_FALSE(view.ValidateMessageIntegrity("InvalidPassword"));
+}
+
+// Read the XOR-MAPPED-ADDRESS of the RFC5769 sample responses in place, and
+// check them with a digest that is reused between messages.
+TEST_F(StunTest, ViewRfc5769ResponseMessages) {
+  std::unique_ptr<rtc::MessageDigest> sha1(
+      rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+  StunMessageView view;
+  rtc::SocketAddress address;
+
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponse),
+                         sizeof(kRfc5769SampleResponse)));
+  EXPECT_EQ(STUN_BINDING_RESPONSE, view.type());
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(kRfc5769SampleMsgMappedAddress, address);
+  EXPECT_TRUE(view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword,
+                                            sha1.get()));
+  EXPECT_FALSE(view.ValidateMessageIntegrity("InvalidPassword", sha1.get()));
+
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponseIPv6),
+                 sizeof(kRfc5769SampleResponseIPv6)));
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(kRfc5769SampleMsgIPv6MappedAddress, address);
+  EXPECT_TRUE(view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword,
+                                            sha1.get()));
+}
+
+TEST_F(StunTest, ViewAddressAttributes) {
+  StunMessageView view;
+  rtc::SocketAddress address;
+
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithIPv4MappedAddress),
+      sizeof(kStunMessageWithIPv4MappedAddress)));
+  ASSERT_TRUE(view.GetAddress(STUN_ATTR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(rtc::SocketAddress(rtc::IPAddress(kIPv4TestAddress1),
+                               kTestMessagePort4),
+            address);
+
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithIPv4XorMappedAddress),
+      sizeof(kStunMessageWithIPv4XorMappedAddress)));
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(rtc::SocketAddress(rtc::IPAddress(kIPv4TestAddress1),
+                               kTestMessagePort3),
+            address);
+
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithIPv6XorMappedAddress),
+      sizeof(kStunMessageWithIPv6XorMappedAddress)));
+  ASSERT_TRUE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+  EXPECT_EQ(rtc::SocketAddress(rtc::IPAddress(kIPv6TestAddress1),
+                               kTestMessagePort1),
+            address);
+  EXPECT_FALSE(view.GetAddress(STUN_ATTR_MAPPED_ADDRESS, &address));
+}
+
+TEST_F(StunTest, ViewLegacyMessage) {
+  unsigned char rfc3489_packet[sizeof(kStunMessageWithIPv6XorMappedAddress)];
+  memcpy(rfc3489_packet, kStunMessageWithIPv6XorMappedAddress,
+         sizeof(kStunMessageWithIPv6XorMappedAddress));
+  // Overwrite the magic cookie here.
+  memcpy(&rfc3489_packet[4], "ABCD", 4);
+
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(rfc3489_packet),
+                         sizeof(rfc3489_packet)));
+  EXPECT_TRUE(view.IsLegacy());
+  ASSERT_EQ(kStunLegacyTransactionIdLength, view.transaction_id().size());
+  EXPECT_EQ(0, memcmp(view.transaction_id().data(), &rfc3489_packet[4],
+                      kStunLegacyTransactionIdLength));
+  // A 16 byte transaction ID can't be XORed into an IPv6 address.
+  rtc::SocketAddress address;
+  EXPECT_FALSE(view.GetXorAddress(STUN_ATTR_XOR_MAPPED_ADDRESS, &address));
+}
+
+TEST_F(StunTest, ViewRejectsInvalidMessages) {
+  StunMessageView view;
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRtcpPacket),
+                          sizeof(kRtcpPacket)));
+  EXPECT_FALSE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithZeroLength),
+      kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithExcessLength),
+      kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithSmallLength),
+      kRealLengthOfInvalidLengthTestCases));
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                          kStunHeaderSize - 1));
+
+  // An attribute that claims to run past the end of the message.
+  char buf[sizeof(kStunMessageWithIPv4MappedAddress)];
+  memcpy(buf, kStunMessageWithIPv4MappedAddress, sizeof(buf));
+  buf[kStunHeaderSize + 3] = 0x0c;
+  EXPECT_FALSE(view.Parse(buf, sizeof(buf)));
+
+  // A failed parse leaves the view empty.
+  EXPECT_EQ(nullptr, view.data());
+  EXPECT_EQ(0U, view.size());
+  EXPECT_FALSE(view.HasAttribute(STUN_ATTR_MAPPED_ADDRESS));
+  EXPECT_FALSE(view.ValidateFingerprint());
+}
+
+// An attribute with the wrong size for its type can be framed correctly, but
+// mustn't be read as an address or a MESSAGE-INTEGRITY.
+TEST_F(StunTest, ViewRejectsMalformedAttributes) {
+  StunMessageView view;
+  char buf[sizeof(kStunMessageWithIPv4MappedAddress)];
+  memcpy(buf, kStunMessageWithIPv4MappedAddress, sizeof(buf));
+  buf[kStunHeaderSize + 3] = 0x07;
+  ASSERT_TRUE(view.Parse(buf, sizeof(buf)));
+  rtc::SocketAddress address;
+  EXPECT_FALSE(view.GetAddress(STUN_ATTR_MAPPED_ADDRESS, &address));
+
+  // A 16 byte MESSAGE-INTEGRITY.
+  char hmac_buf[sizeof(kStunMessageWithBadHmacAtEnd)];
+  memcpy(hmac_buf, kStunMessageWithBadHmacAtEnd, sizeof(hmac_buf));
+  hmac_buf[kStunHeaderSize + 3] = 0x10;
+  ASSERT_TRUE(view.Parse(hmac_buf, sizeof(hmac_buf)));
+  EXPECT_FALSE(view.ValidateMessageIntegrity(kRfc5769SampleMsgPassword));
+  // The original claims 20 bytes, and isn't framed correctly.
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithBadHmacAtEnd),
+                 sizeof(kStunMessageWithBadHmacAtEnd)));
+}
+
+// Compares reading and authenticating binding requests through StunMessage
+// with doing it through StunMessageView. Disabled since it is slow and only
+// prints the results.
+TEST_F(StunTest, DISABLED_ParseAndValidateRequestPerformance) {
+  const int kIterations = 200000;
+  const char* data = reinterpret_cast<const char*>(kRfc5769SampleRequest);
+  const size_t size = sizeof(kRfc5769SampleRequest);
+  const std::string password = kRfc5769SampleMsgPassword;
+  int valid = 0;
+
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i) {
+    IceMessage msg;
+    rtc::ByteBufferReader buf(data, size);
+    if (StunMessage::ValidateFingerprint(data, size) && msg.Read(&buf) &&
+        msg.GetByteString(STUN_ATTR_USERNAME) &&
+        StunMessage::ValidateMessageIntegrity(data, size, password)) {
+      ++valid;
+    }
+  }
+  int64_t message_ns = rtc::TimeNanos() - start_ns;
+
+  std::unique_ptr<rtc::MessageDigest> sha1(
+      rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i) {
+    StunMessageView view;
+    if (view.Parse(data, size) && view.ValidateFingerprint() &&
+        view.HasAttribute(STUN_ATTR_USERNAME) &&
+        view.ValidateMessageIntegrity(password, sha1.get())) {
+      ++valid;
+    }
+  }
+  int64_t view_ns = rtc::TimeNanos() - start_ns;
+
+  EXPECT_EQ(2 * kIterations, valid);
+  printf("StunMessage: %.0f ns/request, StunMessageView: %.0f ns/request\n",
+         static_cast<double>(message_ns) / kIterations,
+         static_cast<double>(view_ns) / kIterations);
+}
+
 }  // namespace cricket
@@ -925,27 +925,25 @@ void TurnPort::OnAllocateRequestTimeout() {
 void TurnPort::HandleDataIndication(const char* data, size_t size,
                                     const rtc::PacketTime& packet_time) {
   // Read in the message, and process according to RFC5766, Section 10.4.
-  rtc::ByteBufferReader buf(data, size);
-  TurnMessage msg;
-  if (!msg.Read(&buf)) {
+  // The attributes are read in place, so the payload isn't copied.
+  StunMessageView msg;
+  if (!msg.Parse(data, size)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received invalid TURN data indication";
     return;
   }
 
   // Check mandatory attributes.
-  const StunAddressAttribute* addr_attr =
-      msg.GetAddress(STUN_ATTR_XOR_PEER_ADDRESS);
-  if (!addr_attr) {
+  rtc::SocketAddress ext_addr;
+  if (!msg.GetXorAddress(STUN_ATTR_XOR_PEER_ADDRESS, &ext_addr)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Missing STUN_ATTR_XOR_PEER_ADDRESS attribute "
                            "in data indication.";
     return;
   }
 
-  const StunByteStringAttribute* data_attr =
-      msg.GetByteString(STUN_ATTR_DATA);
-  if (!data_attr) {
+  rtc::ArrayView<const char> payload;
+  if (!msg.GetAttribute(STUN_ATTR_DATA, &payload)) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Missing STUN_ATTR_DATA attribute in "
                            "data indication.";
@@ -954,7 +952,6 @@ void TurnPort::HandleDataIndication(const char* data, size_t size,
 
   // Log a warning if the data didn't come from an address that we think we have
   // a permission for.
-  rtc::SocketAddress ext_addr(addr_attr->GetAddress());
   if (!HasPermission(ext_addr.ipaddr())) {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received TURN data indication with unknown "
@@ -962,8 +959,8 @@ void TurnPort::HandleDataIndication(const char* data, size_t size,
                         << ext_addr.ToSensitiveString();
   }
 
-  DispatchPacket(data_attr->bytes(), data_attr->length(), ext_addr,
-                 PROTO_UDP, packet_time);
+  DispatchPacket(payload.data(), payload.size(), ext_addr, PROTO_UDP,
+                 packet_time);
 }
 
 void TurnPort::HandleChannelData(int channel_id, const char* data,
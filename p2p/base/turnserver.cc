@@ -10,6 +10,8 @@
 
 #include "p2p/base/turnserver.h"
 
+#include <string.h>
+
 #include <tuple>  // for std::tie
 #include <utility>
 
@@ -18,6 +20,7 @@
 #include "p2p/base/stun.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/bytebuffer.h"
+#include "rtc_base/byteorder.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
@@ -508,8 +511,14 @@ void TurnServer::SendStun(TurnServerConnection* conn, StunMessage* msg) {
 
 void TurnServer::Send(TurnServerConnection* conn,
                       const rtc::ByteBufferWriter& buf) {
+  Send(conn, buf.Data(), buf.Length());
+}
+
+void TurnServer::Send(TurnServerConnection* conn,
+                      const void* data,
+                      size_t size) {
   rtc::PacketOptions options;
-  conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
+  conn->socket()->SendTo(data, size, conn->src(), options);
 }
 
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
@@ -799,13 +808,20 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 }
 
 void TurnServerAllocation::HandleChannelData(const char* data, size_t size) {
-  // Extract the channel number from the data.
+  // Extract the channel number and the payload length from the data. The
+  // message may be followed by padding, which isn't relayed.
   uint16_t channel_id = rtc::GetBE16(data);
+  size_t length = rtc::GetBE16(data + 2);
+  if (length > size - TURN_CHANNEL_HEADER_SIZE) {
+    RTC_LOG(LS_WARNING) << ToString()
+                        << ": Received truncated channel data, id="
+                        << channel_id;
+    return;
+  }
   Channel* channel = FindChannel(channel_id);
   if (channel) {
     // Send the data to the peer address.
-    SendExternal(data + TURN_CHANNEL_HEADER_SIZE,
-                 size - TURN_CHANNEL_HEADER_SIZE, channel->peer());
+    SendExternal(data + TURN_CHANNEL_HEADER_SIZE, length, channel->peer());
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received channel data for invalid channel, id="
@@ -822,11 +838,11 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    channel_data_.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+    rtc::SetBE16(channel_data_.data(), static_cast<uint16_t>(channel->id()));
+    rtc::SetBE16(channel_data_.data() + 2, static_cast<uint16_t>(size));
+    memcpy(channel_data_.data() + TURN_CHANNEL_HEADER_SIZE, data, size);
+    server_->Send(&conn_, channel_data_.data(), channel_data_.size());
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
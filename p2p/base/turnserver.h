@@ -22,6 +22,7 @@
 #include "p2p/base/portinterface.h"
 #include "rtc_base/asyncinvoker.h"
 #include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/messagequeue.h"
 #include "rtc_base/sigslot.h"
 #include "rtc_base/socketaddress.h"
@@ -87,6 +88,8 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string ToString() const;
 
   void HandleTurnMessage(const TurnMessage* msg);
+  // Relays a ChannelData message to the bound peer. This is the hot path of
+  // the server, so the payload is sent straight out of |data|.
   void HandleChannelData(const char* data, size_t size);
 
   sigslot::signal1<TurnServerAllocation*> SignalDestroyed;
@@ -137,6 +140,8 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string last_nonce_;
   PermissionList perms_;
   ChannelList channels_;
+  // Frames peer packets as ChannelData messages; reused between packets.
+  rtc::Buffer channel_data_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -269,6 +274,7 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, const void* data, size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket);
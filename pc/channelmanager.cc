@@ -161,11 +161,26 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
     bool srtp_required,
     const rtc::CryptoOptions& crypto_options,
     const AudioOptions& options) {
+  return CreateVoiceChannel(call, media_config, rtp_transport, network_thread_,
+                            signaling_thread, content_name, srtp_required,
+                            crypto_options, options);
+}
+
+VoiceChannel* ChannelManager::CreateVoiceChannel(
+    webrtc::Call* call,
+    const cricket::MediaConfig& media_config,
+    webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
+    rtc::Thread* signaling_thread,
+    const std::string& content_name,
+    bool srtp_required,
+    const rtc::CryptoOptions& crypto_options,
+    const AudioOptions& options) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VoiceChannel*>(RTC_FROM_HERE, [&] {
       return CreateVoiceChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, options);
+                                network_thread, signaling_thread, content_name,
+                                srtp_required, crypto_options, options);
     });
   }
 
@@ -183,7 +198,7 @@ VoiceChannel* ChannelManager::CreateVoiceChannel(
   }
 
   auto voice_channel = rtc::MakeUnique<VoiceChannel>(
-      worker_thread_, network_thread_, signaling_thread, media_engine_.get(),
+      worker_thread_, network_thread, signaling_thread, media_engine_.get(),
       rtc::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
 
@@ -229,11 +244,26 @@ VideoChannel* ChannelManager::CreateVideoChannel(
     bool srtp_required,
     const rtc::CryptoOptions& crypto_options,
     const VideoOptions& options) {
+  return CreateVideoChannel(call, media_config, rtp_transport, network_thread_,
+                            signaling_thread, content_name, srtp_required,
+                            crypto_options, options);
+}
+
+VideoChannel* ChannelManager::CreateVideoChannel(
+    webrtc::Call* call,
+    const cricket::MediaConfig& media_config,
+    webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
+    rtc::Thread* signaling_thread,
+    const std::string& content_name,
+    bool srtp_required,
+    const rtc::CryptoOptions& crypto_options,
+    const VideoOptions& options) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<VideoChannel*>(RTC_FROM_HERE, [&] {
       return CreateVideoChannel(call, media_config, rtp_transport,
-                                signaling_thread, content_name, srtp_required,
-                                crypto_options, options);
+                                network_thread, signaling_thread, content_name,
+                                srtp_required, crypto_options, options);
     });
   }
 
@@ -251,7 +281,7 @@ VideoChannel* ChannelManager::CreateVideoChannel(
   }
 
   auto video_channel = rtc::MakeUnique<VideoChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       rtc::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
   video_channel->Init_w(rtp_transport);
@@ -295,10 +325,24 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
     const std::string& content_name,
     bool srtp_required,
     const rtc::CryptoOptions& crypto_options) {
+  return CreateRtpDataChannel(media_config, rtp_transport, network_thread_,
+                              signaling_thread, content_name, srtp_required,
+                              crypto_options);
+}
+
+RtpDataChannel* ChannelManager::CreateRtpDataChannel(
+    const cricket::MediaConfig& media_config,
+    webrtc::RtpTransportInternal* rtp_transport,
+    rtc::Thread* network_thread,
+    rtc::Thread* signaling_thread,
+    const std::string& content_name,
+    bool srtp_required,
+    const rtc::CryptoOptions& crypto_options) {
   if (!worker_thread_->IsCurrent()) {
     return worker_thread_->Invoke<RtpDataChannel*>(RTC_FROM_HERE, [&] {
-      return CreateRtpDataChannel(media_config, rtp_transport, signaling_thread,
-                                  content_name, srtp_required, crypto_options);
+      return CreateRtpDataChannel(media_config, rtp_transport, network_thread,
+                                  signaling_thread, content_name,
+                                  srtp_required, crypto_options);
     });
   }
 
@@ -311,7 +355,7 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel(
   }
 
   auto data_channel = rtc::MakeUnique<RtpDataChannel>(
-      worker_thread_, network_thread_, signaling_thread,
+      worker_thread_, network_thread, signaling_thread,
       rtc::WrapUnique(media_channel), content_name, srtp_required,
       crypto_options);
   data_channel->Init_w(rtp_transport);
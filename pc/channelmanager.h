@@ -88,6 +88,17 @@ class ChannelManager final {
                                    bool srtp_required,
                                    const rtc::CryptoOptions& crypto_options,
                                    const AudioOptions& options);
+  // Same as above, but the channel runs its transport on |network_thread|
+  // rather than on the ChannelManager's network thread.
+  VoiceChannel* CreateVoiceChannel(webrtc::Call* call,
+                                   const cricket::MediaConfig& media_config,
+                                   webrtc::RtpTransportInternal* rtp_transport,
+                                   rtc::Thread* network_thread,
+                                   rtc::Thread* signaling_thread,
+                                   const std::string& content_name,
+                                   bool srtp_required,
+                                   const rtc::CryptoOptions& crypto_options,
+                                   const AudioOptions& options);
   // Destroys a voice channel created by CreateVoiceChannel.
   void DestroyVoiceChannel(VoiceChannel* voice_channel);
 
@@ -102,6 +113,15 @@ class ChannelManager final {
                                    bool srtp_required,
                                    const rtc::CryptoOptions& crypto_options,
                                    const VideoOptions& options);
+  VideoChannel* CreateVideoChannel(webrtc::Call* call,
+                                   const cricket::MediaConfig& media_config,
+                                   webrtc::RtpTransportInternal* rtp_transport,
+                                   rtc::Thread* network_thread,
+                                   rtc::Thread* signaling_thread,
+                                   const std::string& content_name,
+                                   bool srtp_required,
+                                   const rtc::CryptoOptions& crypto_options,
+                                   const VideoOptions& options);
   // Destroys a video channel created by CreateVideoChannel.
   void DestroyVideoChannel(VideoChannel* video_channel);
 
@@ -112,6 +132,14 @@ class ChannelManager final {
       const std::string& content_name,
       bool srtp_required,
       const rtc::CryptoOptions& crypto_options);
+  RtpDataChannel* CreateRtpDataChannel(
+      const cricket::MediaConfig& media_config,
+      webrtc::RtpTransportInternal* rtp_transport,
+      rtc::Thread* network_thread,
+      rtc::Thread* signaling_thread,
+      const std::string& content_name,
+      bool srtp_required,
+      const rtc::CryptoOptions& crypto_options);
   // Destroys a data channel created by CreateRtpDataChannel.
   void DestroyRtpDataChannel(RtpDataChannel* data_channel);
 
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/networkthreadpool.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/network.h"
+#include "rtc_base/ptr_util.h"
+
+namespace webrtc {
+namespace {
+
+class FewestPeerConnectionsPolicy : public NetworkThreadPlacementPolicy {
+ public:
+  size_t SelectNetworkThread(
+      const std::vector<size_t>& peer_connections_per_thread) override {
+    return std::min_element(peer_connections_per_thread.begin(),
+                            peer_connections_per_thread.end()) -
+           peer_connections_per_thread.begin();
+  }
+};
+
+}  // namespace
+
+NetworkThreadPool::NetworkThread::NetworkThread() = default;
+NetworkThreadPool::NetworkThread::NetworkThread(NetworkThread&&) = default;
+NetworkThreadPool::NetworkThread::~NetworkThread() = default;
+
+NetworkThreadPool::NetworkThreadPool(
+    rtc::Thread* network_thread,
+    size_t num_threads,
+    std::unique_ptr<NetworkThreadPlacementPolicy> policy)
+    : policy_(policy ? std::move(policy)
+                     : rtc::MakeUnique<FewestPeerConnectionsPolicy>()) {
+  RTC_DCHECK(network_thread);
+  threads_.resize(std::max<size_t>(num_threads, 1));
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    NetworkThread& entry = threads_[i];
+    if (i == 0) {
+      entry.thread = network_thread;
+    } else {
+      entry.owned_thread = rtc::Thread::CreateWithSocketServer();
+      entry.owned_thread->SetName("pc_network_thread_" + std::to_string(i),
+                                  nullptr);
+      entry.owned_thread->Start();
+      entry.thread = entry.owned_thread.get();
+      // Like the factory's network thread (see ChannelManager::Init()), the
+      // pool's threads must never block on other threads.
+      entry.thread->Invoke<void>(RTC_FROM_HERE, [&entry] {
+        entry.thread->SetAllowBlockingCalls(false);
+      });
+    }
+    entry.network_manager = rtc::MakeUnique<rtc::BasicNetworkManager>();
+    entry.socket_factory =
+        rtc::MakeUnique<rtc::BasicPacketSocketFactory>(entry.thread);
+  }
+}
+
+NetworkThreadPool::~NetworkThreadPool() {
+  // The network managers and socket factories must go before the threads
+  // they are used on.
+  for (NetworkThread& entry : threads_) {
+    entry.socket_factory = nullptr;
+    entry.network_manager = nullptr;
+  }
+}
+
+rtc::Thread* NetworkThreadPool::Acquire() {
+  rtc::CritScope cs(&lock_);
+  std::vector<size_t> peer_connections_per_thread;
+  for (const NetworkThread& entry : threads_)
+    peer_connections_per_thread.push_back(entry.peer_connections);
+  return AcquireAt(
+      std::min(policy_->SelectNetworkThread(peer_connections_per_thread),
+               threads_.size() - 1));
+}
+
+rtc::Thread* NetworkThreadPool::AcquireDefault() {
+  rtc::CritScope cs(&lock_);
+  return AcquireAt(0);
+}
+
+void NetworkThreadPool::Release(rtc::Thread* thread) {
+  rtc::CritScope cs(&lock_);
+  NetworkThread* entry = Find(thread);
+  RTC_DCHECK(entry);
+  RTC_DCHECK_GT(entry->peer_connections, 0);
+  --entry->peer_connections;
+}
+
+rtc::BasicNetworkManager* NetworkThreadPool::network_manager(
+    rtc::Thread* thread) {
+  NetworkThread* entry = Find(thread);
+  RTC_DCHECK(entry);
+  return entry->network_manager.get();
+}
+
+rtc::BasicPacketSocketFactory* NetworkThreadPool::socket_factory(
+    rtc::Thread* thread) {
+  NetworkThread* entry = Find(thread);
+  RTC_DCHECK(entry);
+  return entry->socket_factory.get();
+}
+
+std::vector<NetworkThreadStats> NetworkThreadPool::GetStats() const {
+  std::vector<NetworkThreadStats> stats(threads_.size());
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    stats[i].thread = threads_[i].thread;
+    stats[i].cpu_time_ns = threads_[i].thread->Invoke<int64_t>(
+        RTC_FROM_HERE, [] { return rtc::GetThreadCpuTimeNanos(); });
+  }
+  rtc::CritScope cs(&lock_);
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    stats[i].peer_connections = threads_[i].peer_connections;
+    stats[i].total_peer_connections = threads_[i].total_peer_connections;
+  }
+  return stats;
+}
+
+rtc::Thread* NetworkThreadPool::AcquireAt(size_t index) {
+  NetworkThread& entry = threads_[index];
+  ++entry.peer_connections;
+  ++entry.total_peer_connections;
+  return entry.thread;
+}
+
+NetworkThreadPool::NetworkThread* NetworkThreadPool::Find(
+    rtc::Thread* thread) {
+  for (NetworkThread& entry : threads_) {
+    if (entry.thread == thread)
+      return &entry;
+  }
+  return nullptr;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_NETWORKTHREADPOOL_H_
+#define PC_NETWORKTHREADPOOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/networkthreadplacementpolicy.h"
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+class BasicNetworkManager;
+class BasicPacketSocketFactory;
+}  // namespace rtc
+
+namespace webrtc {
+
+// Load counters for one thread of a NetworkThreadPool.
+struct NetworkThreadStats {
+  rtc::Thread* thread = nullptr;
+  // PeerConnections currently running on the thread.
+  size_t peer_connections = 0;
+  // PeerConnections ever placed on the thread.
+  size_t total_peer_connections = 0;
+  // CPU time consumed by the thread so far, or -1 if unknown.
+  int64_t cpu_time_ns = -1;
+};
+
+// The network threads shared by the PeerConnections of one factory. Thread 0
+// is the factory's network thread; any others are created and owned by the
+// pool. Each thread has its own network manager and packet socket factory, so
+// the default port allocator of a PeerConnection only ever runs on the
+// PeerConnection's own thread.
+class NetworkThreadPool {
+ public:
+  // If |policy| is null, new PeerConnections go to the thread with the fewest
+  // PeerConnections.
+  NetworkThreadPool(rtc::Thread* network_thread,
+                    size_t num_threads,
+                    std::unique_ptr<NetworkThreadPlacementPolicy> policy);
+  ~NetworkThreadPool();
+
+  size_t size() const { return threads_.size(); }
+
+  // Picks the thread for a new PeerConnection. The thread counts as used by
+  // it until Release() is called.
+  rtc::Thread* Acquire();
+  // Like Acquire(), but always picks thread 0, for PeerConnections with
+  // injected dependencies that are bound to the factory's network thread.
+  rtc::Thread* AcquireDefault();
+  void Release(rtc::Thread* thread);
+
+  rtc::BasicNetworkManager* network_manager(rtc::Thread* thread);
+  rtc::BasicPacketSocketFactory* socket_factory(rtc::Thread* thread);
+
+  // Blocks on each thread to read its CPU time, so must not be called on one
+  // of the pool's threads.
+  std::vector<NetworkThreadStats> GetStats() const;
+
+ private:
+  struct NetworkThread {
+    NetworkThread();
+    NetworkThread(NetworkThread&&);
+    ~NetworkThread();
+
+    rtc::Thread* thread = nullptr;
+    std::unique_ptr<rtc::Thread> owned_thread;
+    std::unique_ptr<rtc::BasicNetworkManager> network_manager;
+    std::unique_ptr<rtc::BasicPacketSocketFactory> socket_factory;
+    size_t peer_connections = 0;
+    size_t total_peer_connections = 0;
+  };
+
+  rtc::Thread* AcquireAt(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  NetworkThread* Find(rtc::Thread* thread);
+
+  const std::unique_ptr<NetworkThreadPlacementPolicy> policy_;
+  // Not resized after construction, so only the counters need |lock_|.
+  std::vector<NetworkThread> threads_;
+  rtc::CriticalSection lock_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(NetworkThreadPool);
+};
+
+}  // namespace webrtc
+
+#endif  // PC_NETWORKTHREADPOOL_H_
@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/networkthreadpool.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "p2p/base/basicpacketsocketfactory.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/ptr_util.h"
+
+namespace webrtc {
+namespace {
+
+// Always places PeerConnections on the last thread.
+class LastThreadPolicy : public NetworkThreadPlacementPolicy {
+ public:
+  size_t SelectNetworkThread(
+      const std::vector<size_t>& peer_connections_per_thread) override {
+    last_loads_ = peer_connections_per_thread;
+    return peer_connections_per_thread.size() - 1;
+  }
+
+  std::vector<size_t> last_loads_;
+};
+
+}  // namespace
+
+TEST(NetworkThreadPoolTest, SingleThreadUsesNetworkThread) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  NetworkThreadPool pool(network_thread.get(), 1, nullptr);
+  EXPECT_EQ(1u, pool.size());
+  EXPECT_EQ(network_thread.get(), pool.Acquire());
+  EXPECT_EQ(network_thread.get(), pool.Acquire());
+  pool.Release(network_thread.get());
+  std::vector<NetworkThreadStats> stats = pool.GetStats();
+  ASSERT_EQ(1u, stats.size());
+  EXPECT_EQ(1u, stats[0].peer_connections);
+  EXPECT_EQ(2u, stats[0].total_peer_connections);
+}
+
+TEST(NetworkThreadPoolTest, SpreadsPeerConnectionsEvenly) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  NetworkThreadPool pool(network_thread.get(), 3, nullptr);
+  ASSERT_EQ(3u, pool.size());
+
+  std::vector<rtc::Thread*> acquired;
+  for (int i = 0; i < 6; ++i)
+    acquired.push_back(pool.Acquire());
+  EXPECT_EQ(3u,
+            std::set<rtc::Thread*>(acquired.begin(), acquired.end()).size());
+  EXPECT_EQ(network_thread.get(), acquired[0]);
+
+  // Each thread has its own socket factory and network manager.
+  std::set<rtc::BasicPacketSocketFactory*> socket_factories;
+  std::set<rtc::BasicNetworkManager*> network_managers;
+  for (rtc::Thread* thread : acquired) {
+    socket_factories.insert(pool.socket_factory(thread));
+    network_managers.insert(pool.network_manager(thread));
+  }
+  EXPECT_EQ(3u, socket_factories.size());
+  EXPECT_EQ(3u, network_managers.size());
+
+  // Freeing up a thread makes it the next pick.
+  pool.Release(acquired[4]);
+  pool.Release(acquired[1]);
+  EXPECT_EQ(acquired[1], pool.Acquire());
+
+  std::vector<NetworkThreadStats> stats = pool.GetStats();
+  ASSERT_EQ(3u, stats.size());
+  size_t total = 0;
+  for (const NetworkThreadStats& thread_stats : stats) {
+    EXPECT_LE(thread_stats.peer_connections, 2u);
+    EXPECT_GE(thread_stats.total_peer_connections, 2u);
+    EXPECT_GE(thread_stats.cpu_time_ns, 0);
+    total += thread_stats.peer_connections;
+  }
+  EXPECT_EQ(5u, total);
+
+  for (size_t i = 0; i < acquired.size(); ++i) {
+    if (i != 4)
+      pool.Release(acquired[i]);
+  }
+}
+
+TEST(NetworkThreadPoolTest, UsesPlacementPolicy) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  auto policy = rtc::MakeUnique<LastThreadPolicy>();
+  LastThreadPolicy* policy_ptr = policy.get();
+  NetworkThreadPool pool(network_thread.get(), 2, std::move(policy));
+
+  rtc::Thread* first = pool.Acquire();
+  EXPECT_NE(network_thread.get(), first);
+  EXPECT_EQ((std::vector<size_t>{0, 0}), policy_ptr->last_loads_);
+  EXPECT_EQ(first, pool.Acquire());
+  EXPECT_EQ((std::vector<size_t>{0, 1}), policy_ptr->last_loads_);
+  pool.Release(first);
+  pool.Release(first);
+}
+
+TEST(NetworkThreadPoolTest, AcquireDefaultIgnoresPlacementPolicy) {
+  std::unique_ptr<rtc::Thread> network_thread =
+      rtc::Thread::CreateWithSocketServer();
+  network_thread->Start();
+  auto policy = rtc::MakeUnique<LastThreadPolicy>();
+  LastThreadPolicy* policy_ptr = policy.get();
+  NetworkThreadPool pool(network_thread.get(), 3, std::move(policy));
+
+  EXPECT_EQ(network_thread.get(), pool.AcquireDefault());
+  EXPECT_EQ(network_thread.get(), pool.AcquireDefault());
+  EXPECT_TRUE(policy_ptr->last_loads_.empty());
+
+  // PeerConnections pinned to thread 0 still count towards its load.
+  rtc::Thread* other = pool.Acquire();
+  EXPECT_EQ((std::vector<size_t>{2, 0, 0}), policy_ptr->last_loads_);
+  std::vector<NetworkThreadStats> stats = pool.GetStats();
+  ASSERT_EQ(3u, stats.size());
+  EXPECT_EQ(2u, stats[0].peer_connections);
+
+  pool.Release(network_thread.get());
+  pool.Release(network_thread.get());
+  pool.Release(other);
+}
+
+}  // namespace webrtc
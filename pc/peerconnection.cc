@@ -817,9 +817,11 @@ bool ConvertConstraintsToOfferAnswerOptions(
 }
 
 PeerConnection::PeerConnection(PeerConnectionFactory* factory,
+                               rtc::Thread* network_thread,
                                std::unique_ptr<RtcEventLog> event_log,
                                std::unique_ptr<Call> call)
     : factory_(factory),
+      network_thread_(network_thread),
       event_log_(std::move(event_log)),
       rtcp_cname_(GenerateRtcpCname()),
       local_streams_(StreamCollection::Create()),
@@ -863,6 +865,7 @@ PeerConnection::~PeerConnection() {
     // The event log must outlive call (and any other object that uses it).
     event_log_.reset();
   });
+  factory_->ReleaseNetworkThread(network_thread_);
 }
 
 void PeerConnection::DestroyAllChannels() {
@@ -950,7 +953,8 @@ bool PeerConnection::Initialize(
   transport_controller_->SignalDtlsHandshakeError.connect(
       this, &PeerConnection::OnTransportControllerDtlsHandshakeError);
 
-  sctp_factory_ = factory_->CreateSctpTransportInternalFactory();
+  sctp_factory_ =
+      factory_->CreateSctpTransportInternalFactory(network_thread());
 
   stats_.reset(new StatsCollector(this));
   stats_collector_ = RTCStatsCollector::Create(this);
@@ -5499,7 +5503,7 @@ cricket::VoiceChannel* PeerConnection::CreateVoiceChannel(
   RTC_DCHECK(rtp_transport);
   cricket::VoiceChannel* voice_channel = channel_manager()->CreateVoiceChannel(
       call_.get(), configuration_.media_config, rtp_transport,
-      signaling_thread(), mid, SrtpRequired(),
+      network_thread(), signaling_thread(), mid, SrtpRequired(),
       factory_->options().crypto_options, audio_options_);
   if (!voice_channel) {
     return nullptr;
@@ -5524,7 +5528,7 @@ cricket::VideoChannel* PeerConnection::CreateVideoChannel(
   RTC_DCHECK(rtp_transport);
   cricket::VideoChannel* video_channel = channel_manager()->CreateVideoChannel(
       call_.get(), configuration_.media_config, rtp_transport,
-      signaling_thread(), mid, SrtpRequired(),
+      network_thread(), signaling_thread(), mid, SrtpRequired(),
       factory_->options().crypto_options, video_options_);
   if (!video_channel) {
     return nullptr;
@@ -5563,8 +5567,9 @@ bool PeerConnection::CreateDataChannel(const std::string& mid) {
         transport_controller_->GetRtpTransport(mid);
     RTC_DCHECK(rtp_transport);
     rtp_data_channel_ = channel_manager()->CreateRtpDataChannel(
-        configuration_.media_config, rtp_transport, signaling_thread(), mid,
-        SrtpRequired(), factory_->options().crypto_options);
+        configuration_.media_config, rtp_transport, network_thread(),
+        signaling_thread(), mid, SrtpRequired(),
+        factory_->options().crypto_options);
     if (!rtp_data_channel_) {
       return false;
     }
@@ -69,9 +69,12 @@ class PeerConnection : public PeerConnectionInternal,
     CLOSE_CALLED = 0x400
   };
 
-  explicit PeerConnection(PeerConnectionFactory* factory,
-                          std::unique_ptr<RtcEventLog> event_log,
-                          std::unique_ptr<Call> call);
+  // |network_thread| is the one of the factory's network threads this
+  // PeerConnection runs its transports on.
+  PeerConnection(PeerConnectionFactory* factory,
+                 rtc::Thread* network_thread,
+                 std::unique_ptr<RtcEventLog> event_log,
+                 std::unique_ptr<Call> call);
 
   bool Initialize(
       const PeerConnectionInterface::RTCConfiguration& configuration,
@@ -209,9 +212,7 @@ class PeerConnection : public PeerConnectionInternal,
   void Close() override;
 
   // PeerConnectionInternal implementation.
-  rtc::Thread* network_thread() const override {
-    return factory_->network_thread();
-  }
+  rtc::Thread* network_thread() const override { return network_thread_; }
   rtc::Thread* worker_thread() const override {
     return factory_->worker_thread();
   }
@@ -912,6 +913,7 @@ class PeerConnection : public PeerConnectionInternal,
   // PeerConnectionFactoryInterface all instances created using the raw pointer
   // will refer to the same reference count.
   rtc::scoped_refptr<PeerConnectionFactory> factory_;
+  rtc::Thread* const network_thread_;
   PeerConnectionObserver* observer_ = nullptr;
   rtc::scoped_refptr<UMAObserver> uma_observer_ = nullptr;
 
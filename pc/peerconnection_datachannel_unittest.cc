@@ -44,7 +44,7 @@ class PeerConnectionFactoryForDataChannelTest
             nullptr) {}
 
   std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory() {
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread) {
     auto factory = rtc::MakeUnique<FakeSctpTransportFactory>();
     last_fake_sctp_transport_factory_ = factory.get();
     return factory;
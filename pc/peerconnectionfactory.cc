@@ -185,16 +185,18 @@ PeerConnectionFactory::PeerConnectionFactory(
           std::move(dependencies.call_factory),
           std::move(dependencies.event_log_factory),
           std::move(dependencies.fec_controller_factory),
-          std::move(dependencies.network_controller_factory)) {}
+          std::move(dependencies.network_controller_factory)) {
+  network_thread_count_ = dependencies.network_thread_count;
+  network_thread_placement_ = std::move(dependencies.network_thread_placement);
+}
 
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
 
-  // Make sure |worker_thread_| and |signaling_thread_| outlive
-  // |default_socket_factory_| and |default_network_manager_|.
-  default_socket_factory_ = nullptr;
-  default_network_manager_ = nullptr;
+  // Make sure |worker_thread_| and |signaling_thread_| outlive the default
+  // socket factories and network managers held by |network_thread_pool_|.
+  network_thread_pool_ = nullptr;
 
   if (wraps_current_thread_)
     rtc::ThreadManager::Instance()->UnwrapCurrentThread();
@@ -204,16 +206,9 @@ bool PeerConnectionFactory::Initialize() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   rtc::InitRandom(rtc::Time32());
 
-  default_network_manager_.reset(new rtc::BasicNetworkManager());
-  if (!default_network_manager_) {
-    return false;
-  }
-
-  default_socket_factory_.reset(
-      new rtc::BasicPacketSocketFactory(network_thread_));
-  if (!default_socket_factory_) {
-    return false;
-  }
+  network_thread_pool_ = rtc::MakeUnique<NetworkThreadPool>(
+      network_thread_, network_thread_count_,
+      std::move(network_thread_placement_));
 
   channel_manager_ = rtc::MakeUnique<cricket::ChannelManager>(
       std::move(media_engine_), rtc::MakeUnique<cricket::RtpDataEngine>(),
@@ -310,18 +305,28 @@ PeerConnectionFactory::CreatePeerConnection(
     PeerConnectionDependencies dependencies) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
 
+  // An injected port allocator or certificate generator was built for the
+  // factory's network thread, so only PeerConnections that use the defaults
+  // can go to another thread of the pool. The PeerConnection hands the thread
+  // back to the pool when destroyed.
+  rtc::Thread* network_thread =
+      (dependencies.allocator || dependencies.cert_generator)
+          ? network_thread_pool_->AcquireDefault()
+          : network_thread_pool_->Acquire();
+
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator = rtc::MakeUnique<rtc::RTCCertificateGenerator>(
-        signaling_thread_, network_thread_);
+        signaling_thread_, network_thread);
   }
   if (!dependencies.allocator) {
     dependencies.allocator.reset(new cricket::BasicPortAllocator(
-        default_network_manager_.get(), default_socket_factory_.get(),
+        network_thread_pool_->network_manager(network_thread),
+        network_thread_pool_->socket_factory(network_thread),
         configuration.turn_customizer));
   }
 
-  network_thread_->Invoke<void>(
+  network_thread->Invoke<void>(
       RTC_FROM_HERE,
       rtc::Bind(&cricket::PortAllocator::SetNetworkIgnoreMask,
                 dependencies.allocator.get(), options_.network_ignore_mask));
@@ -336,8 +341,8 @@ PeerConnectionFactory::CreatePeerConnection(
       rtc::Bind(&PeerConnectionFactory::CreateCall_w, this, event_log.get()));
 
   rtc::scoped_refptr<PeerConnection> pc(
-      new rtc::RefCountedObject<PeerConnection>(this, std::move(event_log),
-                                                std::move(call)));
+      new rtc::RefCountedObject<PeerConnection>(
+          this, network_thread, std::move(event_log), std::move(call)));
 
   if (!pc->Initialize(configuration, std::move(dependencies))) {
     return nullptr;
@@ -370,9 +375,10 @@ PeerConnectionFactory::CreateAudioTrack(const std::string& id,
 }
 
 std::unique_ptr<cricket::SctpTransportInternalFactory>
-PeerConnectionFactory::CreateSctpTransportInternalFactory() {
+PeerConnectionFactory::CreateSctpTransportInternalFactory(
+    rtc::Thread* network_thread) {
 #ifdef HAVE_SCTP
-  return rtc::MakeUnique<cricket::SctpTransportFactory>(network_thread());
+  return rtc::MakeUnique<cricket::SctpTransportFactory>(network_thread);
 #else
   return nullptr;
 #endif
@@ -396,6 +402,16 @@ rtc::Thread* PeerConnectionFactory::network_thread() {
   return network_thread_;
 }
 
+void PeerConnectionFactory::ReleaseNetworkThread(rtc::Thread* network_thread) {
+  network_thread_pool_->Release(network_thread);
+}
+
+std::vector<NetworkThreadStats> PeerConnectionFactory::GetNetworkThreadStats()
+    const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return network_thread_pool_->GetStats();
+}
+
 std::unique_ptr<RtcEventLog> PeerConnectionFactory::CreateRtcEventLog_w() {
   RTC_DCHECK_RUN_ON(worker_thread_);
   const auto encoding_type = RtcEventLog::EncodingType::Legacy;
@@ -14,20 +14,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/mediastreaminterface.h"
 #include "api/peerconnectioninterface.h"
 #include "media/sctp/sctptransportinternal.h"
 #include "pc/channelmanager.h"
+#include "pc/networkthreadpool.h"
 #include "rtc_base/rtccertificategenerator.h"
 #include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/thread.h"
 
-namespace rtc {
-class BasicNetworkManager;
-class BasicPacketSocketFactory;
-}
-
 namespace webrtc {
 
 class RtcEventLog;
@@ -90,7 +87,7 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   void StopAecDump() override;
 
   virtual std::unique_ptr<cricket::SctpTransportInternalFactory>
-  CreateSctpTransportInternalFactory();
+  CreateSctpTransportInternalFactory(rtc::Thread* network_thread);
 
   virtual cricket::ChannelManager* channel_manager();
   virtual rtc::Thread* signaling_thread();
@@ -98,6 +95,13 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   virtual rtc::Thread* network_thread();
   const Options& options() const { return options_; }
 
+  // Called by a PeerConnection that is being destroyed, to hand back the
+  // network thread it was placed on.
+  void ReleaseNetworkThread(rtc::Thread* network_thread);
+  // Load counters for each of the network threads PeerConnections are spread
+  // across. Must be called on the signaling thread.
+  std::vector<NetworkThreadStats> GetNetworkThreadStats() const;
+
  protected:
   PeerConnectionFactory(
       rtc::Thread* network_thread,
@@ -136,8 +140,11 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<rtc::Thread> owned_worker_thread_;
   Options options_;
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
-  std::unique_ptr<rtc::BasicNetworkManager> default_network_manager_;
-  std::unique_ptr<rtc::BasicPacketSocketFactory> default_socket_factory_;
+  size_t network_thread_count_ = 1;
+  std::unique_ptr<NetworkThreadPlacementPolicy> network_thread_placement_;
+  // Holds |network_thread_| and any additional network threads, with the
+  // default network manager and socket factory for each.
+  std::unique_ptr<NetworkThreadPool> network_thread_pool_;
   std::unique_ptr<cricket::MediaEngineInterface> media_engine_;
   std::unique_ptr<webrtc::CallFactoryInterface> call_factory_;
   std::unique_ptr<RtcEventLogFactoryInterface> event_log_factory_;
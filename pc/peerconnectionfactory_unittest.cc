@@ -15,14 +15,18 @@
 
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/call/callfactoryinterface.h"
 #include "api/mediastreaminterface.h"
 #include "api/video_codecs/builtin_video_decoder_factory.h"
 #include "api/video_codecs/builtin_video_encoder_factory.h"
+#include "logging/rtc_event_log/rtc_event_log_factory.h"
+#include "media/base/fakemediaengine.h"
 #include "media/base/fakevideocapturer.h"
 #include "p2p/base/fakeportallocator.h"
 #include "pc/peerconnectionfactory.h"
 #include "pc/test/fakeaudiocapturemodule.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/ptr_util.h"
 
 #ifdef WEBRTC_ANDROID
 #include "pc/test/androidtestinitializer.h"
@@ -84,6 +88,15 @@ class NullPeerConnectionObserver : public PeerConnectionObserver {
       const webrtc::IceCandidateInterface* candidate) override {}
 };
 
+// Exposes the constructor taking PeerConnectionFactoryDependencies, so tests
+// can reach GetNetworkThreadStats().
+class PeerConnectionFactoryForTest : public webrtc::PeerConnectionFactory {
+ public:
+  explicit PeerConnectionFactoryForTest(
+      webrtc::PeerConnectionFactoryDependencies dependencies)
+      : webrtc::PeerConnectionFactory(std::move(dependencies)) {}
+};
+
 }  // namespace
 
 class PeerConnectionFactoryTest : public testing::Test {
@@ -380,3 +393,44 @@ TEST_F(PeerConnectionFactoryTest, LocalRendering) {
   EXPECT_EQ(3, local_renderer.num_rendered_frames());
   EXPECT_FALSE(local_renderer.black_frame());
 }
+
+// The injected port allocator is bound to the factory's network thread, so
+// the PeerConnection must not be placed on another thread of the pool.
+TEST(PeerConnectionFactoryNetworkThreadTest,
+     InjectedAllocatorKeepsPeerConnectionOnNetworkThread) {
+  webrtc::PeerConnectionFactoryDependencies dependencies;
+  dependencies.network_thread = rtc::Thread::Current();
+  dependencies.worker_thread = rtc::Thread::Current();
+  dependencies.signaling_thread = rtc::Thread::Current();
+  dependencies.media_engine = rtc::MakeUnique<cricket::FakeMediaEngine>();
+  dependencies.call_factory = webrtc::CreateCallFactory();
+  dependencies.event_log_factory = webrtc::CreateRtcEventLogFactory();
+  dependencies.network_thread_count = 3;
+  rtc::scoped_refptr<PeerConnectionFactoryForTest> factory(
+      new rtc::RefCountedObject<PeerConnectionFactoryForTest>(
+          std::move(dependencies)));
+  ASSERT_TRUE(factory->Initialize());
+
+  NullPeerConnectionObserver observer;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> pcs;
+  for (int i = 0; i < 3; ++i) {
+    pcs.push_back(factory->CreatePeerConnection(
+        PeerConnectionInterface::RTCConfiguration(),
+        rtc::MakeUnique<cricket::FakePortAllocator>(rtc::Thread::Current(),
+                                                    nullptr),
+        nullptr, &observer));
+    ASSERT_TRUE(pcs.back());
+  }
+
+  std::vector<webrtc::NetworkThreadStats> stats =
+      factory->GetNetworkThreadStats();
+  ASSERT_EQ(3u, stats.size());
+  EXPECT_EQ(rtc::Thread::Current(), stats[0].thread);
+  EXPECT_EQ(3u, stats[0].peer_connections);
+  EXPECT_EQ(0u, stats[1].total_peer_connections);
+  EXPECT_EQ(0u, stats[2].total_peer_connections);
+
+  pcs.clear();
+  stats = factory->GetNetworkThreadStats();
+  EXPECT_EQ(0u, stats[0].peer_connections);
+}
@@ -833,7 +833,7 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
   std::map<std::string, cricket::TransportStats> transport_stats_by_name =
       pc_->GetTransportStatsByNames(transport_names_);
 
-  std::map<std::string, CertificateStatsPair> transport_cert_stats =
+  const std::map<std::string, CertificateStatsPair>& transport_cert_stats =
       PrepareTransportCertificateStats_n(transport_stats_by_name);
 
   ProduceCertificateStats_n(timestamp_us, transport_cert_stats, report.get());
@@ -1351,32 +1351,56 @@ void RTCStatsCollector::ProduceTransportStats_n(
   }
 }
 
-std::map<std::string, RTCStatsCollector::CertificateStatsPair>
+const std::map<std::string, RTCStatsCollector::CertificateStatsPair>&
 RTCStatsCollector::PrepareTransportCertificateStats_n(
     const std::map<std::string, cricket::TransportStats>&
-        transport_stats_by_name) const {
+        transport_stats_by_name) {
   RTC_DCHECK(network_thread_->IsCurrent());
-  std::map<std::string, CertificateStatsPair> transport_cert_stats;
+  // Forget the transports that are gone.
+  for (auto it = transport_cert_stats_.begin();
+       it != transport_cert_stats_.end();) {
+    if (transport_stats_by_name.find(it->first) ==
+        transport_stats_by_name.end()) {
+      it = transport_cert_stats_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   for (const auto& entry : transport_stats_by_name) {
     const std::string& transport_name = entry.first;
+    CertificateStatsPair& certificate_stats_pair =
+        transport_cert_stats_[transport_name];
 
-    CertificateStatsPair certificate_stats_pair;
+    // The local certificate is immutable, so it is compared by reference.
     rtc::scoped_refptr<rtc::RTCCertificate> local_certificate;
-    if (pc_->GetLocalCertificate(transport_name, &local_certificate)) {
+    if (!pc_->GetLocalCertificate(transport_name, &local_certificate)) {
+      local_certificate = nullptr;
+    }
+    if (local_certificate != certificate_stats_pair.local_certificate) {
       certificate_stats_pair.local =
-          local_certificate->ssl_cert_chain().GetStats();
+          local_certificate ? local_certificate->ssl_cert_chain().GetStats()
+                            : nullptr;
+      certificate_stats_pair.local_certificate = local_certificate;
     }
 
+    // The remote chain is a new copy every time, but its certificates share
+    // the underlying SSL objects, which SSLCertChain::Equals() compares.
     std::unique_ptr<rtc::SSLCertChain> remote_cert_chain =
         pc_->GetRemoteSSLCertChain(transport_name);
-    if (remote_cert_chain) {
-      certificate_stats_pair.remote = remote_cert_chain->GetStats();
+    const rtc::SSLCertChain* previous_remote_cert_chain =
+        certificate_stats_pair.remote_cert_chain.get();
+    const bool remote_cert_chain_changed =
+        remote_cert_chain && previous_remote_cert_chain
+            ? !remote_cert_chain->Equals(*previous_remote_cert_chain)
+            : remote_cert_chain.get() != previous_remote_cert_chain;
+    if (remote_cert_chain_changed) {
+      certificate_stats_pair.remote =
+          remote_cert_chain ? remote_cert_chain->GetStats() : nullptr;
+      certificate_stats_pair.remote_cert_chain = std::move(remote_cert_chain);
     }
-
-    transport_cert_stats.insert(
-        std::make_pair(transport_name, std::move(certificate_stats_pair)));
   }
-  return transport_cert_stats;
+  return transport_cert_stats_;
 }
 
 std::vector<RTCStatsCollector::RtpTransceiverStatsInfo>
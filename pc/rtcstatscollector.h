@@ -133,6 +133,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   struct CertificateStatsPair {
     std::unique_ptr<rtc::SSLCertificateStats> local;
     std::unique_ptr<rtc::SSLCertificateStats> remote;
+    // The certificates that |local| and |remote| were produced from, so that
+    // they are only produced again when the certificates change.
+    rtc::scoped_refptr<rtc::RTCCertificate> local_certificate;
+    std::unique_ptr<rtc::SSLCertChain> remote_cert_chain;
   };
 
   // Structure for tracking stats about each RtpTransceiver managed by the
@@ -204,10 +208,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       RTCStatsReport* report) const;
 
   // Helper function to stats-producing functions.
-  std::map<std::string, CertificateStatsPair>
+  const std::map<std::string, CertificateStatsPair>&
   PrepareTransportCertificateStats_n(
       const std::map<std::string, cricket::TransportStats>&
-          transport_stats_by_name) const;
+          transport_stats_by_name);
   std::vector<RtpTransceiverStatsInfo> PrepareTransceiverStatsInfos_s() const;
   std::set<std::string> PrepareTransportNames_s() const;
 
@@ -237,6 +241,13 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
 
   Call::Stats call_stats_;
 
+  // Certificate stats by transport name, kept between reports since producing
+  // them means computing fingerprints and base64 encoding the certificates.
+  // Telling whether the remote chain changed takes a copy of the chain, but
+  // compares certificates without encoding them. All other stats objects are
+  // produced anew on every report. Only used on the network thread.
+  std::map<std::string, CertificateStatsPair> transport_cert_stats_;
+
   // A timestamp, in microseconds, that is based on a timer that is
   // monotonically increasing. That is, even if the system clock is modified the
   // difference between the timer and this timestamp is how fresh the cached
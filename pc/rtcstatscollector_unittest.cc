@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+
 #include <initializer_list>
 #include <memory>
 #include <ostream>
@@ -865,6 +867,52 @@ TEST_F(RTCStatsCollectorTest, CollectRTCCertificateStatsChain) {
   ExpectReportContainsCertificateInfo(report, *remote_certinfo);
 }
 
+// Certificate stats are kept between reports, but must follow certificate
+// changes.
+TEST_F(RTCStatsCollectorTest, CollectRTCCertificateStatsAfterChange) {
+  const char kTransportName[] = "transport";
+
+  pc_->AddVoiceChannel("audio", kTransportName);
+
+  std::unique_ptr<CertificateInfo> local_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(local) before"});
+  pc_->SetLocalCertificate(kTransportName, local_certinfo->certificate);
+  std::unique_ptr<CertificateInfo> remote_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(remote) before", "(remote) a"});
+  pc_->SetRemoteCertChain(
+      kTransportName,
+      remote_certinfo->certificate->ssl_cert_chain().UniqueCopy());
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+  ExpectReportContainsCertificateInfo(report, *local_certinfo);
+  ExpectReportContainsCertificateInfo(report, *remote_certinfo);
+
+  // An unchanged chain is a new copy every time.
+  pc_->SetRemoteCertChain(
+      kTransportName,
+      remote_certinfo->certificate->ssl_cert_chain().UniqueCopy());
+  report = stats_->GetFreshStatsReport();
+  ExpectReportContainsCertificateInfo(report, *local_certinfo);
+  ExpectReportContainsCertificateInfo(report, *remote_certinfo);
+
+  std::unique_ptr<CertificateInfo> new_local_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(local) after"});
+  pc_->SetLocalCertificate(kTransportName, new_local_certinfo->certificate);
+  std::unique_ptr<CertificateInfo> new_remote_certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(remote) after", "(remote) a"});
+  pc_->SetRemoteCertChain(
+      kTransportName,
+      new_remote_certinfo->certificate->ssl_cert_chain().UniqueCopy());
+
+  report = stats_->GetFreshStatsReport();
+  ExpectReportContainsCertificateInfo(report, *new_local_certinfo);
+  ExpectReportContainsCertificateInfo(report, *new_remote_certinfo);
+  EXPECT_FALSE(
+      report->Get("RTCCertificate_" + local_certinfo->fingerprints[0]));
+  EXPECT_FALSE(
+      report->Get("RTCCertificate_" + remote_certinfo->fingerprints[0]));
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCDataChannelStats) {
   pc_->AddSctpDataChannel(new MockDataChannel(0, "MockDataChannel0",
                                               DataChannelInterface::kConnecting,
@@ -2146,6 +2194,92 @@ TEST_F(RTCStatsCollectorTest, DoNotCrashWhenGetStatsCalledDuringCallback) {
   EXPECT_TRUE_WAIT(callback2->called(), kGetStatsReportTimeoutMs);
 }
 
+// Measures how long a fresh report takes to produce for calls with many
+// remote audio tracks and ICE candidate pairs, how many of its stats objects
+// change between two polls, and how long |RTCStatsReport::DeltaSince| takes to
+// find them.
+TEST(RTCStatsCollectorPerfTest, DISABLED_GetStatsReportTime) {
+  const char kTransportName[] = "transport";
+  const int kNumReports = 20;
+  const size_t kNumTracks[] = {1, 10, 100, 500};
+  const size_t kNumCandidatePairs[] = {1, 10, 100, 500};
+  std::unique_ptr<CertificateInfo> certinfo =
+      CreateFakeCertificateAndInfoFromDers({"(local) leaf", "(local) root"});
+  for (size_t num_tracks : kNumTracks) {
+    for (size_t num_candidate_pairs : kNumCandidatePairs) {
+      rtc::scoped_refptr<FakePeerConnectionForStats> pc(
+          new rtc::RefCountedObject<FakePeerConnectionForStats>());
+      RTCStatsCollectorWrapper stats(pc);
+
+      cricket::VoiceMediaInfo voice_media_info;
+      RtpCodecParameters codec_parameters;
+      codec_parameters.payload_type = 42;
+      codec_parameters.kind = cricket::MEDIA_TYPE_AUDIO;
+      codec_parameters.name = "dummy";
+      codec_parameters.clock_rate = 0;
+      voice_media_info.receive_codecs.insert(
+          std::make_pair(codec_parameters.payload_type, codec_parameters));
+      for (size_t i = 0; i < num_tracks; ++i) {
+        uint32_t ssrc = static_cast<uint32_t>(i + 1);
+        cricket::VoiceReceiverInfo voice_receiver_info;
+        voice_receiver_info.local_stats.push_back(cricket::SsrcReceiverInfo());
+        voice_receiver_info.local_stats[0].ssrc = ssrc;
+        voice_receiver_info.codec_payload_type = codec_parameters.payload_type;
+        voice_media_info.receivers.push_back(voice_receiver_info);
+        stats.SetupRemoteTrackAndReceiver(
+            cricket::MEDIA_TYPE_AUDIO, "RemoteAudioTrackID" + rtc::ToString(i),
+            "RemoteStreamId" + rtc::ToString(i), ssrc);
+      }
+      pc->AddVoiceChannel("AudioMid", kTransportName)
+          ->SetStats(voice_media_info);
+
+      cricket::TransportChannelStats transport_channel_stats;
+      transport_channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+      for (size_t i = 0; i < num_candidate_pairs; ++i) {
+        std::unique_ptr<cricket::Candidate> local_candidate =
+            CreateFakeCandidate("42.42.42.42", static_cast<int>(1000 + i),
+                                "udp", rtc::ADAPTER_TYPE_WIFI,
+                                cricket::LOCAL_PORT_TYPE, 42);
+        std::unique_ptr<cricket::Candidate> remote_candidate =
+            CreateFakeCandidate("24.24.24.24", static_cast<int>(2000 + i),
+                                "udp", rtc::ADAPTER_TYPE_UNKNOWN,
+                                cricket::STUN_PORT_TYPE, 24);
+        cricket::ConnectionInfo connection_info;
+        connection_info.local_candidate = *local_candidate;
+        connection_info.remote_candidate = *remote_candidate;
+        transport_channel_stats.connection_infos.push_back(connection_info);
+      }
+      pc->SetTransportStats(kTransportName, transport_channel_stats);
+      pc->SetLocalCertificate(kTransportName, certinfo->certificate);
+      pc->SetRemoteCertChain(
+          kTransportName, certinfo->certificate->ssl_cert_chain().UniqueCopy());
+
+      rtc::scoped_refptr<const RTCStatsReport> previous =
+          stats.GetFreshStatsReport();
+      rtc::scoped_refptr<const RTCStatsReport> report;
+      const int64_t start_ns = rtc::TimeNanos();
+      for (int i = 0; i < kNumReports; ++i) {
+        report = stats.GetFreshStatsReport();
+      }
+      const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+      std::vector<std::string> removed_ids;
+      rtc::scoped_refptr<RTCStatsReport> delta;
+      const int64_t delta_start_ns = rtc::TimeNanos();
+      for (int i = 0; i < kNumReports; ++i) {
+        removed_ids.clear();
+        delta = report->DeltaSince(*previous, &removed_ids);
+      }
+      const int64_t delta_elapsed_ns = rtc::TimeNanos() - delta_start_ns;
+      printf("%4zu tracks, %4zu candidate pairs: %5zu stats in %8.1f us, "
+             "%5zu changed in %8.1f us more\n",
+             num_tracks, num_candidate_pairs, report->size(),
+             elapsed_ns / (kNumReports * 1000.0),
+             delta->size() + removed_ids.size(),
+             delta_elapsed_ns / (kNumReports * 1000.0));
+    }
+  }
+}
+
 class RTCTestStats : public RTCStats {
  public:
   WEBRTC_RTCSTATS_DECL();
@@ -262,7 +262,16 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet;
+  if (packet_time.buffer.cdata<char>() == data &&
+      packet_time.buffer.size() == len) {
+    // The socket received the packet into a buffer we can keep.
+    packet = std::move(packet_time.buffer);
+  } else {
+    packet.SetData(data, len);
+    received_bytes_copied_ += len;
+  }
+  ++received_packets_;
   // Protect ourselves against crazy data.
   if (!cricket::IsValidRtpRtcpPacketSize(rtcp, packet.size())) {
     RTC_LOG(LS_ERROR) << "Dropping incoming "
@@ -86,6 +86,12 @@ class RtpTransport : public RtpTransportInternal {
   void SetMetricsObserver(
       rtc::scoped_refptr<MetricsObserverInterface> metrics_observer) override {}
 
+  // Number of RTP and RTCP packets read from the packet transports, and the
+  // bytes copied to do so. Packets that the socket received into a buffer
+  // that could be passed on (see rtc::PacketTime::buffer) aren't copied.
+  int64_t received_packets() const { return received_packets_; }
+  int64_t received_bytes_copied() const { return received_bytes_copied_; }
+
  protected:
   // TODO(zstein): Remove this when we remove RtpTransportAdapter.
   RtpTransportAdapter* GetInternal() override;
@@ -152,6 +158,9 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  int64_t received_packets_ = 0;
+  int64_t received_bytes_copied_ = 0;
 };
 
 }  // namespace webrtc
@@ -343,4 +343,39 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// Test that a packet received into a buffer that can be shared is passed on
+// without copying it, and that other packets are counted as copied.
+TEST(RtpTransportTest, TakesOverSocketBufferWithoutCopying) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types = {0x11};
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  rtc::CopyOnWriteBuffer buffer(kRtpData, kRtpLen);
+  const uint8_t* data = buffer.cdata();
+  rtc::PacketTime packet_time;
+  packet_time.buffer = std::move(buffer);
+  fake_rtp.SignalReadPacket(&fake_rtp, reinterpret_cast<const char*>(data),
+                            kRtpLen, packet_time, 0);
+  EXPECT_EQ(1, observer.rtp_count());
+  EXPECT_EQ(data, observer.last_recv_rtp_packet().cdata());
+  EXPECT_EQ(0u, packet_time.buffer.size());
+  EXPECT_EQ(1, transport.received_packets());
+  EXPECT_EQ(0, transport.received_bytes_copied());
+
+  // Without a buffer to take over, the packet is copied.
+  const rtc::PacketOptions options;
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, 0);
+  EXPECT_EQ(2, observer.rtp_count());
+  EXPECT_EQ(2, transport.received_packets());
+  EXPECT_EQ(kRtpLen, transport.received_bytes_copied());
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 }  // namespace webrtc
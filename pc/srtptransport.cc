@@ -120,6 +120,9 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
+  // The packet is protected in place. Senders are expected to have reserved
+  // room for the auth tag already, in which case this is a no-op.
+  packet->EnsureCapacity(packet->size() + cricket::kMaxSrtpTrailerLen);
   uint8_t* data = packet->data();
   int len = rtc::checked_cast<int>(packet->size());
 // If ENABLE_EXTERNAL_AUTH flag is on then packet authentication is not done
@@ -177,6 +180,7 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
   }
 
   TRACE_EVENT0("webrtc", "SRTP Encode");
+  packet->EnsureCapacity(packet->size() + cricket::kMaxSrtpTrailerLen);
   uint8_t* data = packet->data();
   int len = rtc::checked_cast<int>(packet->size());
   if (!ProtectRtcp(data, len, static_cast<int>(packet->capacity()), &len)) {
@@ -13,6 +13,7 @@
 #include "pc/srtptransport.h"
 
 #include "media/base/fakertp.h"
+#include "media/base/rtputils.h"
 #include "p2p/base/dtlstransportinternal.h"
 #include "p2p/base/fakepackettransport.h"
 #include "pc/rtptransport.h"
@@ -318,6 +319,17 @@ class SrtpTransportTest : public testing::Test, public sigslot::has_slots<> {
     TestSendRecvPacketWithEncryptedHeaderExtension(cs_name, encrypted_headers);
   }
 
+  void SetGcmParams() {
+    std::vector<int> extension_ids;
+    const int cs = rtc::SRTP_AEAD_AES_128_GCM;
+    EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+        cs, kTestKeyGcm128_1, kTestKeyGcm128Len, extension_ids, cs,
+        kTestKeyGcm128_2, kTestKeyGcm128Len, extension_ids));
+    EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+        cs, kTestKeyGcm128_2, kTestKeyGcm128Len, extension_ids, cs,
+        kTestKeyGcm128_1, kTestKeyGcm128Len, extension_ids));
+  }
+
   std::unique_ptr<SrtpTransport> srtp_transport1_;
   std::unique_ptr<SrtpTransport> srtp_transport2_;
 
@@ -410,4 +422,53 @@ TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
       rtc::SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen - 1, extension_ids));
 }
 
+// Test that a packet with room reserved for the auth tag is protected in
+// place, without reallocating its buffer.
+TEST_F(SrtpTransportTest, ProtectsRtpInPlaceWithReservedCapacity) {
+  SetGcmParams();
+  const size_t rtp_len = sizeof(kPcmuFrame);
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, rtp_len,
+                                rtp_len + cricket::kMaxSrtpTrailerLen);
+  const uint8_t* data = packet.cdata();
+
+  rtc::PacketOptions options;
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(data, packet.cdata());
+  EXPECT_EQ(rtp_len + rtc::rtp_auth_tag_len(rtc::CS_AEAD_AES_128_GCM),
+            packet.size());
+  ASSERT_EQ(rtp_len, rtp_sink2_.last_recv_rtp_packet().size());
+  EXPECT_EQ(0, memcmp(rtp_sink2_.last_recv_rtp_packet().data(), kPcmuFrame,
+                      rtp_len));
+}
+
+// Test that packets without room for the auth tag are grown as needed and
+// still sent.
+TEST_F(SrtpTransportTest, ProtectsPacketsWithoutReservedCapacity) {
+  SetGcmParams();
+  const size_t rtp_len = sizeof(kPcmuFrame);
+  rtc::CopyOnWriteBuffer rtp_packet(kPcmuFrame, rtp_len);
+  ASSERT_EQ(rtp_len, rtp_packet.capacity());
+
+  rtc::PacketOptions options;
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&rtp_packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtp_len + rtc::rtp_auth_tag_len(rtc::CS_AEAD_AES_128_GCM),
+            rtp_packet.size());
+  ASSERT_EQ(rtp_len, rtp_sink2_.last_recv_rtp_packet().size());
+  EXPECT_EQ(0, memcmp(rtp_sink2_.last_recv_rtp_packet().data(), kPcmuFrame,
+                      rtp_len));
+
+  const size_t rtcp_len = sizeof(::kRtcpReport);
+  rtc::CopyOnWriteBuffer rtcp_packet(::kRtcpReport, rtcp_len);
+  ASSERT_EQ(rtcp_len, rtcp_packet.capacity());
+  ASSERT_TRUE(srtp_transport1_->SendRtcpPacket(&rtcp_packet, options,
+                                               cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtcp_len + 4 + rtc::rtcp_auth_tag_len(rtc::CS_AEAD_AES_128_GCM),
+            rtcp_packet.size());
+  ASSERT_EQ(rtcp_len, rtp_sink2_.last_recv_rtcp_packet().size());
+  EXPECT_EQ(0, memcmp(rtp_sink2_.last_recv_rtcp_packet().data(),
+                      ::kRtcpReport, rtcp_len));
+}
+
 }  // namespace webrtc
@@ -24,10 +24,33 @@ PacketOptions::PacketOptions(DiffServCodePoint dscp) : dscp(dscp) {}
 PacketOptions::PacketOptions(const PacketOptions& other) = default;
 PacketOptions::~PacketOptions() = default;
 
+BatchedPacket::BatchedPacket() = default;
+BatchedPacket::BatchedPacket(const void* data,
+                             size_t size,
+                             const SocketAddress& addr,
+                             const PacketOptions& options)
+    : data(data), size(size), addr(addr), options(options) {}
+BatchedPacket::BatchedPacket(const BatchedPacket& other) = default;
+BatchedPacket::~BatchedPacket() = default;
+
 AsyncPacketSocket::AsyncPacketSocket() = default;
 
 AsyncPacketSocket::~AsyncPacketSocket() = default;
 
+int AsyncPacketSocket::SendToBatch(const BatchedPacket* packets,
+                                   size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    const BatchedPacket& packet = packets[i];
+    if (SendTo(packet.data, packet.size, packet.addr, packet.options) < 0)
+      return (i == 0) ? -1 : static_cast<int>(i);
+  }
+  return static_cast<int>(count);
+}
+
+bool AsyncPacketSocket::EnableBatchedReads(size_t max_packets) {
+  return false;
+}
+
 void CopySocketInformationToPacketInfo(size_t packet_size_bytes,
                                        const AsyncPacketSocket& socket_from,
                                        bool is_connectionless,
@@ -12,6 +12,7 @@
 #define RTC_BASE_ASYNCPACKETSOCKET_H_
 
 #include "rtc_base/constructormagic.h"
+#include "rtc_base/copyonwritebuffer.h"
 #include "rtc_base/dscp.h"
 #include "rtc_base/sigslot.h"
 #include "rtc_base/socket.h"
@@ -64,6 +65,31 @@ struct PacketTime {
   // example, the time of the last select() call.
   // If unknown, this value will be set to zero.
   int64_t not_before;
+
+  // If not empty, the socket received the packet straight into this buffer,
+  // and it holds nothing else. A receiver that gets a |data| and |size|
+  // covering all of the buffer may take it over with std::move() instead of
+  // copying the data; it then must be the last receiver to look at |data|.
+  // Mutable so that it can be taken over through the const references that
+  // the read signals pass. A PacketTime kept for later holds a reference of
+  // its own, and the data is then copied on write instead.
+  mutable CopyOnWriteBuffer buffer;
+};
+
+// A packet handed to AsyncPacketSocket::SendToBatch().
+struct BatchedPacket {
+  BatchedPacket();
+  BatchedPacket(const void* data,
+                size_t size,
+                const SocketAddress& addr,
+                const PacketOptions& options);
+  BatchedPacket(const BatchedPacket& other);
+  ~BatchedPacket();
+
+  const void* data = nullptr;
+  size_t size = 0;
+  SocketAddress addr;
+  PacketOptions options;
 };
 
 inline PacketTime CreatePacketTime(int64_t not_before) {
@@ -97,6 +123,17 @@ class AsyncPacketSocket : public sigslot::has_slots<> {
   virtual int SendTo(const void *pv, size_t cb, const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // Sends |count| packets, handing them to the kernel together where the
+  // socket supports it. Returns the number of packets sent, which may be less
+  // than |count|, or -1 if none were. The default implementation calls
+  // SendTo() for each packet.
+  virtual int SendToBatch(const BatchedPacket* packets, size_t count);
+
+  // Lets a datagram socket drain up to |max_packets| packets per read event,
+  // each delivered through SignalReadPacket. Returns false if the socket does
+  // not support batched reads, which is the default.
+  virtual bool EnableBatchedReads(size_t max_packets);
+
   // Close the socket.
   virtual int Close() = 0;
 
@@ -9,6 +9,9 @@
  */
 
 #include "rtc_base/asyncudpsocket.h"
+
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
@@ -16,6 +19,8 @@ namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
 
+const size_t AsyncUDPSocket::kMaxReadBatchSize;
+
 AsyncUDPSocket* AsyncUDPSocket::Create(
     AsyncSocket* socket,
     const SocketAddress& bind_address) {
@@ -80,6 +85,43 @@ int AsyncUDPSocket::SendTo(const void *pv, size_t cb,
   return ret;
 }
 
+int AsyncUDPSocket::SendToBatch(const BatchedPacket* packets, size_t count) {
+  SendDatagram datagrams[kMaxReadBatchSize];
+  size_t sent_total = 0;
+  while (sent_total < count) {
+    size_t chunk = std::min(count - sent_total, kMaxReadBatchSize);
+    for (size_t i = 0; i < chunk; ++i) {
+      const BatchedPacket& packet = packets[sent_total + i];
+      datagrams[i].data = static_cast<const char*>(packet.data);
+      datagrams[i].size = packet.size;
+      datagrams[i].addr = packet.addr;
+    }
+    int sent = socket_->SendToBatch(datagrams, chunk);
+    int64_t send_time_ms = rtc::TimeMillis();
+    for (int i = 0; i < sent; ++i) {
+      const BatchedPacket& packet = packets[sent_total + i];
+      rtc::SentPacket sent_packet(packet.options.packet_id, send_time_ms,
+                                  packet.options.info_signaled_after_sent);
+      CopySocketInformationToPacketInfo(packet.size, *this, true,
+                                        &sent_packet.info);
+      sent_packet.info.remote_socket_address = packet.addr;
+      SignalSentPacket(this, sent_packet);
+    }
+    if (sent <= 0)
+      break;
+    sent_total += sent;
+    if (static_cast<size_t>(sent) < chunk)
+      break;
+  }
+  return (sent_total == 0 && count > 0) ? -1 : static_cast<int>(sent_total);
+}
+
+bool AsyncUDPSocket::EnableBatchedReads(size_t max_packets) {
+  read_batch_size_ = std::min(max_packets, kMaxReadBatchSize);
+  ConfigureReadBatch();
+  return true;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -93,7 +135,12 @@ int AsyncUDPSocket::GetOption(Socket::Option opt, int* value) {
 }
 
 int AsyncUDPSocket::SetOption(Socket::Option opt, int value) {
-  return socket_->SetOption(opt, value);
+  int ret = socket_->SetOption(opt, value);
+  if (ret == 0 && opt == Socket::OPT_UDP_GRO) {
+    gro_enabled_ = (value != 0);
+    ConfigureReadBatch();
+  }
+  return ret;
 }
 
 int AsyncUDPSocket::GetError() const {
@@ -107,6 +154,11 @@ void AsyncUDPSocket::SetError(int error) {
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
+  if (!read_batch_.empty()) {
+    ReadBatch();
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp;
   int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
@@ -129,6 +181,79 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
       (timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0)));
 }
 
+void AsyncUDPSocket::ConfigureReadBatch() {
+  read_buffers_.clear();
+  if (gro_enabled_) {
+    read_batch_.resize(1);
+    read_batch_[0].data = buf_;
+    read_batch_[0].size = size_;
+    return;
+  }
+  if (read_batch_size_ <= 1) {
+    read_batch_.clear();
+    return;
+  }
+  // Keep enough spare buffers to cover the packets of a couple of reads that
+  // are still queued up on other threads.
+  buffer_pool_ = ReceiveBufferPool::Create(size_, 2 * read_batch_size_);
+  read_batch_.resize(read_batch_size_);
+  read_buffers_.resize(read_batch_size_);
+}
+
+void AsyncUDPSocket::ReadBatch() {
+  for (size_t i = 0; i < read_buffers_.size(); ++i) {
+    CopyOnWriteBuffer& buffer = read_buffers_[i];
+    // A receiver took over the buffer, or this is the first read.
+    if (buffer.capacity() == 0)
+      buffer = buffer_pool_->Get();
+    else
+      buffer.SetSize(buffer_pool_->capacity());
+    read_batch_[i].data = buffer.data<char>();
+    read_batch_[i].size = buffer.size();
+  }
+
+  int count = socket_->RecvFromBatch(read_batch_.data(), read_batch_.size());
+  if (count < 0) {
+    // See OnReadEvent() for why this is not treated as fatal.
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    const RecvDatagram& datagram = read_batch_[i];
+    if (datagram.truncated) {
+      RTC_LOG(LS_WARNING) << "Dropping packet larger than " << datagram.size
+                          << " bytes received in batched mode.";
+      continue;
+    }
+    PacketTime packet_time = (datagram.timestamp > -1)
+                                 ? PacketTime(datagram.timestamp, 0)
+                                 : CreatePacketTime(0);
+    if (datagram.segment_size == 0) {
+      if (!read_buffers_.empty()) {
+        read_buffers_[i].SetSize(datagram.length);
+        packet_time.buffer = std::move(read_buffers_[i]);
+      }
+      SignalReadPacket(this, datagram.data, datagram.length, datagram.addr,
+                       packet_time);
+      // Read into the buffer again unless a receiver took it over.
+      if (!read_buffers_.empty())
+        read_buffers_[i] = std::move(packet_time.buffer);
+      continue;
+    }
+    // Split packets coalesced by UDP GRO.
+    const size_t segment_size = datagram.segment_size;
+    for (size_t offset = 0; offset < datagram.length; offset += segment_size) {
+      SignalReadPacket(this, datagram.data + offset,
+                       std::min(segment_size, datagram.length - offset),
+                       datagram.addr, packet_time);
+    }
+  }
+}
+
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
   SignalReadyToSend(this);
 }
@@ -12,8 +12,12 @@
 #define RTC_BASE_ASYNCUDPSOCKET_H_
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/asyncpacketsocket.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/receivebufferpool.h"
+#include "rtc_base/scoped_ref_ptr.h"
 #include "rtc_base/socketfactory.h"
 
 namespace rtc {
@@ -22,6 +26,9 @@ namespace rtc {
 // buffered since it is acceptable to drop packets under high load.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
+  // Upper bound for EnableBatchedReads().
+  static const size_t kMaxReadBatchSize = 64;
+
   // Binds |socket| and creates AsyncUDPSocket for it. Takes ownership
   // of |socket|. Returns null if bind() fails (|socket| is destroyed
   // in that case).
@@ -43,6 +50,13 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  int SendToBatch(const BatchedPacket* packets, size_t count) override;
+  // In batched mode packets are received straight into pooled buffers as
+  // large as the largest datagram, which are offered to receivers through
+  // PacketTime::buffer so they can keep a packet without copying it. Only the
+  // pages a packet is written to are touched. With OPT_UDP_GRO set, coalesced
+  // packets use the full receive buffer instead and are not offered.
+  bool EnableBatchedReads(size_t max_packets) override;
   int Close() override;
 
   State GetState() const override;
@@ -56,10 +70,23 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(AsyncSocket* socket);
+  // Drains up to |read_batch_.size()| packets with a single RecvFromBatch().
+  void ReadBatch();
+  // Sets up |read_batch_| for the current batch size and GRO state.
+  void ConfigureReadBatch();
 
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Receive slots used in batched mode. With GRO there is a single slot
+  // pointing into |buf_|; otherwise slot i points into |read_buffers_[i]|.
+  std::vector<RecvDatagram> read_batch_;
+  std::vector<CopyOnWriteBuffer> read_buffers_;
+  scoped_refptr<ReceiveBufferPool> buffer_pool_;
+  size_t read_batch_size_ = 1;
+  // True once OPT_UDP_GRO was set. Coalesced packets can be as large as the
+  // full receive buffer, so only one slot is used and split afterwards.
+  bool gro_enabled_ = false;
 };
 
 }  // namespace rtc
@@ -224,6 +224,9 @@ class CopyOnWriteBuffer {
   }
 
  private:
+  // Hands out buffers that return to the pool instead of being freed.
+  friend class ReceiveBufferPool;
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects.
   void CloneDataIfReferenced(size_t new_capacity);
@@ -93,37 +93,49 @@ size_t ComputeHmac(MessageDigest* digest,
                    const void* key, size_t key_len,
                    const void* input, size_t in_len,
                    void* output, size_t out_len) {
+  return ComputeHmac(digest, key, key_len, input, in_len, nullptr, 0, output,
+                     out_len);
+}
+
+size_t ComputeHmac(MessageDigest* digest,
+                   const void* key, size_t key_len,
+                   const void* input1, size_t in1_len,
+                   const void* input2, size_t in2_len,
+                   void* output, size_t out_len) {
   // We only handle algorithms with a 64-byte blocksize.
   // TODO: Add BlockSize() method to MessageDigest.
-  size_t block_len = kBlockSize;
+  const size_t block_len = kBlockSize;
   if (digest->Size() > 32) {
     return 0;
   }
   // Copy the key to a block-sized buffer to simplify padding.
   // If the key is longer than a block, hash it and use the result instead.
-  std::unique_ptr<uint8_t[]> new_key(new uint8_t[block_len]);
+  uint8_t new_key[kBlockSize];
   if (key_len > block_len) {
-    ComputeDigest(digest, key, key_len, new_key.get(), block_len);
-    memset(new_key.get() + digest->Size(), 0, block_len - digest->Size());
+    ComputeDigest(digest, key, key_len, new_key, block_len);
+    memset(new_key + digest->Size(), 0, block_len - digest->Size());
   } else {
-    memcpy(new_key.get(), key, key_len);
-    memset(new_key.get() + key_len, 0, block_len - key_len);
+    memcpy(new_key, key, key_len);
+    memset(new_key + key_len, 0, block_len - key_len);
   }
   // Set up the padding from the key, salting appropriately for each padding.
-  std::unique_ptr<uint8_t[]> o_pad(new uint8_t[block_len]);
-  std::unique_ptr<uint8_t[]> i_pad(new uint8_t[block_len]);
+  uint8_t o_pad[kBlockSize];
+  uint8_t i_pad[kBlockSize];
   for (size_t i = 0; i < block_len; ++i) {
     o_pad[i] = 0x5c ^ new_key[i];
     i_pad[i] = 0x36 ^ new_key[i];
   }
-  // Inner hash; hash the inner padding, and then the input buffer.
-  std::unique_ptr<uint8_t[]> inner(new uint8_t[digest->Size()]);
-  digest->Update(i_pad.get(), block_len);
-  digest->Update(input, in_len);
-  digest->Finish(inner.get(), digest->Size());
+  // Inner hash; hash the inner padding, and then the input buffers.
+  uint8_t inner[MessageDigest::kMaxSize];
+  digest->Update(i_pad, block_len);
+  digest->Update(input1, in1_len);
+  if (in2_len > 0) {
+    digest->Update(input2, in2_len);
+  }
+  digest->Finish(inner, digest->Size());
   // Outer hash; hash the outer padding, and then the result of the inner hash.
-  digest->Update(o_pad.get(), block_len);
-  digest->Update(inner.get(), digest->Size());
+  digest->Update(o_pad, block_len);
+  digest->Update(inner, digest->Size());
   return digest->Finish(output, out_len);
 }
 
@@ -85,6 +85,12 @@ inline std::string MD5(const std::string& input) {
 size_t ComputeHmac(MessageDigest* digest, const void* key, size_t key_len,
                    const void* input, size_t in_len,
                    void* output, size_t out_len);
+// Like the previous function, but computes the HMAC of |input1| followed by
+// |input2|, without joining them in a buffer first.
+size_t ComputeHmac(MessageDigest* digest, const void* key, size_t key_len,
+                   const void* input1, size_t in1_len,
+                   const void* input2, size_t in2_len,
+                   void* output, size_t out_len);
 // Like the previous function, but creates a digest implementation based on
 // the desired digest name |alg|, e.g. DIGEST_SHA_1. Returns 0 if there is no
 // digest with the given name.
@@ -9,6 +9,9 @@
  */
 
 #include "rtc_base/messagedigest.h"
+
+#include <memory>
+
 #include "rtc_base/gunit.h"
 #include "rtc_base/stringencode.h"
 
@@ -142,6 +145,24 @@ TEST(MessageDigestTest, TestSha1Hmac) {
           input.c_str(), input.size(), output, sizeof(output) - 1));
 }
 
+TEST(MessageDigestTest, TestSha1HmacOfTwoInputs) {
+  std::unique_ptr<MessageDigest> digest(
+      MessageDigestFactory::Create(DIGEST_SHA_1));
+  ASSERT_TRUE(digest);
+  std::string key = "Jefe";
+  std::string input = "what do ya want for nothing?";
+  char output[20];
+  // The digest can be reused, and the split point doesn't matter.
+  for (size_t split = 0; split <= input.size(); split += 7) {
+    EXPECT_EQ(sizeof(output),
+        ComputeHmac(digest.get(), key.c_str(), key.size(), input.c_str(),
+            split, input.c_str() + split, input.size() - split, output,
+            sizeof(output)));
+    EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+        hex_encode(output, sizeof(output)));
+  }
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
@@ -302,6 +302,14 @@ bool OpenSSLCertificate::operator!=(const OpenSSLCertificate& other) const {
   return !(*this == other);
 }
 
+bool OpenSSLCertificate::Equals(const SSLCertificate& other) const {
+  // Copies made by GetReference() share the X509 object, and X509_cmp()
+  // compares the hashes and encodings OpenSSL caches in it.
+  const OpenSSLCertificate& openssl_other =
+      static_cast<const OpenSSLCertificate&>(other);
+  return x509_ == openssl_other.x509_ || *this == openssl_other;
+}
+
 // Documented in sslidentity.h.
 int64_t OpenSSLCertificate::CertificateExpirationTime() const {
   ASN1_TIME* expire_time = X509_get_notAfter(x509_);
@@ -50,6 +50,7 @@ class OpenSSLCertificate : public SSLCertificate {
   void ToDER(Buffer* der_buffer) const override;
   bool operator==(const OpenSSLCertificate& other) const;
   bool operator!=(const OpenSSLCertificate& other) const;
+  bool Equals(const SSLCertificate& other) const override;
 
   // Compute the digest of the certificate given algorithm
   bool ComputeDigest(const std::string& algorithm,
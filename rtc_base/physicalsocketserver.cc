@@ -68,6 +68,26 @@ typedef void* SockOptArg;
 
 #endif  // WEBRTC_POSIX
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// recvmmsg/sendmmsg are available starting with Linux 2.6.33/3.0.
+#define WEBRTC_USE_MMSG 1
+// Upper bound on the number of datagrams moved by one recvmmsg/sendmmsg call.
+static const size_t kMaxDatagramBatchSize = 64;
+// UDP segmentation offload (Linux 4.18) and receive offload (Linux 5.0).
+#if !defined(SOL_UDP)
+#define SOL_UDP 17
+#endif
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
+// Kernel limits on a single segmentation offload send.
+static const size_t kMaxGsoSegments = 64;
+static const size_t kMaxGsoPayloadSize = 65000;
+#endif
+
 #if defined(WEBRTC_POSIX) && !defined(WEBRTC_MAC) && !defined(__native_client__)
 
 int64_t GetSocketRecvTimestamp(int socket) {
@@ -288,6 +308,14 @@ AsyncSocket::ConnState PhysicalSocket::GetState() const {
 }
 
 int PhysicalSocket::GetOption(Option opt, int* value) {
+  if (opt == OPT_UDP_GSO) {
+    // The kernel option holds the default segment size; report whether
+    // per-send segmentation is in use instead.
+    if (!udp_gso_)
+      return -1;
+    *value = 1;
+    return 0;
+  }
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -307,6 +335,23 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
     return -1;
+  if (opt == OPT_UDP_GSO || opt == OPT_UDP_GRO) {
+    if (!udp_)
+      return -1;
+    // For OPT_UDP_GSO this only probes for kernel support; a default segment
+    // size of zero keeps plain sends unaffected. The segment size is passed
+    // per send in SendToBatch().
+    int option_value = (opt == OPT_UDP_GRO) ? value : 0;
+    int ret = ::setsockopt(s_, slevel, sopt, (SockOptArg)&option_value,
+                           sizeof(option_value));
+    if (ret == 0) {
+      if (opt == OPT_UDP_GSO)
+        udp_gso_ = (value != 0);
+      else
+        udp_gro_ = (value != 0);
+    }
+    return ret;
+  }
   if (opt == OPT_DONTFRAGMENT) {
 #if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
     value = (value) ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
@@ -420,6 +465,158 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(RecvDatagram* datagrams, size_t count) {
+#if defined(WEBRTC_USE_MMSG)
+  // With GRO a single datagram may carry several coalesced ones, which only
+  // recvmmsg can report.
+  if (!udp_ || (count < 2 && !udp_gro_))
+    return AsyncSocket::RecvFromBatch(datagrams, count);
+  count = std::min(count, kMaxDatagramBatchSize);
+  mmsghdr msgs[kMaxDatagramBatchSize];
+  iovec iovs[kMaxDatagramBatchSize];
+  sockaddr_storage addrs[kMaxDatagramBatchSize];
+  char control[kMaxDatagramBatchSize][CMSG_SPACE(sizeof(int))];
+  memset(msgs, 0, count * sizeof(msgs[0]));
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = datagrams[i].data;
+    iovs[i].iov_len = datagrams[i].size;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    if (udp_gro_) {
+      msgs[i].msg_hdr.msg_control = control[i];
+      msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+  }
+  int received =
+      ::recvmmsg(s_, msgs, static_cast<unsigned int>(count), 0, nullptr);
+  UpdateLastError();
+  if (received > 0) {
+    // SIOCGSTAMP reports the arrival time of the last datagram read. All of
+    // them were already queued when the socket became readable, so one lookup
+    // serves the whole batch.
+    int64_t timestamp = GetSocketRecvTimestamp(s_);
+    for (int i = 0; i < received; ++i) {
+      RecvDatagram& datagram = datagrams[i];
+      SocketAddressFromSockAddrStorage(addrs[i], &datagram.addr);
+      datagram.length = msgs[i].msg_len;
+      datagram.truncated = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+      datagram.timestamp = timestamp;
+      datagram.segment_size = 0;
+      if (!udp_gro_)
+        continue;
+      for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg;
+           cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+          int segment_size;
+          memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+          if (segment_size > 0 &&
+              static_cast<size_t>(segment_size) < datagram.length) {
+            datagram.segment_size = segment_size;
+          }
+        }
+      }
+    }
+  }
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+#else
+  return AsyncSocket::RecvFromBatch(datagrams, count);
+#endif
+}
+
+int PhysicalSocket::SendToBatch(const SendDatagram* datagrams, size_t count) {
+#if defined(WEBRTC_USE_MMSG)
+  if (!udp_ || count < 2)
+    return AsyncSocket::SendToBatch(datagrams, count);
+  count = std::min(count, kMaxDatagramBatchSize);
+  mmsghdr msgs[kMaxDatagramBatchSize];
+  iovec iovs[kMaxDatagramBatchSize];
+  sockaddr_storage addrs[kMaxDatagramBatchSize];
+  char control[kMaxDatagramBatchSize][CMSG_SPACE(sizeof(uint16_t))];
+  // Number of datagrams carried by each message.
+  size_t datagrams_per_msg[kMaxDatagramBatchSize];
+  size_t num_msgs = 0;
+  memset(msgs, 0, count * sizeof(msgs[0]));
+  for (size_t i = 0; i < count;) {
+    const SendDatagram& first = datagrams[i];
+    size_t run = 1;
+    if (udp_gso_ && first.size > 0) {
+      // Coalesce following datagrams to the same address. All segments but
+      // the last must have the size of the first one.
+      size_t total = first.size;
+      while (i + run < count && run < kMaxGsoSegments) {
+        const SendDatagram& next = datagrams[i + run];
+        if (next.size == 0 || next.size > first.size ||
+            total + next.size > kMaxGsoPayloadSize ||
+            !(next.addr == first.addr)) {
+          break;
+        }
+        total += next.size;
+        ++run;
+        if (next.size < first.size)
+          break;
+      }
+    }
+    mmsghdr& msg = msgs[num_msgs];
+    for (size_t j = 0; j < run; ++j) {
+      iovs[i + j].iov_base = const_cast<char*>(datagrams[i + j].data);
+      iovs[i + j].iov_len = datagrams[i + j].size;
+    }
+    msg.msg_hdr.msg_name = &addrs[num_msgs];
+    msg.msg_hdr.msg_namelen =
+        static_cast<socklen_t>(first.addr.ToSockAddrStorage(&addrs[num_msgs]));
+    msg.msg_hdr.msg_iov = &iovs[i];
+    msg.msg_hdr.msg_iovlen = run;
+    if (run > 1) {
+      msg.msg_hdr.msg_control = control[num_msgs];
+      msg.msg_hdr.msg_controllen = sizeof(control[num_msgs]);
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      uint16_t segment_size = static_cast<uint16_t>(first.size);
+      memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+    }
+    datagrams_per_msg[num_msgs++] = run;
+    i += run;
+  }
+  // Suppress SIGPIPE. See PhysicalSocket::Send for explanation.
+  int sent_msgs = ::sendmmsg(s_, msgs, static_cast<unsigned int>(num_msgs),
+                             MSG_NOSIGNAL);
+  UpdateLastError();
+  MaybeRemapSendError();
+  if (sent_msgs < 0 && udp_gso_ && datagrams_per_msg[0] > 1 &&
+      (GetError() == EINVAL || GetError() == EIO)) {
+    // The segment size exceeds the path MTU or the device cannot offload
+    // checksums. Stop coalescing and retry with one message per datagram.
+    RTC_LOG(LS_WARNING) << "UDP segmentation offload failed with error "
+                        << GetError() << "; disabling it.";
+    udp_gso_ = false;
+    return SendToBatch(datagrams, count);
+  }
+  int sent = sent_msgs;
+  if (sent_msgs > 0) {
+    sent = 0;
+    for (int i = 0; i < sent_msgs; ++i)
+      sent += static_cast<int>(datagrams_per_msg[i]);
+  }
+  if ((sent >= 0 && sent < static_cast<int>(count)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return AsyncSocket::SendToBatch(datagrams, count);
+#endif
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -457,6 +654,8 @@ int PhysicalSocket::Close() {
   UpdateLastError();
   s_ = INVALID_SOCKET;
   state_ = CS_CLOSED;
+  udp_gso_ = false;
+  udp_gro_ = false;
   SetEnabledEvents(0);
   if (resolver_) {
     resolver_->Destroy(false);
@@ -563,6 +762,31 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       return -1;
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_UDP_GSO:
+#if defined(WEBRTC_USE_MMSG)
+      *slevel = SOL_UDP;
+      *sopt = UDP_SEGMENT;
+      break;
+#else
+      return -1;
+#endif
+    case OPT_UDP_GRO:
+#if defined(WEBRTC_USE_MMSG)
+      *slevel = SOL_UDP;
+      *sopt = UDP_GRO;
+      break;
+#else
+      return -1;
+#endif
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_NOTREACHED();
       return -1;
@@ -164,6 +164,11 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
                SocketAddress* out_addr,
                int64_t* timestamp) override;
 
+  // Use recvmmsg/sendmmsg where available so that a burst of datagrams costs
+  // a single system call.
+  int RecvFromBatch(RecvDatagram* datagrams, size_t count) override;
+  int SendToBatch(const SendDatagram* datagrams, size_t count) override;
+
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
 
@@ -199,6 +204,9 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   PhysicalSocketServer* ss_;
   SOCKET s_;
   bool udp_;
+  // Set through OPT_UDP_GSO / OPT_UDP_GRO once the kernel accepted them.
+  bool udp_gso_ = false;
+  bool udp_gro_ = false;
   CriticalSection crit_;
   int error_ RTC_GUARDED_BY(crit_);
   ConnState state_;
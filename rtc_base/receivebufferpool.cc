@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receivebufferpool.h"
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/refcountedobject.h"
+
+namespace rtc {
+
+// A Buffer that goes back to its pool when the last reference is dropped.
+class ReceiveBufferPool::PooledBuffer : public RefCountedObject<Buffer> {
+ public:
+  explicit PooledBuffer(size_t capacity)
+      : RefCountedObject<Buffer>(size_t{0}, capacity) {}
+  ~PooledBuffer() override {}
+
+  void set_pool(ReceiveBufferPool* pool) { pool_ = pool; }
+
+  RefCountReleaseStatus Release() const override {
+    const auto status = ref_count_.DecRef();
+    if (status == RefCountReleaseStatus::kDroppedLastRef) {
+      // |pool_| may hold the last reference to the pool, which in turn may
+      // delete this buffer, so keep it alive until Return() is done.
+      scoped_refptr<ReceiveBufferPool> pool = std::move(pool_);
+      pool->Return(const_cast<PooledBuffer*>(this));
+    }
+    return status;
+  }
+
+ private:
+  // Set while the buffer is handed out.
+  mutable scoped_refptr<ReceiveBufferPool> pool_;
+};
+
+// static
+scoped_refptr<ReceiveBufferPool> ReceiveBufferPool::Create(
+    size_t capacity,
+    size_t max_free_buffers) {
+  return new RefCountedObject<ReceiveBufferPool>(capacity, max_free_buffers);
+}
+
+ReceiveBufferPool::ReceiveBufferPool(size_t capacity, size_t max_free_buffers)
+    : capacity_(capacity), max_free_buffers_(max_free_buffers) {
+  RTC_DCHECK_GT(capacity, 0);
+}
+
+ReceiveBufferPool::~ReceiveBufferPool() = default;
+
+CopyOnWriteBuffer ReceiveBufferPool::Get() {
+  std::unique_ptr<PooledBuffer> buffer;
+  {
+    CritScope cs(&lock_);
+    if (!free_buffers_.empty()) {
+      buffer = std::move(free_buffers_.back());
+      free_buffers_.pop_back();
+    } else {
+      ++allocated_buffers_;
+    }
+  }
+  if (!buffer)
+    buffer.reset(new PooledBuffer(capacity_));
+  buffer->set_pool(this);
+  buffer->SetSize(capacity_);
+
+  CopyOnWriteBuffer result;
+  result.buffer_ = buffer.release();
+  return result;
+}
+
+size_t ReceiveBufferPool::allocated_buffers() const {
+  CritScope cs(&lock_);
+  return allocated_buffers_;
+}
+
+void ReceiveBufferPool::Return(PooledBuffer* buffer) {
+  std::unique_ptr<PooledBuffer> owned_buffer(buffer);
+  CritScope cs(&lock_);
+  if (free_buffers_.size() < max_free_buffers_)
+    free_buffers_.push_back(std::move(owned_buffer));
+}
+
+}  // namespace rtc
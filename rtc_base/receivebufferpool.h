@@ -0,0 +1,70 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_RECEIVEBUFFERPOOL_H_
+#define RTC_BASE_RECEIVEBUFFERPOOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/constructormagic.h"
+#include "rtc_base/copyonwritebuffer.h"
+#include "rtc_base/criticalsection.h"
+#include "rtc_base/refcount.h"
+#include "rtc_base/scoped_ref_ptr.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Hands out CopyOnWriteBuffers of a fixed capacity for sockets to receive
+// into. Once the last CopyOnWriteBuffer referring to a buffer lets go of it,
+// on whichever thread that happens, the buffer goes back to the pool instead
+// of being freed. This lets a received packet be passed up the stack and kept
+// by its consumers without copying it, while the socket still does not
+// allocate per packet in the steady state. Senders use it the same way for the
+// packets they build.
+//
+// The pool is reference counted; buffers handed out keep it alive.
+class ReceiveBufferPool : public RefCountInterface {
+ public:
+  // Creates a pool of buffers with room for |capacity| bytes, keeping at most
+  // |max_free_buffers| unused buffers around.
+  static scoped_refptr<ReceiveBufferPool> Create(size_t capacity,
+                                                 size_t max_free_buffers);
+
+  // Returns a buffer with size() == capacity(), not shared with anyone.
+  CopyOnWriteBuffer Get();
+
+  size_t capacity() const { return capacity_; }
+  // Number of buffers allocated so far, for tests.
+  size_t allocated_buffers() const;
+
+ protected:
+  ReceiveBufferPool(size_t capacity, size_t max_free_buffers);
+  ~ReceiveBufferPool() override;
+
+ private:
+  class PooledBuffer;
+
+  void Return(PooledBuffer* buffer);
+
+  const size_t capacity_;
+  const size_t max_free_buffers_;
+  CriticalSection lock_;
+  std::vector<std::unique_ptr<PooledBuffer>> free_buffers_
+      RTC_GUARDED_BY(lock_);
+  size_t allocated_buffers_ RTC_GUARDED_BY(lock_) = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ReceiveBufferPool);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_RECEIVEBUFFERPOOL_H_
@@ -0,0 +1,88 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/receivebufferpool.h"
+
+#include <utility>
+
+#include "rtc_base/gunit.h"
+
+namespace rtc {
+
+TEST(ReceiveBufferPoolTest, HandsOutBuffersOfFullCapacity) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 4);
+  CopyOnWriteBuffer buffer = pool->Get();
+  EXPECT_EQ(100u, buffer.size());
+  EXPECT_GE(buffer.capacity(), 100u);
+  EXPECT_EQ(1u, pool->allocated_buffers());
+}
+
+TEST(ReceiveBufferPoolTest, ReusesReleasedBuffers) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 4);
+  const uint8_t* data;
+  {
+    CopyOnWriteBuffer buffer = pool->Get();
+    data = buffer.data();
+    buffer.SetSize(10);
+  }
+  CopyOnWriteBuffer buffer = pool->Get();
+  EXPECT_EQ(data, buffer.cdata());
+  EXPECT_EQ(100u, buffer.size());
+  EXPECT_EQ(1u, pool->allocated_buffers());
+}
+
+TEST(ReceiveBufferPoolTest, ReusesBufferOnlyWhenAllCopiesAreGone) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 4);
+  CopyOnWriteBuffer copy;
+  {
+    CopyOnWriteBuffer buffer = pool->Get();
+    copy = buffer;
+  }
+  CopyOnWriteBuffer other = pool->Get();
+  EXPECT_NE(copy.cdata(), other.cdata());
+  EXPECT_EQ(2u, pool->allocated_buffers());
+
+  const uint8_t* data = copy.cdata();
+  copy = CopyOnWriteBuffer();
+  EXPECT_EQ(data, pool->Get().cdata());
+  EXPECT_EQ(2u, pool->allocated_buffers());
+}
+
+TEST(ReceiveBufferPoolTest, WritingToSharedBufferCopiesIt) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 4);
+  CopyOnWriteBuffer buffer = pool->Get();
+  buffer.data()[0] = 1;
+  CopyOnWriteBuffer copy = buffer;
+  copy.data()[0] = 2;
+  EXPECT_EQ(1, buffer.cdata()[0]);
+  EXPECT_EQ(2, copy.cdata()[0]);
+}
+
+TEST(ReceiveBufferPoolTest, BuffersOutliveThePool) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 4);
+  CopyOnWriteBuffer buffer = pool->Get();
+  buffer.data()[0] = 7;
+  pool = nullptr;
+  EXPECT_EQ(7, buffer.cdata()[0]);
+}
+
+TEST(ReceiveBufferPoolTest, KeepsAtMostMaxFreeBuffers) {
+  scoped_refptr<ReceiveBufferPool> pool = ReceiveBufferPool::Create(100, 1);
+  {
+    CopyOnWriteBuffer first = pool->Get();
+    CopyOnWriteBuffer second = pool->Get();
+  }
+  EXPECT_EQ(2u, pool->allocated_buffers());
+  CopyOnWriteBuffer first = pool->Get();
+  CopyOnWriteBuffer second = pool->Get();
+  EXPECT_EQ(3u, pool->allocated_buffers());
+}
+
+}  // namespace rtc
@@ -24,4 +24,26 @@ SentPacket::SentPacket(int64_t packet_id,
                        const rtc::PacketInfo& info)
     : packet_id(packet_id), send_time_ms(send_time_ms), info(info) {}
 
+int Socket::RecvFromBatch(RecvDatagram* datagrams, size_t count) {
+  if (count == 0)
+    return 0;
+  RecvDatagram& datagram = datagrams[0];
+  int received = RecvFrom(datagram.data, datagram.size, &datagram.addr,
+                          &datagram.timestamp);
+  if (received < 0)
+    return received;
+  datagram.length = static_cast<size_t>(received);
+  datagram.truncated = false;
+  datagram.segment_size = 0;
+  return 1;
+}
+
+int Socket::SendToBatch(const SendDatagram* datagrams, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (SendTo(datagrams[i].data, datagrams[i].size, datagrams[i].addr) < 0)
+      return (i == 0) ? SOCKET_ERROR : static_cast<int>(i);
+  }
+  return static_cast<int>(count);
+}
+
 }  // namespace rtc
@@ -167,6 +167,31 @@ struct SentPacket {
   rtc::PacketInfo info;
 };
 
+// Describes one slot of a batched datagram receive. |data| and |size| describe
+// the buffer to read into; the remaining fields are filled in for every
+// datagram received.
+struct RecvDatagram {
+  char* data = nullptr;
+  size_t size = 0;
+  size_t length = 0;
+  // True if the datagram did not fit into |size| bytes and was cut short.
+  bool truncated = false;
+  // Non-zero if |data| holds several datagrams from the same sender that the
+  // kernel coalesced (UDP GRO). Each is |segment_size| bytes long, except
+  // possibly the last one.
+  size_t segment_size = 0;
+  SocketAddress addr;
+  // Receive time in microseconds, or -1 if unknown.
+  int64_t timestamp = -1;
+};
+
+// Describes one datagram of a batched send.
+struct SendDatagram {
+  const char* data = nullptr;
+  size_t size = 0;
+  SocketAddress addr;
+};
+
 // General interface for the socket implementations of various networks.  The
 // methods match those of normal UNIX sockets very closely.
 class Socket {
@@ -191,6 +216,15 @@ class Socket {
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Receives up to |count| datagrams using as few system calls as the
+  // implementation allows. Returns the number of datagrams received, or
+  // SOCKET_ERROR if none could be read. The default implementation reads a
+  // single datagram with RecvFrom().
+  virtual int RecvFromBatch(RecvDatagram* datagrams, size_t count);
+  // Sends |count| datagrams in order. Returns the number of datagrams sent,
+  // which may be less than |count|, or SOCKET_ERROR if the first one could not
+  // be sent. The default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(const SendDatagram* datagrams, size_t count);
   virtual int Listen(int backlog) = 0;
   virtual Socket *Accept(SocketAddress *paddr) = 0;
   virtual int Close() = 0;
@@ -215,6 +249,13 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_UDP_GSO,  // Whether SendToBatch() may coalesce consecutive datagrams
+                  // to the same address into one segmentation offload send.
+    OPT_UDP_GRO,  // Whether the kernel may coalesce received datagrams. Only
+                  // RecvFromBatch() reports the segment boundaries.
+    OPT_REUSEPORT,  // Whether several sockets may bind the same address and
+                    // port, with the kernel spreading packets between them.
+                    // Must be set before Bind().
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
@@ -75,6 +75,14 @@ std::unique_ptr<SSLCertificate> SSLCertificate::GetUniqueReference() const {
   return WrapUnique(GetReference());
 }
 
+bool SSLCertificate::Equals(const SSLCertificate& other) const {
+  Buffer der_buffer;
+  ToDER(&der_buffer);
+  Buffer other_der_buffer;
+  other.ToDER(&other_der_buffer);
+  return der_buffer == other_der_buffer;
+}
+
 //////////////////////////////////////////////////////////////////////
 // SSLCertChain
 //////////////////////////////////////////////////////////////////////
@@ -116,6 +124,16 @@ std::unique_ptr<SSLCertChain> SSLCertChain::UniqueCopy() const {
   return WrapUnique(Copy());
 }
 
+bool SSLCertChain::Equals(const SSLCertChain& other) const {
+  if (certs_.size() != other.certs_.size())
+    return false;
+  for (size_t i = 0; i < certs_.size(); ++i) {
+    if (!certs_[i]->Equals(*other.certs_[i]))
+      return false;
+  }
+  return true;
+}
+
 std::unique_ptr<SSLCertificateStats> SSLCertChain::GetStats() const {
   // We have a linked list of certificates, starting with the first element of
   // |certs_| and ending with the last element of |certs_|. The "issuer" of a
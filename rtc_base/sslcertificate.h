@@ -86,6 +86,11 @@ class SSLCertificate {
   // or -1 if an expiration time could not be retrieved.
   virtual int64_t CertificateExpirationTime() const = 0;
 
+  // Returns true if |other| holds the same certificate. The default compares
+  // the DER encodings; implementations override it when they can tell without
+  // encoding. |other| must come from the same SSL library.
+  virtual bool Equals(const SSLCertificate& other) const;
+
   // Gets information (fingerprint, etc.) about this certificate. This is used
   // for certificate stats, see
   // https://w3c.github.io/webrtc-stats/#certificatestats-dict*.
@@ -120,6 +125,9 @@ class SSLCertChain {
   // Same as above, but returning a unique_ptr for convenience.
   std::unique_ptr<SSLCertChain> UniqueCopy() const;
 
+  // Returns true if both chains hold the same certificates in the same order.
+  bool Equals(const SSLCertChain& other) const;
+
   // Gets information (fingerprint, etc.) about this certificate chain. This is
   // used for certificate stats, see
   // https://w3c.github.io/webrtc-stats/#certificatestats-dict*.
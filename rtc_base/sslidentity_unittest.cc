@@ -481,6 +481,34 @@ TEST_F(SSLIdentityTest, SSLCertificateGetStatsWithChain) {
   }
 }
 
+TEST_F(SSLIdentityTest, SSLCertChainEquals) {
+  const rtc::SSLCertificate& rsa = identity_rsa1_->certificate();
+  const rtc::SSLCertificate& ecdsa = identity_ecdsa1_->certificate();
+  auto make_chain = [](const rtc::SSLCertificate& first,
+                       const rtc::SSLCertificate& second) {
+    std::vector<std::unique_ptr<rtc::SSLCertificate>> certs;
+    certs.push_back(first.GetUniqueReference());
+    certs.push_back(second.GetUniqueReference());
+    return rtc::SSLCertChain(std::move(certs));
+  };
+  rtc::SSLCertChain chain = make_chain(rsa, ecdsa);
+  // Copies share the underlying certificates.
+  EXPECT_TRUE(chain.Equals(*chain.UniqueCopy()));
+
+  // Certificates parsed separately are equal too.
+  std::unique_ptr<rtc::SSLCertificate> parsed(
+      rtc::SSLCertificate::FromPEMString(rsa.ToPEMString()));
+  ASSERT_TRUE(parsed);
+  EXPECT_TRUE(rsa.Equals(*parsed));
+  EXPECT_FALSE(identity_rsa2_->certificate().Equals(*parsed));
+  EXPECT_TRUE(chain.Equals(make_chain(*parsed, ecdsa)));
+
+  EXPECT_FALSE(chain.Equals(make_chain(ecdsa, rsa)));
+  rtc::SSLCertChain shorter(&rsa);
+  EXPECT_FALSE(chain.Equals(shorter));
+  EXPECT_FALSE(shorter.Equals(chain));
+}
+
 class SSLIdentityExpirationTest : public testing::Test {
  public:
   SSLIdentityExpirationTest() {
@@ -13,11 +13,15 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <string.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
+#include <atomic>
+#include <limits>
 #include <list>
 
 #include "base/third_party/libevent/event.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/constructormagic.h"
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -34,9 +38,12 @@ using internal::AutoSetCurrentQueuePtr;
 
 namespace {
 static const char kQuit = 1;
-static const char kRunTask = 2;
 static const char kRunReplyTask = 3;
 
+// Upper bound on the number of posted tasks run per wakeup, so that a steady
+// stream of posts can't starve timers and reply tasks.
+static const int kMaxTasksPerWakeup = 64;
+
 using Priority = TaskQueue::Priority;
 
 // This ignores the SIGPIPE signal on the calling thread.
@@ -94,6 +101,57 @@ void EventAssign(struct event* ev,
 #endif
 }
 
+// Lock-free multi-producer, single-consumer queue of tasks (the intrusive
+// queue by Dmitry Vyukov). Push() may be called on any thread, Pop() only on
+// the thread that owns the queue. The queue always holds a stub node whose
+// task has already been taken; |head_| points at it.
+class PendingTaskQueue {
+ public:
+  PendingTaskQueue() : head_(new Node()), tail_(head_) {}
+  ~PendingTaskQueue() {
+    while (head_) {
+      Node* next = head_->next.load(std::memory_order_relaxed);
+      delete head_;
+      head_ = next;
+    }
+  }
+
+  void Push(std::unique_ptr<QueuedTask> task) {
+    Node* node = new Node();
+    node->task = std::move(task);
+    Node* prev = tail_.exchange(node, std::memory_order_acq_rel);
+    // Between the exchange and this store the node is not yet reachable from
+    // |head_|; Pop() treats that window like an empty queue.
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  // Returns null if the queue is empty or a Push() is still in progress; in
+  // the latter case IsEmpty() returns false.
+  std::unique_ptr<QueuedTask> Pop() {
+    Node* next = head_->next.load(std::memory_order_acquire);
+    if (!next)
+      return nullptr;
+    delete head_;
+    head_ = next;
+    return std::move(next->task);
+  }
+
+  bool IsEmpty() const {
+    return head_ == tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  Node* head_;
+  std::atomic<Node*> tail_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PendingTaskQueue);
+};
+
 ThreadPriority TaskQueuePriorityToThreadPriority(Priority priority) {
   switch (priority) {
     case Priority::HIGH:
@@ -133,6 +191,7 @@ class TaskQueue::Impl : public RefCountInterface {
  private:
   static void ThreadMain(void* context);
   static void OnWakeup(int socket, short flags, void* context);  // NOLINT
+  static void OnTasksPosted(int fd, short flags, void* context);  // NOLINT
   static void RunTask(int fd, short flags, void* context);       // NOLINT
   static void RunTimer(int fd, short flags, void* context);      // NOLINT
 
@@ -144,15 +203,27 @@ class TaskQueue::Impl : public RefCountInterface {
 
   void PrepareReplyTask(scoped_refptr<ReplyTaskOwnerRef> reply_task);
 
+  // Signals |tasks_posted_fd_| unless a signal is already pending.
+  void WakeUpForPendingTasks();
+  // Runs up to |max_tasks| tasks from |pending_|.
+  void RunPendingTasks(int max_tasks);
+
   struct QueueContext;
   TaskQueue* const queue_;
   int wakeup_pipe_in_ = -1;
   int wakeup_pipe_out_ = -1;
   event_base* event_base_;
   std::unique_ptr<event> wakeup_event_;
+  // Tasks posted from other threads go to |pending_|. Posts are coalesced
+  // into one write to the |tasks_posted_fd_| eventfd per wakeup of the queue:
+  // |wakeup_pending_| is set by the first post after the queue thread last
+  // looked at |pending_|.
+  int tasks_posted_fd_ = -1;
+  std::unique_ptr<event> tasks_posted_event_;
+  std::atomic<bool> wakeup_pending_{false};
+  PendingTaskQueue pending_;
   PlatformThread thread_;
   rtc::CriticalSection pending_lock_;
-  std::list<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(pending_lock_);
   std::list<scoped_refptr<ReplyTaskOwnerRef>> pending_replies_
       RTC_GUARDED_BY(pending_lock_);
 };
@@ -278,6 +349,7 @@ TaskQueue::Impl::Impl(const char* queue_name,
     : queue_(queue),
       event_base_(event_base_new()),
       wakeup_event_(new event()),
+      tasks_posted_event_(new event()),
       thread_(&TaskQueue::Impl::ThreadMain,
               this,
               queue_name,
@@ -293,6 +365,12 @@ TaskQueue::Impl::Impl(const char* queue_name,
   EventAssign(wakeup_event_.get(), event_base_, wakeup_pipe_out_,
               EV_READ | EV_PERSIST, OnWakeup, this);
   event_add(wakeup_event_.get(), 0);
+
+  tasks_posted_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  RTC_CHECK(tasks_posted_fd_ != -1);
+  EventAssign(tasks_posted_event_.get(), event_base_, tasks_posted_fd_,
+              EV_READ | EV_PERSIST, OnTasksPosted, this);
+  event_add(tasks_posted_event_.get(), 0);
   thread_.Start();
 }
 
@@ -311,9 +389,13 @@ TaskQueue::Impl::~Impl() {
   thread_.Stop();
 
   event_del(wakeup_event_.get());
+  event_del(tasks_posted_event_.get());
 
   IgnoreSigPipeSignalOnCurrentThread();
 
+  close(tasks_posted_fd_);
+  tasks_posted_fd_ = -1;
+
   close(wakeup_pipe_in_);
   close(wakeup_pipe_out_);
   wakeup_pipe_in_ = -1;
@@ -353,19 +435,30 @@ void TaskQueue::Impl::PostTask(std::unique_ptr<QueuedTask> task) {
       task.release();
     }
   } else {
-    QueuedTask* task_id = task.get();  // Only used for comparison.
-    {
-      CritScope lock(&pending_lock_);
-      pending_.push_back(std::move(task));
-    }
-    char message = kRunTask;
-    if (write(wakeup_pipe_in_, &message, sizeof(message)) != sizeof(message)) {
-      RTC_LOG(WARNING) << "Failed to queue task.";
-      CritScope lock(&pending_lock_);
-      pending_.remove_if([task_id](std::unique_ptr<QueuedTask>& t) {
-        return t.get() == task_id;
-      });
-    }
+    pending_.Push(std::move(task));
+    WakeUpForPendingTasks();
+  }
+}
+
+void TaskQueue::Impl::WakeUpForPendingTasks() {
+  // The exchange orders this call after the push of the task, so either the
+  // queue thread sees the task when it next drains |pending_|, or it has
+  // already cleared |wakeup_pending_| and we signal it again.
+  if (wakeup_pending_.exchange(true, std::memory_order_acq_rel))
+    return;
+  const uint64_t count = 1;
+  if (write(tasks_posted_fd_, &count, sizeof(count)) != sizeof(count))
+    RTC_LOG(WARNING) << "Failed to signal posted task.";
+}
+
+void TaskQueue::Impl::RunPendingTasks(int max_tasks) {
+  RTC_DCHECK(IsCurrent());
+  for (int i = 0; i < max_tasks; ++i) {
+    std::unique_ptr<QueuedTask> task = pending_.Pop();
+    if (!task)
+      return;
+    if (!task->Run())
+      task.release();
   }
 }
 
@@ -423,22 +516,12 @@ void TaskQueue::Impl::OnWakeup(int socket,
   RTC_CHECK(sizeof(buf) == read(socket, &buf, sizeof(buf)));
   switch (buf) {
     case kQuit:
+      // Tasks posted before the queue was deleted still get to run, as they
+      // would if they had been written to the pipe ahead of kQuit.
+      ctx->queue->RunPendingTasks(std::numeric_limits<int>::max());
       ctx->is_active = false;
       event_base_loopbreak(ctx->queue->event_base_);
       break;
-    case kRunTask: {
-      std::unique_ptr<QueuedTask> task;
-      {
-        CritScope lock(&ctx->queue->pending_lock_);
-        RTC_DCHECK(!ctx->queue->pending_.empty());
-        task = std::move(ctx->queue->pending_.front());
-        ctx->queue->pending_.pop_front();
-        RTC_DCHECK(task.get());
-      }
-      if (!task->Run())
-        task.release();
-      break;
-    }
     case kRunReplyTask: {
       scoped_refptr<ReplyTaskOwnerRef> reply_task;
       {
@@ -461,6 +544,22 @@ void TaskQueue::Impl::OnWakeup(int socket,
   }
 }
 
+// static
+void TaskQueue::Impl::OnTasksPosted(int fd,
+                                    short flags,
+                                    void* context) {  // NOLINT
+  TaskQueue::Impl* me = static_cast<TaskQueue::Impl*>(context);
+  RTC_DCHECK(me->tasks_posted_fd_ == fd);
+  uint64_t count;
+  RTC_CHECK(sizeof(count) == read(fd, &count, sizeof(count)));
+  me->wakeup_pending_.exchange(false, std::memory_order_acq_rel);
+  me->RunPendingTasks(kMaxTasksPerWakeup);
+  // Come back for the rest after giving other events a chance to run. This
+  // also covers a post that was still in progress and so not yet visible.
+  if (!me->pending_.IsEmpty())
+    me->WakeUpForPendingTasks();
+}
+
 // static
 void TaskQueue::Impl::RunTask(int fd, short flags, void* context) {  // NOLINT
   auto* task = static_cast<QueuedTask*>(context);
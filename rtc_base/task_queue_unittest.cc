@@ -15,12 +15,15 @@
 // clang-format on
 #endif
 
+#include <stdio.h>
+
 #include <memory>
 #include <vector>
 
 #include "rtc_base/bind.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/task_queue_for_test.h"
 #include "rtc_base/timeutils.h"
 
@@ -423,4 +426,149 @@ TEST(TaskQueueTest, PostALot) {
   EXPECT_EQ(kTaskCount, tasks_cleaned_up);
 }
 
+namespace {
+
+// Posts |num_tasks| tasks to |queue| once |start| is signaled.
+struct PostingThread {
+  static void Run(void* obj) {
+    PostingThread* me = static_cast<PostingThread*>(obj);
+    me->start->Wait(Event::kForever);
+    for (int i = 0; i < me->num_tasks; ++i) {
+      int64_t posted_ns = TimeNanos();
+      me->queue->PostTask([me, posted_ns]() {
+        me->total_delay_ns += TimeNanos() - posted_ns;
+        if (++*me->tasks_run == me->tasks_expected)
+          me->done->Set();
+      });
+    }
+  }
+
+  TaskQueue* queue;
+  Event* start;
+  Event* done;
+  int num_tasks;
+  // Only touched on |queue|.
+  int* tasks_run;
+  int tasks_expected;
+  int64_t total_delay_ns = 0;
+};
+
+void MeasurePostThroughput(int num_producers) {
+  constexpr int kTasksPerProducer = 200000;
+  TaskQueue queue("PostThroughput");
+  Event start(true, false);
+  Event done(false, false);
+  int tasks_run = 0;
+  std::vector<PostingThread> producers(num_producers);
+  std::vector<std::unique_ptr<PlatformThread>> threads;
+  for (PostingThread& producer : producers) {
+    producer.queue = &queue;
+    producer.start = &start;
+    producer.done = &done;
+    producer.num_tasks = kTasksPerProducer;
+    producer.tasks_run = &tasks_run;
+    producer.tasks_expected = num_producers * kTasksPerProducer;
+    threads.emplace_back(
+        new PlatformThread(&PostingThread::Run, &producer, "Producer"));
+    threads.back()->Start();
+  }
+  int64_t start_ns = TimeNanos();
+  start.Set();
+  EXPECT_TRUE(done.Wait(Event::kForever));
+  int64_t elapsed_ns = TimeNanos() - start_ns;
+  for (auto& thread : threads)
+    thread->Stop();
+
+  int64_t total_delay_ns = 0;
+  for (const PostingThread& producer : producers)
+    total_delay_ns += producer.total_delay_ns;
+  const int total_tasks = num_producers * kTasksPerProducer;
+  printf("%2d producers: %.0f posts/s, %.1f us mean post-to-run delay\n",
+         num_producers, total_tasks * 1e9 / elapsed_ns,
+         total_delay_ns / 1e3 / total_tasks);
+}
+
+}  // namespace
+
+// Tests that tasks posted by several threads at once all run, also when far
+// more are pending than the queue runs per wakeup, and that the queue still
+// wakes up for tasks posted after the burst.
+TEST(TaskQueueTest, PostFromManyThreads) {
+  constexpr int kNumProducers = 8;
+  constexpr int kTasksPerProducer = 1000;
+  TaskQueue queue("PostFromManyThreads");
+  Event start(true, false);
+  Event done(false, false);
+  int tasks_run = 0;
+  std::vector<PostingThread> producers(kNumProducers);
+  std::vector<std::unique_ptr<PlatformThread>> threads;
+  for (PostingThread& producer : producers) {
+    producer.queue = &queue;
+    producer.start = &start;
+    producer.done = &done;
+    producer.num_tasks = kTasksPerProducer;
+    producer.tasks_run = &tasks_run;
+    producer.tasks_expected = kNumProducers * kTasksPerProducer;
+    threads.emplace_back(
+        new PlatformThread(&PostingThread::Run, &producer, "Producer"));
+    threads.back()->Start();
+  }
+  // Keep the queue busy while the producers post, so that the tasks pile up.
+  Event blocker(false, false);
+  queue.PostTask([&start, &blocker]() {
+    start.Set();
+    blocker.Wait(50);
+  });
+  EXPECT_TRUE(done.Wait(10000));
+  for (auto& thread : threads)
+    thread->Stop();
+  EXPECT_EQ(kNumProducers * kTasksPerProducer, tasks_run);
+
+  queue.PostTask([&done]() { done.Set(); });
+  EXPECT_TRUE(done.Wait(1000));
+}
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+// Tests that the tasks still pending when the queue is deleted run before its
+// thread exits. Only the libevent queue, used on Linux and Android, does so.
+TEST(TaskQueueTest, PendingTasksRunOnDestruction) {
+  constexpr int kTaskCount = 1000;
+  int tasks_executed = 0;
+  Event blocker(false, false);
+  {
+    TaskQueue queue("PendingTasksRunOnDestruction");
+    // Block the queue so that the tasks below are still pending when it is
+    // told to quit.
+    queue.PostTask([&blocker]() { blocker.Wait(50); });
+    for (int i = 0; i < kTaskCount; ++i)
+      queue.PostTask([&tasks_executed]() { ++tasks_executed; });
+  }
+  EXPECT_EQ(kTaskCount, tasks_executed);
+}
+#endif
+
+// Measures PostTask() throughput and the delay until a posted task runs, with
+// several threads posting to the same queue. Run manually.
+TEST(TaskQueueTest, DISABLED_PostThroughput) {
+  for (int num_producers : {1, 4, 16})
+    MeasurePostThroughput(num_producers);
+}
+
+// Measures the delay from posting a task to an idle queue until it runs.
+TEST(TaskQueueTest, DISABLED_WakeupLatency) {
+  constexpr int kNumTasks = 10000;
+  TaskQueue queue("WakeupLatency");
+  Event event(false, false);
+  int64_t total_delay_ns = 0;
+  for (int i = 0; i < kNumTasks; ++i) {
+    int64_t posted_ns = TimeNanos();
+    queue.PostTask([&event, &total_delay_ns, posted_ns]() {
+      total_delay_ns += TimeNanos() - posted_ns;
+      event.Set();
+    });
+    EXPECT_TRUE(event.Wait(Event::kForever));
+  }
+  printf("Wakeup latency: %.1f us\n", total_delay_ns / 1e3 / kNumTasks);
+}
+
 }  // namespace rtc
@@ -110,6 +110,34 @@ void RTCStatsReport::TakeMembersFrom(
   victim->stats_.clear();
 }
 
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::DeltaSince(
+    const RTCStatsReport& previous,
+    std::vector<std::string>* removed_ids) const {
+  RTC_DCHECK(removed_ids);
+  rtc::scoped_refptr<RTCStatsReport> delta = Create(timestamp_us_);
+  // Both maps are ordered by id, so they can be walked side by side.
+  StatsMap::const_iterator it = stats_.begin();
+  StatsMap::const_iterator previous_it = previous.stats_.begin();
+  while (it != stats_.end() || previous_it != previous.stats_.end()) {
+    if (it == stats_.end() ||
+        (previous_it != previous.stats_.end() &&
+         previous_it->first < it->first)) {
+      removed_ids->push_back(previous_it->first);
+      ++previous_it;
+    } else if (previous_it == previous.stats_.end() ||
+               it->first < previous_it->first) {
+      delta->AddStats(it->second->copy());
+      ++it;
+    } else {
+      if (*it->second != *previous_it->second)
+        delta->AddStats(it->second->copy());
+      ++it;
+      ++previous_it;
+    }
+  }
+  return delta;
+}
+
 RTCStatsReport::ConstIterator RTCStatsReport::begin() const {
   return ConstIterator(rtc::scoped_refptr<const RTCStatsReport>(this),
                        stats_.cbegin());
@@ -145,4 +145,61 @@ TEST(RTCStatsReport, TakeMembersFrom) {
   EXPECT_EQ(i, static_cast<int64_t>(6));
 }
 
+TEST(RTCStatsReport, DeltaSince) {
+  rtc::scoped_refptr<RTCStatsReport> previous = RTCStatsReport::Create(1);
+  std::unique_ptr<RTCTestStats1> a(new RTCTestStats1("A", 1));
+  a->integer = 1;
+  previous->AddStats(std::move(a));
+  std::unique_ptr<RTCTestStats1> b(new RTCTestStats1("B", 1));
+  b->integer = 2;
+  previous->AddStats(std::move(b));
+  std::unique_ptr<RTCTestStats2> c(new RTCTestStats2("C", 1));
+  c->number = 3.0;
+  previous->AddStats(std::move(c));
+  previous->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats1("E", 1)));
+
+  rtc::scoped_refptr<RTCStatsReport> current = RTCStatsReport::Create(2);
+  // "A" is unchanged apart from its timestamp.
+  a.reset(new RTCTestStats1("A", 2));
+  a->integer = 1;
+  current->AddStats(std::move(a));
+  // "B" has changed.
+  b.reset(new RTCTestStats1("B", 2));
+  b->integer = 20;
+  current->AddStats(std::move(b));
+  // "C" has been removed and "D" added.
+  current->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats3("D", 2)));
+  // "E" is unchanged.
+  current->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats1("E", 2)));
+  // "F" has been added.
+  current->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats2("F", 2)));
+
+  std::vector<std::string> removed_ids;
+  rtc::scoped_refptr<RTCStatsReport> delta =
+      current->DeltaSince(*previous, &removed_ids);
+  EXPECT_EQ(delta->timestamp_us(), 2);
+  EXPECT_EQ(delta->size(), static_cast<size_t>(3));
+  ASSERT_TRUE(delta->Get("B"));
+  EXPECT_EQ(*delta->Get("B")->cast_to<RTCTestStats1>().integer, 20);
+  EXPECT_TRUE(delta->Get("D"));
+  EXPECT_TRUE(delta->Get("F"));
+  EXPECT_EQ(removed_ids, std::vector<std::string>({"C"}));
+
+  // Nothing changes since the report itself, and everything since an empty
+  // report.
+  removed_ids.clear();
+  EXPECT_EQ(current->DeltaSince(*current, &removed_ids)->size(),
+            static_cast<size_t>(0));
+  EXPECT_TRUE(removed_ids.empty());
+  EXPECT_EQ(current->DeltaSince(*RTCStatsReport::Create(0), &removed_ids)
+                ->size(),
+            current->size());
+  EXPECT_TRUE(removed_ids.empty());
+  EXPECT_EQ(RTCStatsReport::Create(3)->DeltaSince(*current, &removed_ids)
+                ->size(),
+            static_cast<size_t>(0));
+  EXPECT_EQ(removed_ids,
+            std::vector<std::string>({"A", "B", "D", "E", "F"}));
+}
+
 }  // namespace webrtc
@@ -0,0 +1,629 @@
+/*
+ *  Copyright 2018 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtcstatsreportbinary.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+const uint8_t kFormatVersion = 2;
+const size_t kDefaultMaxStringTableSize = 64 * 1024;
+// The longest LEB128 encoding of a 64 bit integer.
+const size_t kMaxVarintSize = 10;
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// A stats object of whichever type was decoded, owning its members.
+class RTCDecodedStats : public RTCStats {
+ public:
+  RTCDecodedStats(const std::string& id,
+                  int64_t timestamp_us,
+                  const char* type,
+                  std::shared_ptr<const std::deque<std::string>> strings)
+      : RTCStats(id, timestamp_us),
+        type_(type),
+        strings_(std::move(strings)) {}
+
+  std::unique_ptr<RTCStats> copy() const override {
+    std::unique_ptr<RTCDecodedStats> copy(
+        new RTCDecodedStats(id_, timestamp_us_, type_, strings_));
+    for (const auto& member : members_)
+      copy->AddMember(CopyMember(*member));
+    return std::move(copy);
+  }
+
+  const char* type() const override { return type_; }
+
+  void AddMember(std::unique_ptr<RTCStatsMemberInterface> member) {
+    members_.push_back(std::move(member));
+  }
+
+ protected:
+  std::vector<const RTCStatsMemberInterface*> MembersOfThisObjectAndAncestors(
+      size_t additional_capacity) const override {
+    std::vector<const RTCStatsMemberInterface*> members =
+        RTCStats::MembersOfThisObjectAndAncestors(members_.size() +
+                                                  additional_capacity);
+    for (const auto& member : members_)
+      members.push_back(member.get());
+    return members;
+  }
+
+ private:
+  template <typename T>
+  static std::unique_ptr<RTCStatsMemberInterface> CopyMemberOfType(
+      const RTCStatsMemberInterface& member) {
+    return std::unique_ptr<RTCStatsMemberInterface>(
+        new RTCStatsMember<T>(member.cast_to<RTCStatsMember<T>>()));
+  }
+
+  static std::unique_ptr<RTCStatsMemberInterface> CopyMember(
+      const RTCStatsMemberInterface& member) {
+    switch (member.type()) {
+      case RTCStatsMemberInterface::kBool:
+        return CopyMemberOfType<bool>(member);
+      case RTCStatsMemberInterface::kInt32:
+        return CopyMemberOfType<int32_t>(member);
+      case RTCStatsMemberInterface::kUint32:
+        return CopyMemberOfType<uint32_t>(member);
+      case RTCStatsMemberInterface::kInt64:
+        return CopyMemberOfType<int64_t>(member);
+      case RTCStatsMemberInterface::kUint64:
+        return CopyMemberOfType<uint64_t>(member);
+      case RTCStatsMemberInterface::kDouble:
+        return CopyMemberOfType<double>(member);
+      case RTCStatsMemberInterface::kString:
+        return CopyMemberOfType<std::string>(member);
+      case RTCStatsMemberInterface::kSequenceBool:
+        return CopyMemberOfType<std::vector<bool>>(member);
+      case RTCStatsMemberInterface::kSequenceInt32:
+        return CopyMemberOfType<std::vector<int32_t>>(member);
+      case RTCStatsMemberInterface::kSequenceUint32:
+        return CopyMemberOfType<std::vector<uint32_t>>(member);
+      case RTCStatsMemberInterface::kSequenceInt64:
+        return CopyMemberOfType<std::vector<int64_t>>(member);
+      case RTCStatsMemberInterface::kSequenceUint64:
+        return CopyMemberOfType<std::vector<uint64_t>>(member);
+      case RTCStatsMemberInterface::kSequenceDouble:
+        return CopyMemberOfType<std::vector<double>>(member);
+      case RTCStatsMemberInterface::kSequenceString:
+        return CopyMemberOfType<std::vector<std::string>>(member);
+    }
+    RTC_NOTREACHED();
+    return nullptr;
+  }
+
+  const char* const type_;
+  // Keeps |type_| and the member names alive.
+  const std::shared_ptr<const std::deque<std::string>> strings_;
+  std::vector<std::unique_ptr<RTCStatsMemberInterface>> members_;
+};
+
+}  // namespace
+
+RTCStatsReportWriter::RTCStatsReportWriter(Output* output)
+    : RTCStatsReportWriter(output, kDefaultMaxStringTableSize) {}
+
+RTCStatsReportWriter::RTCStatsReportWriter(Output* output,
+                                           size_t max_string_table_size)
+    : output_(output), max_string_table_size_(max_string_table_size) {
+  RTC_DCHECK(output_);
+  WriteByte(kFormatVersion);
+}
+
+RTCStatsReportWriter::~RTCStatsReportWriter() {
+  Flush();
+}
+
+void RTCStatsReportWriter::WriteReport(const RTCStatsReport& report) {
+  if (string_table_size_ > max_string_table_size_)
+    ClearStringTable();
+  WriteVarint(report.size() + 1);
+  WriteSignedVarint(report.timestamp_us());
+  for (const RTCStats& stats : report)
+    WriteStats(stats, report.timestamp_us());
+}
+
+void RTCStatsReportWriter::Flush() {
+  if (buffer_size_ == 0)
+    return;
+  output_->Write(rtc::ArrayView<const uint8_t>(buffer_, buffer_size_));
+  bytes_flushed_ += buffer_size_;
+  buffer_size_ = 0;
+}
+
+void RTCStatsReportWriter::ClearStringTable() {
+  WriteVarint(0);
+  static_string_indices_.clear();
+  id_string_indices_.clear();
+  num_strings_ = 0;
+  string_table_size_ = 0;
+}
+
+void RTCStatsReportWriter::WriteStats(const RTCStats& stats,
+                                      int64_t report_timestamp_us) {
+  WriteIdString(stats.id());
+  WriteStaticString(stats.type());
+  WriteSignedVarint(stats.timestamp_us() - report_timestamp_us);
+  std::vector<const RTCStatsMemberInterface*> members = stats.Members();
+  uint64_t num_defined_members = 0;
+  for (const RTCStatsMemberInterface* member : members) {
+    if (member->is_defined())
+      ++num_defined_members;
+  }
+  WriteVarint(num_defined_members);
+  for (const RTCStatsMemberInterface* member : members) {
+    if (member->is_defined())
+      WriteMember(*member);
+  }
+}
+
+void RTCStatsReportWriter::WriteMember(const RTCStatsMemberInterface& member) {
+  WriteStaticString(member.name());
+  WriteByte(static_cast<uint8_t>(member.type()));
+  switch (member.type()) {
+    case RTCStatsMemberInterface::kBool:
+      WriteByte(*member.cast_to<RTCStatsMember<bool>>() ? 1 : 0);
+      break;
+    case RTCStatsMemberInterface::kInt32:
+      WriteSignedVarint(*member.cast_to<RTCStatsMember<int32_t>>());
+      break;
+    case RTCStatsMemberInterface::kUint32:
+      WriteVarint(*member.cast_to<RTCStatsMember<uint32_t>>());
+      break;
+    case RTCStatsMemberInterface::kInt64:
+      WriteSignedVarint(*member.cast_to<RTCStatsMember<int64_t>>());
+      break;
+    case RTCStatsMemberInterface::kUint64:
+      WriteVarint(*member.cast_to<RTCStatsMember<uint64_t>>());
+      break;
+    case RTCStatsMemberInterface::kDouble:
+      WriteDouble(*member.cast_to<RTCStatsMember<double>>());
+      break;
+    case RTCStatsMemberInterface::kString: {
+      const std::string& value = *member.cast_to<RTCStatsMember<std::string>>();
+      WriteString(value.data(), value.size());
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceBool: {
+      const std::vector<bool>& values =
+          *member.cast_to<RTCStatsMember<std::vector<bool>>>();
+      WriteVarint(values.size());
+      for (bool value : values)
+        WriteByte(value ? 1 : 0);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceInt32: {
+      const std::vector<int32_t>& values =
+          *member.cast_to<RTCStatsMember<std::vector<int32_t>>>();
+      WriteVarint(values.size());
+      for (int32_t value : values)
+        WriteSignedVarint(value);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceUint32: {
+      const std::vector<uint32_t>& values =
+          *member.cast_to<RTCStatsMember<std::vector<uint32_t>>>();
+      WriteVarint(values.size());
+      for (uint32_t value : values)
+        WriteVarint(value);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceInt64: {
+      const std::vector<int64_t>& values =
+          *member.cast_to<RTCStatsMember<std::vector<int64_t>>>();
+      WriteVarint(values.size());
+      for (int64_t value : values)
+        WriteSignedVarint(value);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceUint64: {
+      const std::vector<uint64_t>& values =
+          *member.cast_to<RTCStatsMember<std::vector<uint64_t>>>();
+      WriteVarint(values.size());
+      for (uint64_t value : values)
+        WriteVarint(value);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceDouble: {
+      const std::vector<double>& values =
+          *member.cast_to<RTCStatsMember<std::vector<double>>>();
+      WriteVarint(values.size());
+      for (double value : values)
+        WriteDouble(value);
+      break;
+    }
+    case RTCStatsMemberInterface::kSequenceString: {
+      const std::vector<std::string>& values =
+          *member.cast_to<RTCStatsMember<std::vector<std::string>>>();
+      WriteVarint(values.size());
+      for (const std::string& value : values)
+        WriteString(value.data(), value.size());
+      break;
+    }
+  }
+}
+
+void RTCStatsReportWriter::WriteStaticString(const char* str) {
+  auto it = static_string_indices_.find(str);
+  if (it != static_string_indices_.end()) {
+    WriteVarint(it->second + 1);
+    return;
+  }
+  static_string_indices_.insert(std::make_pair(str, num_strings_));
+  WriteNewString(str, strlen(str));
+}
+
+void RTCStatsReportWriter::WriteIdString(const std::string& str) {
+  auto it = id_string_indices_.find(str);
+  if (it != id_string_indices_.end()) {
+    WriteVarint(it->second + 1);
+    return;
+  }
+  id_string_indices_.insert(std::make_pair(str, num_strings_));
+  WriteNewString(str.data(), str.size());
+}
+
+void RTCStatsReportWriter::WriteNewString(const char* data, size_t size) {
+  ++num_strings_;
+  string_table_size_ += size;
+  WriteVarint(0);
+  WriteString(data, size);
+}
+
+void RTCStatsReportWriter::WriteString(const char* data, size_t size) {
+  WriteVarint(size);
+  WriteBytes(reinterpret_cast<const uint8_t*>(data), size);
+}
+
+void RTCStatsReportWriter::WriteVarint(uint64_t value) {
+  if (kBufferSize - buffer_size_ < kMaxVarintSize)
+    Flush();
+  while (value >= 0x80) {
+    buffer_[buffer_size_++] = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  buffer_[buffer_size_++] = static_cast<uint8_t>(value);
+}
+
+void RTCStatsReportWriter::WriteSignedVarint(int64_t value) {
+  WriteVarint(ZigZagEncode(value));
+}
+
+void RTCStatsReportWriter::WriteDouble(double value) {
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(value), "");
+  memcpy(&bits, &value, sizeof(bits));
+  uint8_t bytes[sizeof(bits)];
+  for (size_t i = 0; i < sizeof(bytes); ++i)
+    bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+  WriteBytes(bytes, sizeof(bytes));
+}
+
+void RTCStatsReportWriter::WriteBytes(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    if (buffer_size_ == kBufferSize)
+      Flush();
+    size_t chunk_size = std::min(size, kBufferSize - buffer_size_);
+    memcpy(buffer_ + buffer_size_, data, chunk_size);
+    buffer_size_ += chunk_size;
+    data += chunk_size;
+    size -= chunk_size;
+  }
+}
+
+void RTCStatsReportWriter::WriteByte(uint8_t value) {
+  if (buffer_size_ == kBufferSize)
+    Flush();
+  buffer_[buffer_size_++] = value;
+}
+
+RTCStatsReportReader::RTCStatsReportReader(
+    rtc::ArrayView<const uint8_t> stream)
+    : stream_(stream), strings_(std::make_shared<std::deque<std::string>>()) {}
+
+RTCStatsReportReader::~RTCStatsReportReader() {}
+
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReportReader::ReadReport() {
+  if (!version_read_) {
+    uint8_t version;
+    if (!ReadByte(&version) || version != kFormatVersion)
+      return nullptr;
+    version_read_ = true;
+  }
+  uint64_t num_stats_plus_one;
+  if (!ReadVarint(&num_stats_plus_one))
+    return nullptr;
+  while (num_stats_plus_one == 0) {
+    // Stats decoded earlier keep the old strings alive.
+    strings_ = std::make_shared<std::deque<std::string>>();
+    if (!ReadVarint(&num_stats_plus_one))
+      return nullptr;
+  }
+  const uint64_t num_stats = num_stats_plus_one - 1;
+  int64_t timestamp_us;
+  if (!ReadSignedVarint(&timestamp_us))
+    return nullptr;
+  rtc::scoped_refptr<RTCStatsReport> report =
+      RTCStatsReport::Create(timestamp_us);
+  for (uint64_t i = 0; i < num_stats; ++i) {
+    std::unique_ptr<RTCStats> stats = ReadStats(timestamp_us);
+    if (!stats || report->Get(stats->id()))
+      return nullptr;
+    report->AddStats(std::move(stats));
+  }
+  return report;
+}
+
+std::unique_ptr<RTCStats> RTCStatsReportReader::ReadStats(
+    int64_t report_timestamp_us) {
+  const std::string* id;
+  const std::string* type;
+  int64_t timestamp_delta_us;
+  uint64_t num_members;
+  if (!ReadString(&id) || !ReadString(&type) ||
+      !ReadSignedVarint(&timestamp_delta_us) || !ReadVarint(&num_members)) {
+    return nullptr;
+  }
+  std::unique_ptr<RTCDecodedStats> stats(
+      new RTCDecodedStats(*id, report_timestamp_us + timestamp_delta_us,
+                          type->c_str(), strings_));
+  for (uint64_t i = 0; i < num_members; ++i) {
+    std::unique_ptr<RTCStatsMemberInterface> member = ReadMember();
+    if (!member)
+      return nullptr;
+    stats->AddMember(std::move(member));
+  }
+  return std::move(stats);
+}
+
+std::unique_ptr<RTCStatsMemberInterface> RTCStatsReportReader::ReadMember() {
+  const std::string* name_str;
+  uint8_t type;
+  if (!ReadString(&name_str) || !ReadByte(&type))
+    return nullptr;
+  const char* name = name_str->c_str();
+  switch (type) {
+    case RTCStatsMemberInterface::kBool: {
+      uint8_t value;
+      if (!ReadByte(&value) || value > 1)
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<bool>(name, value == 1));
+    }
+    case RTCStatsMemberInterface::kInt32: {
+      int64_t value;
+      if (!ReadSignedVarint(&value) || value != static_cast<int32_t>(value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<int32_t>(name, static_cast<int32_t>(value)));
+    }
+    case RTCStatsMemberInterface::kUint32: {
+      uint64_t value;
+      if (!ReadVarint(&value) || value != static_cast<uint32_t>(value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<uint32_t>(name, static_cast<uint32_t>(value)));
+    }
+    case RTCStatsMemberInterface::kInt64: {
+      int64_t value;
+      if (!ReadSignedVarint(&value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<int64_t>(name, value));
+    }
+    case RTCStatsMemberInterface::kUint64: {
+      uint64_t value;
+      if (!ReadVarint(&value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<uint64_t>(name, value));
+    }
+    case RTCStatsMemberInterface::kDouble: {
+      double value;
+      if (!ReadDouble(&value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<double>(name, value));
+    }
+    case RTCStatsMemberInterface::kString: {
+      std::string value;
+      if (!ReadStringValue(&value))
+        return nullptr;
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::string>(name, std::move(value)));
+    }
+    case RTCStatsMemberInterface::kSequenceBool: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<bool> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        uint8_t value;
+        if (!ReadByte(&value) || value > 1)
+          return nullptr;
+        values[i] = value == 1;
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<bool>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceInt32: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<int32_t> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        int64_t value;
+        if (!ReadSignedVarint(&value) || value != static_cast<int32_t>(value))
+          return nullptr;
+        values[i] = static_cast<int32_t>(value);
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<int32_t>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceUint32: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<uint32_t> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        uint64_t value;
+        if (!ReadVarint(&value) || value != static_cast<uint32_t>(value))
+          return nullptr;
+        values[i] = static_cast<uint32_t>(value);
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<uint32_t>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceInt64: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<int64_t> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadSignedVarint(&values[i]))
+          return nullptr;
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<int64_t>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceUint64: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<uint64_t> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadVarint(&values[i]))
+          return nullptr;
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<uint64_t>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceDouble: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<double> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadDouble(&values[i]))
+          return nullptr;
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<double>>(name, std::move(values)));
+    }
+    case RTCStatsMemberInterface::kSequenceString: {
+      size_t size;
+      if (!ReadSequenceSize(&size))
+        return nullptr;
+      std::vector<std::string> values(size);
+      for (size_t i = 0; i < size; ++i) {
+        if (!ReadStringValue(&values[i]))
+          return nullptr;
+      }
+      return std::unique_ptr<RTCStatsMemberInterface>(
+          new RTCStatsMember<std::vector<std::string>>(name,
+                                                       std::move(values)));
+    }
+  }
+  return nullptr;
+}
+
+bool RTCStatsReportReader::ReadString(const std::string** str) {
+  uint64_t index;
+  if (!ReadVarint(&index))
+    return false;
+  if (index == 0) {
+    std::string value;
+    if (!ReadStringValue(&value))
+      return false;
+    strings_->push_back(std::move(value));
+    *str = &strings_->back();
+    return true;
+  }
+  if (index > strings_->size())
+    return false;
+  *str = &(*strings_)[index - 1];
+  return true;
+}
+
+bool RTCStatsReportReader::ReadStringValue(std::string* str) {
+  uint64_t size;
+  if (!ReadVarint(&size) || size > stream_.size() - position_)
+    return false;
+  str->assign(reinterpret_cast<const char*>(stream_.data() + position_),
+              static_cast<size_t>(size));
+  position_ += static_cast<size_t>(size);
+  return true;
+}
+
+bool RTCStatsReportReader::ReadVarint(uint64_t* value) {
+  *value = 0;
+  for (size_t i = 0; i < kMaxVarintSize; ++i) {
+    uint8_t byte;
+    if (!ReadByte(&byte))
+      return false;
+    *value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+bool RTCStatsReportReader::ReadSignedVarint(int64_t* value) {
+  uint64_t encoded;
+  if (!ReadVarint(&encoded))
+    return false;
+  *value = ZigZagDecode(encoded);
+  return true;
+}
+
+bool RTCStatsReportReader::ReadDouble(double* value) {
+  if (stream_.size() - position_ < sizeof(*value))
+    return false;
+  uint64_t bits = 0;
+  for (size_t i = 0; i < sizeof(bits); ++i)
+    bits |= static_cast<uint64_t>(stream_[position_ + i]) << (8 * i);
+  position_ += sizeof(bits);
+  memcpy(value, &bits, sizeof(*value));
+  return true;
+}
+
+bool RTCStatsReportReader::ReadByte(uint8_t* value) {
+  if (position_ == stream_.size())
+    return false;
+  *value = stream_[position_++];
+  return true;
+}
+
+bool RTCStatsReportReader::ReadSequenceSize(size_t* size) {
+  uint64_t value;
+  // Every element takes at least one byte, which bounds the allocation.
+  if (!ReadVarint(&value) || value > stream_.size() - position_)
+    return false;
+  *size = static_cast<size_t>(value);
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,286 @@
+/*
+ *  Copyright 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/stats/rtcstatsreportbinary.h"
+
+#include <stdio.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "api/stats/rtcstats_objects.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/timeutils.h"
+#include "stats/test/rtcteststats.h"
+
+namespace webrtc {
+
+namespace {
+
+class VectorOutput : public RTCStatsReportWriter::Output {
+ public:
+  void Write(rtc::ArrayView<const uint8_t> data) override {
+    ++num_writes;
+    bytes.insert(bytes.end(), data.begin(), data.end());
+  }
+
+  std::vector<uint8_t> bytes;
+  int num_writes = 0;
+};
+
+class CountingOutput : public RTCStatsReportWriter::Output {
+ public:
+  void Write(rtc::ArrayView<const uint8_t> data) override {
+    size += data.size();
+  }
+
+  size_t size = 0;
+};
+
+std::unique_ptr<RTCTestStats> CreateTestStatsWithAllMembers(
+    const std::string& id,
+    int64_t timestamp_us) {
+  std::unique_ptr<RTCTestStats> stats(new RTCTestStats(id, timestamp_us));
+  stats->m_bool = true;
+  stats->m_int32 = std::numeric_limits<int32_t>::min();
+  stats->m_uint32 = std::numeric_limits<uint32_t>::max();
+  stats->m_int64 = std::numeric_limits<int64_t>::min();
+  stats->m_uint64 = std::numeric_limits<uint64_t>::max();
+  stats->m_double = 0.1;
+  stats->m_string = std::string("string \"with\" quotes");
+  stats->m_sequence_bool = std::vector<bool>({true, false, true});
+  stats->m_sequence_int32 = std::vector<int32_t>({-1, 0, 1, 1 << 30});
+  stats->m_sequence_uint32 = std::vector<uint32_t>({0, 127, 128});
+  stats->m_sequence_int64 =
+      std::vector<int64_t>({std::numeric_limits<int64_t>::max(), -64, 64});
+  stats->m_sequence_uint64 = std::vector<uint64_t>({1ull << 63, 0});
+  stats->m_sequence_double = std::vector<double>({-1.5, 1e300});
+  stats->m_sequence_string = std::vector<std::string>({"", "a", "bc"});
+  return stats;
+}
+
+std::vector<uint8_t> Encode(
+    const std::vector<rtc::scoped_refptr<RTCStatsReport>>& reports,
+    size_t max_string_table_size = 64 * 1024) {
+  VectorOutput output;
+  {
+    RTCStatsReportWriter writer(&output, max_string_table_size);
+    for (const auto& report : reports)
+      writer.WriteReport(*report);
+  }
+  return output.bytes;
+}
+
+}  // namespace
+
+TEST(RTCStatsReportBinaryTest, RoundTrip) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1337);
+  report->AddStats(CreateTestStatsWithAllMembers("all", 1337));
+  // Undefined members are left out, and the stats timestamp may differ from
+  // the report's.
+  report->AddStats(
+      std::unique_ptr<RTCStats>(new RTCTestStats("none", 1000)));
+  std::unique_ptr<RTCInboundRTPStreamStats> inbound(
+      new RTCInboundRTPStreamStats("inbound", 1337));
+  inbound->ssrc = 42;
+  inbound->media_type = "audio";
+  inbound->jitter = 0.25;
+  report->AddStats(std::move(inbound));
+
+  std::vector<uint8_t> bytes = Encode({report});
+  RTCStatsReportReader reader(bytes);
+  rtc::scoped_refptr<RTCStatsReport> decoded = reader.ReadReport();
+  ASSERT_TRUE(decoded);
+  EXPECT_TRUE(reader.at_end());
+  EXPECT_FALSE(reader.ReadReport());
+
+  EXPECT_EQ(decoded->timestamp_us(), report->timestamp_us());
+  EXPECT_EQ(decoded->size(), report->size());
+  EXPECT_EQ(decoded->ToJson(), report->ToJson());
+  EXPECT_EQ(decoded->Get("none")->timestamp_us(), 1000);
+  EXPECT_TRUE(decoded->Get("none")->Members().empty());
+  EXPECT_STREQ(decoded->Get("inbound")->type(),
+               RTCInboundRTPStreamStats::kType);
+
+  // The decoded stats can be copied and outlive the reader.
+  rtc::scoped_refptr<RTCStatsReport> copy = decoded->Copy();
+  decoded = nullptr;
+  EXPECT_EQ(copy->ToJson(), report->ToJson());
+}
+
+TEST(RTCStatsReportBinaryTest, StringsAreInternedAcrossReports) {
+  std::vector<rtc::scoped_refptr<RTCStatsReport>> reports;
+  for (int i = 0; i < 3; ++i) {
+    rtc::scoped_refptr<RTCStatsReport> report =
+        RTCStatsReport::Create(1000 * i);
+    report->AddStats(CreateTestStatsWithAllMembers("a", 1000 * i));
+    report->AddStats(CreateTestStatsWithAllMembers("b", 1000 * i));
+    reports.push_back(report);
+  }
+
+  std::vector<uint8_t> first_bytes = Encode({reports[0]});
+  std::vector<uint8_t> all_bytes = Encode(reports);
+  // Only the first report spells out the ids, type and member names. The
+  // member names alone take more than 100 bytes.
+  size_t later_report_size = (all_bytes.size() - first_bytes.size()) / 2;
+  EXPECT_LT(later_report_size + 100, first_bytes.size());
+
+  RTCStatsReportReader reader(all_bytes);
+  for (const auto& report : reports) {
+    rtc::scoped_refptr<RTCStatsReport> decoded = reader.ReadReport();
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoded->ToJson(), report->ToJson());
+  }
+  EXPECT_TRUE(reader.at_end());
+}
+
+TEST(RTCStatsReportBinaryTest, WritesInChunks) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(0);
+  for (int i = 0; i < 1000; ++i) {
+    report->AddStats(
+        CreateTestStatsWithAllMembers("stats" + std::to_string(i), 0));
+  }
+  VectorOutput output;
+  RTCStatsReportWriter writer(&output);
+  writer.WriteReport(*report);
+  EXPECT_GT(output.num_writes, 1);
+  EXPECT_LT(output.bytes.size(), writer.bytes_written());
+  writer.Flush();
+  EXPECT_EQ(output.bytes.size(), writer.bytes_written());
+
+  RTCStatsReportReader reader(output.bytes);
+  rtc::scoped_refptr<RTCStatsReport> decoded = reader.ReadReport();
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(decoded->ToJson(), report->ToJson());
+}
+
+TEST(RTCStatsReportBinaryTest, MalformedStreams) {
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(1);
+  report->AddStats(CreateTestStatsWithAllMembers("a", 1));
+  std::vector<uint8_t> bytes = Encode({report});
+
+  // Every truncation fails, without reading past the end.
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+    RTCStatsReportReader reader(truncated);
+    EXPECT_FALSE(reader.ReadReport()) << size;
+  }
+
+  // An unknown version.
+  std::vector<uint8_t> wrong_version = bytes;
+  wrong_version[0] = 0xff;
+  EXPECT_FALSE(RTCStatsReportReader(wrong_version).ReadReport());
+
+  // A reference to a string that hasn't been seen, in place of the id.
+  const uint8_t kBadReference[] = {2, 2, 0, 5};
+  EXPECT_FALSE(RTCStatsReportReader(kBadReference).ReadReport());
+
+  // Two stats objects with the same id: version, #stats, timestamp, then
+  // stats "a" of new type "t", and stats "a" (index 0) of type "t" (index 1).
+  const uint8_t kDuplicateId[] = {2, 3, 0, 0, 1, 'a', 0, 1, 't', 0, 0,
+                                  1, 2, 0, 0};
+  EXPECT_FALSE(RTCStatsReportReader(kDuplicateId).ReadReport());
+  const uint8_t kDistinctIds[] = {2, 3, 0, 0, 1, 'a', 0, 1, 't', 0, 0,
+                                  0, 1, 'b', 2, 0, 0};
+  rtc::scoped_refptr<RTCStatsReport> decoded =
+      RTCStatsReportReader(kDistinctIds).ReadReport();
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(decoded->size(), 2u);
+
+  // A reference to a string from before a clear record: a report with stats
+  // "a" of type "t", a clear record, then a report referring to both again.
+  const uint8_t kClearedReference[] = {2, 2, 0, 0, 1, 'a', 0, 1, 't', 0, 0,
+                                       0, 2, 0, 1, 2, 0, 0};
+  RTCStatsReportReader reader(kClearedReference);
+  EXPECT_TRUE(reader.ReadReport());
+  EXPECT_FALSE(reader.ReadReport());
+}
+
+TEST(RTCStatsReportBinaryTest, StringTableIsClearedPastSizeLimit) {
+  // Every report has a stats object with a new id, as when streams come and
+  // go, so the string table keeps growing unless cleared.
+  std::vector<rtc::scoped_refptr<RTCStatsReport>> reports;
+  for (int i = 0; i < 20; ++i) {
+    rtc::scoped_refptr<RTCStatsReport> report =
+        RTCStatsReport::Create(1000 * i);
+    report->AddStats(CreateTestStatsWithAllMembers("a", 1000 * i));
+    report->AddStats(CreateTestStatsWithAllMembers(
+        "RTCInboundRTPAudioStream_" + std::to_string(i), 1000 * i));
+    reports.push_back(report);
+  }
+
+  // The first report interns about 200 bytes of strings and every later one
+  // about 30 more, so the table is cleared every few reports, after which the
+  // type and member names are spelled out again.
+  std::vector<uint8_t> unlimited_bytes = Encode(reports);
+  std::vector<uint8_t> limited_bytes = Encode(reports, 300);
+  EXPECT_GT(limited_bytes.size(), unlimited_bytes.size() + 100);
+
+  // Reports decoded before a clear record stay valid after it.
+  RTCStatsReportReader reader(limited_bytes);
+  std::vector<rtc::scoped_refptr<RTCStatsReport>> decoded_reports;
+  for (size_t i = 0; i < reports.size(); ++i) {
+    decoded_reports.push_back(reader.ReadReport());
+    ASSERT_TRUE(decoded_reports.back());
+  }
+  EXPECT_TRUE(reader.at_end());
+  for (size_t i = 0; i < reports.size(); ++i)
+    EXPECT_EQ(decoded_reports[i]->ToJson(), reports[i]->ToJson());
+}
+
+// Compares the size and encoding time of a report of a large call with
+// |RTCStatsReport::ToJson|.
+TEST(RTCStatsReportBinaryTest, DISABLED_EncodePerformance) {
+  const int kNumStreams = 1000;
+  const int kNumIterations = 100;
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(0);
+  for (int i = 0; i < kNumStreams; ++i) {
+    std::unique_ptr<RTCInboundRTPStreamStats> inbound(
+        new RTCInboundRTPStreamStats(
+            "RTCInboundRTPAudioStream_" + std::to_string(i), 0));
+    inbound->ssrc = 1000 + i;
+    inbound->is_remote = false;
+    inbound->media_type = "audio";
+    inbound->track_id = "RTCMediaStreamTrack_receiver_" + std::to_string(i);
+    inbound->transport_id = "RTCTransport_audio_1";
+    inbound->codec_id = "RTCCodec_audio_Inbound_111";
+    inbound->packets_received = 50 * 3600 + i;
+    inbound->bytes_received = 50 * 3600 * 160 + i;
+    inbound->packets_lost = i % 10;
+    inbound->jitter = 0.002 * i;
+    inbound->fraction_lost = 0.001 * (i % 7);
+    report->AddStats(std::move(inbound));
+  }
+
+  size_t json_size = 0;
+  int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumIterations; ++i)
+    json_size = report->ToJson().size();
+  int64_t json_ns = (rtc::TimeNanos() - start_ns) / kNumIterations;
+
+  // The first report of a stream spells out all the strings, later ones refer
+  // to them.
+  CountingOutput output;
+  RTCStatsReportWriter writer(&output);
+  writer.WriteReport(*report);
+  size_t first_size = writer.bytes_written();
+  start_ns = rtc::TimeNanos();
+  for (int i = 0; i < kNumIterations; ++i)
+    writer.WriteReport(*report);
+  int64_t binary_ns = (rtc::TimeNanos() - start_ns) / kNumIterations;
+  size_t later_size = (writer.bytes_written() - first_size) / kNumIterations;
+
+  printf("ToJson: %zu bytes in %.1f us\n", json_size, json_ns / 1000.0);
+  printf("Binary: %zu bytes first, %zu bytes later, in %.1f us\n", first_size,
+         later_size, binary_ns / 1000.0);
+}
+
+}  // namespace webrtc
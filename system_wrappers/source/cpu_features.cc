@@ -26,7 +26,7 @@ int GetCPUInfoNoASM(CPUFeature feature) {
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #ifndef _MSC_VER
-// Intrinsic for "cpuid".
+// Intrinsic for "cpuid". Sub-leaf 0 is queried for leaves that have them.
 #if defined(__pic__) && defined(__i386__)
 static inline void __cpuid(int cpu_info[4], int info_type) {
   __asm__ volatile(
@@ -35,19 +35,41 @@ static inline void __cpuid(int cpu_info[4], int info_type) {
       "xchg %%edi, %%ebx\n"
       : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
         "=d"(cpu_info[3])
-      : "a"(info_type));
+      : "a"(info_type), "c"(0));
 }
 #else
 static inline void __cpuid(int cpu_info[4], int info_type) {
   __asm__ volatile("cpuid\n"
                    : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
                      "=d"(cpu_info[3])
-                   : "a"(info_type));
+                   : "a"(info_type), "c"(0));
 }
 #endif
 #endif  // _MSC_VER
 #endif  // WEBRTC_ARCH_X86_FAMILY
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Reads the extended control register |xcr|, telling which register states the
+// OS saves on context switches.
+static inline uint64_t xgetbv(int xcr) {
+#if defined(_MSC_VER)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+// AVX instructions can only be used if the CPU supports them and the OS saves
+// the YMM registers, which it signals through OSXSAVE and XCR0.
+static int AvxEnabled(const int cpu_info[4]) {
+  return (cpu_info[2] & 0x10000000) != 0 /* AVX */ &&
+         (cpu_info[2] & 0x08000000) != 0 /* OSXSAVE */ &&
+         (xgetbv(0) & 0x00000006) == 6 /* XMM and YMM state */;
+}
+#endif  // WEBRTC_ARCH_X86_FAMILY
+
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 // Actual feature detection for x86.
 static int GetCPUInfo(CPUFeature feature) {
@@ -59,6 +81,18 @@ static int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kAVX2) {
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 0);
+    if (cpu_info7[0] < 7) {
+      return 0;
+    }
+    __cpuid(cpu_info7, 7);
+    return AvxEnabled(cpu_info) && 0 != (cpu_info7[1] & 0x00000020);
+  }
+  if (feature == kFMA3) {
+    return AvxEnabled(cpu_info) && 0 != (cpu_info[2] & 0x00001000);
+  }
   return 0;
 }
 #else
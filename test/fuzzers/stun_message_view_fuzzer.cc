@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2018 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/socketaddress.h"
+
+namespace webrtc {
+void FuzzOneInput(const uint8_t* data, size_t size) {
+  const char* message = reinterpret_cast<const char*>(data);
+
+  cricket::StunMessageView view;
+  if (!view.Parse(message, size)) {
+    return;
+  }
+
+  // Attribute values must point into the message.
+  const int kTypes[] = {cricket::STUN_ATTR_USERNAME,
+                        cricket::STUN_ATTR_MAPPED_ADDRESS,
+                        cricket::STUN_ATTR_XOR_MAPPED_ADDRESS,
+                        cricket::STUN_ATTR_XOR_PEER_ADDRESS,
+                        cricket::STUN_ATTR_DATA,
+                        cricket::STUN_ATTR_PRIORITY,
+                        cricket::STUN_ATTR_MESSAGE_INTEGRITY};
+  for (int type : kTypes) {
+    rtc::ArrayView<const char> value;
+    if (view.GetAttribute(type, &value) && !value.empty()) {
+      RTC_CHECK(value.data() >= message);
+      RTC_CHECK(value.data() + value.size() <= message + size);
+    }
+    uint32_t number;
+    view.GetUInt32(type, &number);
+    rtc::SocketAddress address;
+    view.GetAddress(type, &address);
+    view.GetXorAddress(type, &address);
+  }
+  RTC_CHECK_LE(view.transaction_id().size(),
+               cricket::kStunLegacyTransactionIdLength);
+
+  view.ValidateFingerprint();
+  view.ValidateMessageIntegrity("");
+}
+}  // namespace webrtc
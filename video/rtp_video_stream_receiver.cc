@@ -32,7 +32,9 @@
 #include "modules/video_coding/video_coding_impl.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/location.h"
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/ptr_util.h"
 #include "rtc_base/system/fallthrough.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
@@ -152,11 +154,18 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
   packet_buffer_ = video_coding::PacketBuffer::Create(
       clock_, kPacketBufferStartSize, kPacketBufferMaxSixe, this);
   reference_finder_.reset(new video_coding::RtpFrameReferenceFinder(this));
+  if (field_trial::IsEnabled("WebRTC-ReferenceFinderTaskQueue")) {
+    reference_finder_queue_ =
+        rtc::MakeUnique<rtc::TaskQueue>("ReferenceFinder");
+  }
 }
 
 RtpVideoStreamReceiver::~RtpVideoStreamReceiver() {
   RTC_DCHECK(secondary_sinks_.empty());
 
+  // Make sure no reference finding task runs while members are destroyed.
+  reference_finder_queue_.reset();
+
   if (nack_module_) {
     process_thread_->DeRegisterModule(nack_module_.get());
   }
@@ -333,6 +342,27 @@ void RtpVideoStreamReceiver::OnReceivedFrame(
       keyframe_request_sender_->RequestKeyFrame();
   }
 
+  if (reference_finder_queue_) {
+    struct ManageFrameTask : rtc::QueuedTask {
+      ManageFrameTask(std::unique_ptr<video_coding::RtpFrameObject> frame,
+                      video_coding::RtpFrameReferenceFinder* reference_finder)
+          : frame_(std::move(frame)), reference_finder_(reference_finder) {}
+
+      bool Run() override {
+        reference_finder_->ManageFrame(std::move(frame_));
+        return true;
+      }
+
+      std::unique_ptr<video_coding::RtpFrameObject> frame_;
+      video_coding::RtpFrameReferenceFinder* reference_finder_;
+    };
+
+    reference_finder_queue_->PostTask(
+        rtc::MakeUnique<ManageFrameTask>(std::move(frame),
+                                         reference_finder_.get()));
+    return;
+  }
+
   reference_finder_->ManageFrame(std::move(frame));
 }
 
@@ -424,7 +454,15 @@ void RtpVideoStreamReceiver::ParseAndHandleEncapsulatingHeader(
 // RtpFrameReferenceFinder will need to know about padding to
 // correctly calculate frame references.
 void RtpVideoStreamReceiver::NotifyReceiverOfEmptyPacket(uint16_t seq_num) {
-  reference_finder_->PaddingReceived(seq_num);
+  if (reference_finder_queue_) {
+    video_coding::RtpFrameReferenceFinder* reference_finder =
+        reference_finder_.get();
+    reference_finder_queue_->PostTask([reference_finder, seq_num] {
+      reference_finder->PaddingReceived(seq_num);
+    });
+  } else {
+    reference_finder_->PaddingReceived(seq_num);
+  }
   packet_buffer_->PaddingReceived(seq_num);
 }
 
@@ -502,7 +540,15 @@ void RtpVideoStreamReceiver::FrameDecoded(int64_t picture_id) {
   }
   if (seq_num != -1) {
     packet_buffer_->ClearTo(seq_num);
-    reference_finder_->ClearTo(seq_num);
+    if (reference_finder_queue_) {
+      video_coding::RtpFrameReferenceFinder* reference_finder =
+          reference_finder_.get();
+      reference_finder_queue_->PostTask([reference_finder, seq_num] {
+        reference_finder->ClearTo(seq_num);
+      });
+    } else {
+      reference_finder_->ClearTo(seq_num);
+    }
   }
 }
 
@@ -523,6 +569,15 @@ void RtpVideoStreamReceiver::StartReceive() {
 void RtpVideoStreamReceiver::StopReceive() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&worker_task_checker_);
   receiving_ = false;
+
+  // No new frames are created once |receiving_| is false. Wait for the frames
+  // that are already queued, so that |complete_frame_callback_| is not called
+  // after this returns.
+  if (reference_finder_queue_) {
+    rtc::Event done(false, false);
+    reference_finder_queue_->PostTask([&done] { done.Set(); });
+    done.Wait(rtc::Event::kForever);
+  }
 }
 
 bool RtpVideoStreamReceiver::IsPacketInOrder(const RTPHeader& header) const {
@@ -34,6 +34,7 @@
 #include "rtc_base/criticalsection.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/sequenced_task_checker.h"
+#include "rtc_base/task_queue.h"
 #include "typedefs.h"  // NOLINT(build/include)
 
 namespace webrtc {
@@ -182,6 +183,11 @@ class RtpVideoStreamReceiver : public RtpData,
   std::unique_ptr<NackModule> nack_module_;
   rtc::scoped_refptr<video_coding::PacketBuffer> packet_buffer_;
   std::unique_ptr<video_coding::RtpFrameReferenceFinder> reference_finder_;
+  // When the "WebRTC-ReferenceFinderTaskQueue" field trial is enabled,
+  // |reference_finder_| runs on this queue instead of on the thread that
+  // receives packets, so that the frames of different streams are assembled
+  // in parallel.
+  std::unique_ptr<rtc::TaskQueue> reference_finder_queue_;
   rtc::CriticalSection last_seq_num_cs_;
   std::map<int64_t, uint16_t> last_seq_num_for_pic_id_
       RTC_GUARDED_BY(last_seq_num_cs_);
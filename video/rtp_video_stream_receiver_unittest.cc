@@ -250,6 +250,36 @@ TEST_F(RtpVideoStreamReceiverTest, GenericKeyFrameBitstreamError) {
                                                     &rtp_header);
 }
 
+class RtpVideoStreamReceiverReferenceFinderTaskQueueTest
+    : public RtpVideoStreamReceiverTest {
+ protected:
+  RtpVideoStreamReceiverReferenceFinderTaskQueueTest()
+      : RtpVideoStreamReceiverTest(
+            "WebRTC-ReferenceFinderTaskQueue/Enabled/") {}
+};
+
+TEST_F(RtpVideoStreamReceiverReferenceFinderTaskQueueTest,
+       FrameDeliveredBeforeStopReceiveReturns) {
+  WebRtcRTPHeader rtp_header;
+  const std::vector<uint8_t> data({1, 2, 3, 4});
+  memset(&rtp_header, 0, sizeof(rtp_header));
+  rtp_header.header.sequenceNumber = 1;
+  rtp_header.header.markerBit = 1;
+  rtp_header.type.Video.is_first_packet_in_frame = true;
+  rtp_header.frameType = kVideoFrameKey;
+  rtp_header.type.Video.codec = kVideoCodecGeneric;
+  mock_on_complete_frame_callback_.AppendExpectedBitstream(data.data(),
+                                                           data.size());
+  EXPECT_CALL(mock_on_complete_frame_callback_, DoOnCompleteFrame(_));
+  rtp_video_stream_receiver_->StartReceive();
+  rtp_video_stream_receiver_->OnReceivedPayloadData(data.data(), data.size(),
+                                                    &rtp_header);
+  // The frame is handed off on the reference finder queue, and StopReceive()
+  // waits for it.
+  rtp_video_stream_receiver_->StopReceive();
+  testing::Mock::VerifyAndClearExpectations(&mock_on_complete_frame_callback_);
+}
+
 class RtpVideoStreamReceiverTestH264
     : public RtpVideoStreamReceiverTest,
       public testing::WithParamInterface<std::string> {